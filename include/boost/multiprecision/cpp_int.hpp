@@ -24,6 +24,7 @@
 #include <boost/type_traits/common_type.hpp>
 #include <boost/type_traits/make_signed.hpp>
 #include <boost/multiprecision/cpp_int/checked.hpp>
+#include <boost/multiprecision/cpp_int/workspace.hpp>
 #ifdef BOOST_MP_USER_DEFINED_LITERALS
 #include <boost/multiprecision/cpp_int/value_pack.hpp>
 #endif
@@ -58,6 +59,24 @@ namespace backends{
 
 template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator, bool trivial = false>
 struct cpp_int_base;
+
+namespace detail{
+//
+// String conversion routines, see cpp_int/string.hpp:
+//
+template <class CppInt>
+void decimal_string(std::string& result, const CppInt& x);
+template <class CppInt>
+void assign_decimal_string(CppInt& result, const char* s);
+template <class CppInt>
+void assign_power_of_two_string(CppInt& result, const char* s, unsigned digit_bits);
+template <class CppInt>
+void power_of_two_string(std::string& result, const CppInt& x, unsigned digit_bits);
+template <class CppInt>
+void twos_complement(CppInt& x, const mpl::true_&);
+template <class CppInt>
+void twos_complement(CppInt& x, const mpl::false_&);
+}
 //
 // Traits class determines the maximum and minimum precision values:
 //
@@ -152,7 +171,7 @@ inline void verify_new_size(unsigned new_size, unsigned min_size, const mpl::int
    if(new_size < min_size)
       BOOST_THROW_EXCEPTION(std::overflow_error("Unable to allocate sufficient storage for the value of the result: value overflows the maximum allowable magnitude."));
 }
-inline void verify_new_size(unsigned /*new_size*/, unsigned /*min_size*/, const mpl::int_<unchecked>&){}
+inline BOOST_CXX14_CONSTEXPR void verify_new_size(unsigned /*new_size*/, unsigned /*min_size*/, const mpl::int_<unchecked>&){}
 
 template <class U>
 inline void verify_limb_mask(bool b, U limb, U mask, const mpl::int_<checked>&)
@@ -162,10 +181,23 @@ inline void verify_limb_mask(bool b, U limb, U mask, const mpl::int_<checked>&)
       BOOST_THROW_EXCEPTION(std::overflow_error("Overflow in cpp_int arithmetic: there is insufficient precision in the target type to hold all of the bits of the result."));
 }
 template <class U>
-inline void verify_limb_mask(bool /*b*/, U /*limb*/, U /*mask*/, const mpl::int_<unchecked>&){}
+inline BOOST_CXX14_CONSTEXPR void verify_limb_mask(bool /*b*/, U /*limb*/, U /*mask*/, const mpl::int_<unchecked>&){}
 
 }
 
+//
+// When an arbitrary precision cpp_int outgrows its storage, the new capacity is the old one times this
+// factor (or the size requested if that is larger), so that values which grow a little at a time in a
+// loop are reallocated only a logarithmic number of times:
+//
+#ifndef BOOST_MP_CPP_INT_GROWTH_FACTOR
+#define BOOST_MP_CPP_INT_GROWTH_FACTOR 4
+#endif
+
+static const unsigned cpp_int_growth_factor = BOOST_MP_CPP_INT_GROWTH_FACTOR;
+
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_CPP_INT_GROWTH_FACTOR >= 1, "BOOST_MP_CPP_INT_GROWTH_FACTOR must be at least 1.");
+
 //
 // Now define the various data layouts that are possible as partial specializations of the base class,
 // starting with the default arbitrary precision signed integer type:
@@ -264,9 +296,9 @@ public:
             m_sign = false;
       }
    }
+   BOOST_STATIC_CONSTANT(unsigned, max_limbs = MaxBits / limb_bits + ((MaxBits % limb_bits) ? 1 : 0));
    void resize(unsigned new_size, unsigned min_size)
    {
-      static const unsigned max_limbs = MaxBits / (CHAR_BIT * sizeof(limb_type)) + ((MaxBits % (CHAR_BIT * sizeof(limb_type))) ? 1 : 0);
       // We never resize beyond MaxSize:
       if(new_size > max_limbs)
          new_size = max_limbs;
@@ -276,21 +308,35 @@ public:
       if(new_size > cap)
       {
          // Allocate a new buffer and copy everything over:
-         cap = (std::min)((std::max)(cap * 4, new_size), max_limbs);
-         limb_pointer pl = allocator().allocate(cap);
-         std::memcpy(pl, limbs(), size() * sizeof(limbs()[0]));
-         if(!m_internal)
-            allocator().deallocate(limbs(), capacity());
-         else
-            m_internal = false;
-         m_limbs = new_size;
-         m_data.ld.capacity = cap;
-         m_data.ld.data = pl;
+         cap = cap > max_limbs / cpp_int_growth_factor ? max_limbs : (std::min)((std::max)(cap * cpp_int_growth_factor, new_size), static_cast<unsigned>(max_limbs));
+         reallocate(cap);
       }
-      else
+      m_limbs = new_size;
+   }
+   //
+   // Explicit control over the amount of storage, the value is unchanged:
+   //
+   void reserve(unsigned new_capacity)
+   {
+      if(new_capacity > max_limbs)
+         new_capacity = max_limbs;
+      if(new_capacity > capacity())
+         reallocate(new_capacity);
+   }
+   void shrink_to_fit()
+   {
+      if(m_internal)
+         return;
+      if(m_limbs <= internal_limb_count)
       {
-         m_limbs = new_size;
+         limb_pointer p = m_data.ld.data;
+         unsigned     cap = m_data.ld.capacity;
+         std::memcpy(m_data.la, p, m_limbs * sizeof(limb_type));
+         m_internal = true;
+         allocator().deallocate(p, cap);
       }
+      else if(m_limbs < m_data.ld.capacity)
+         reallocate(m_limbs);
    }
    BOOST_MP_FORCEINLINE void normalize() BOOST_NOEXCEPT
    {
@@ -380,6 +426,20 @@ public:
 protected:
    template <class A>
    void check_in_range(const A&) BOOST_NOEXCEPT {}
+
+private:
+   // Moves the value into a newly allocated buffer of cap >= size() limbs:
+   void reallocate(unsigned cap)
+   {
+      limb_pointer pl = allocator().allocate(cap);
+      std::memcpy(pl, limbs(), size() * sizeof(limbs()[0]));
+      if(!m_internal)
+         allocator().deallocate(limbs(), capacity());
+      else
+         m_internal = false;
+      m_data.ld.capacity = cap;
+      m_data.ld.data = pl;
+   }
 };
 
 #ifndef BOOST_NO_INCLASS_MEMBER_INITIALIZATION
@@ -387,6 +447,8 @@ protected:
 template <unsigned MinBits, unsigned MaxBits, cpp_int_check_type Checked, class Allocator>
 const unsigned cpp_int_base<MinBits, MaxBits, signed_magnitude, Checked, Allocator, false>::limb_bits;
 template <unsigned MinBits, unsigned MaxBits, cpp_int_check_type Checked, class Allocator>
+const unsigned cpp_int_base<MinBits, MaxBits, signed_magnitude, Checked, Allocator, false>::max_limbs;
+template <unsigned MinBits, unsigned MaxBits, cpp_int_check_type Checked, class Allocator>
 const limb_type cpp_int_base<MinBits, MaxBits, signed_magnitude, Checked, Allocator, false>::max_limb_value;
 template <unsigned MinBits, unsigned MaxBits, cpp_int_check_type Checked, class Allocator>
 const limb_type cpp_int_base<MinBits, MaxBits, signed_magnitude, Checked, Allocator, false>::sign_bit_mask;
@@ -437,9 +499,38 @@ private:
       limb_type          m_first_limb;
       double_limb_type   m_double_first_limb;
 
+#if defined(BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC)
+      //
+      // A constant expression may only read the member which was initialized, and the arithmetic
+      // reads m_data, so switch to that at compile time.  At runtime only the first limb(s) are set:
+      //
+      BOOST_CONSTEXPR data_type() : m_first_limb(0)
+      {
+         if(BOOST_MP_IS_CONST_EVALUATED)
+            *this = data_type(literals::detail::value_pack<>());
+      }
+      BOOST_CONSTEXPR data_type(limb_type i) : m_first_limb(i)
+      {
+         if(BOOST_MP_IS_CONST_EVALUATED)
+         {
+            *this = data_type(literals::detail::value_pack<>());
+            m_data[0] = i;
+         }
+      }
+      BOOST_CONSTEXPR data_type(double_limb_type i) : m_double_first_limb(i)
+      {
+         if(BOOST_MP_IS_CONST_EVALUATED)
+         {
+            *this = data_type(literals::detail::value_pack<>());
+            m_data[0] = static_cast<limb_type>(i);
+            m_data[1] = static_cast<limb_type>(i >> limb_bits);
+         }
+      }
+#else
       BOOST_CONSTEXPR data_type() : m_first_limb(0) {}
       BOOST_CONSTEXPR data_type(limb_type i) : m_first_limb(i) {}
       BOOST_CONSTEXPR data_type(double_limb_type i) : m_double_first_limb(i) {}
+#endif
 #if defined(BOOST_MP_USER_DEFINED_LITERALS)
       template <limb_type...VALUES>
       BOOST_CONSTEXPR data_type(literals::detail::value_pack<VALUES...>) : m_data{ VALUES... } {}
@@ -476,11 +567,11 @@ public:
    //
    // Helper functions for getting at our internal data, and manipulating storage:
    //
-   BOOST_MP_FORCEINLINE unsigned size()const BOOST_NOEXCEPT { return m_limbs; }
-   BOOST_MP_FORCEINLINE limb_pointer limbs() BOOST_NOEXCEPT { return m_wrapper.m_data; }
+   BOOST_MP_FORCEINLINE BOOST_CONSTEXPR unsigned size()const BOOST_NOEXCEPT { return m_limbs; }
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR limb_pointer limbs() BOOST_NOEXCEPT { return m_wrapper.m_data; }
    BOOST_MP_FORCEINLINE BOOST_CONSTEXPR const_limb_pointer limbs()const BOOST_NOEXCEPT { return m_wrapper.m_data; }
    BOOST_MP_FORCEINLINE BOOST_CONSTEXPR bool sign()const BOOST_NOEXCEPT { return m_sign; }
-   BOOST_MP_FORCEINLINE void sign(bool b) BOOST_NOEXCEPT
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR void sign(bool b) BOOST_NOEXCEPT
    {
       m_sign = b;
       // Check for zero value:
@@ -490,16 +581,20 @@ public:
             m_sign = false;
       }
    }
-   BOOST_MP_FORCEINLINE void resize(unsigned new_size, unsigned min_size) BOOST_MP_NOEXCEPT_IF((Checked == unchecked))
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR void resize(unsigned new_size, unsigned min_size) BOOST_MP_NOEXCEPT_IF((Checked == unchecked))
    {
       m_limbs = static_cast<boost::uint16_t>((std::min)(new_size, internal_limb_count));
       detail::verify_new_size(m_limbs, min_size, checked_type());
    }
-   BOOST_MP_FORCEINLINE void normalize() BOOST_MP_NOEXCEPT_IF((Checked == unchecked))
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR void normalize() BOOST_MP_NOEXCEPT_IF((Checked == unchecked))
    {
       limb_pointer p = limbs();
-      detail::verify_limb_mask(m_limbs == internal_limb_count, p[internal_limb_count-1], upper_limb_mask, checked_type());
-      p[internal_limb_count-1] &= upper_limb_mask;
+      if(m_limbs == internal_limb_count)
+      {
+         // Only the top limb of a full value can hold bits above MaxBits, any others are unused:
+         detail::verify_limb_mask(true, p[internal_limb_count-1], upper_limb_mask, checked_type());
+         p[internal_limb_count-1] &= upper_limb_mask;
+      }
       while((m_limbs-1) && !p[m_limbs - 1])--m_limbs;
       if((m_limbs == 1) && (!*p)) m_sign = false; // zero is always unsigned
    }
@@ -511,16 +606,21 @@ public:
    // Defaulted functions:
    //~cpp_int_base() BOOST_NOEXCEPT {}
 
-   void assign(const cpp_int_base& o) BOOST_NOEXCEPT
+   BOOST_CXX14_CONSTEXPR void assign(const cpp_int_base& o) BOOST_NOEXCEPT
    {
       if(this != &o)
       {
          m_limbs = o.m_limbs;
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+         if(BOOST_MP_IS_CONST_EVALUATED)
+            m_wrapper = o.m_wrapper;
+         else
+#endif
          std::memcpy(limbs(), o.limbs(), o.size() * sizeof(o.limbs()[0]));
          m_sign = o.m_sign;
       }
    }
-   BOOST_MP_FORCEINLINE void negate() BOOST_NOEXCEPT
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR void negate() BOOST_NOEXCEPT
    {
       m_sign = !m_sign;
       // Check for zero value:
@@ -589,9 +689,38 @@ private:
       limb_type          m_first_limb;
       double_limb_type   m_double_first_limb;
 
+#if defined(BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC)
+      //
+      // A constant expression may only read the member which was initialized, and the arithmetic
+      // reads m_data, so switch to that at compile time.  At runtime only the first limb(s) are set:
+      //
+      BOOST_CONSTEXPR data_type() : m_first_limb(0)
+      {
+         if(BOOST_MP_IS_CONST_EVALUATED)
+            *this = data_type(literals::detail::value_pack<>());
+      }
+      BOOST_CONSTEXPR data_type(limb_type i) : m_first_limb(i)
+      {
+         if(BOOST_MP_IS_CONST_EVALUATED)
+         {
+            *this = data_type(literals::detail::value_pack<>());
+            m_data[0] = i;
+         }
+      }
+      BOOST_CONSTEXPR data_type(double_limb_type i) : m_double_first_limb(i)
+      {
+         if(BOOST_MP_IS_CONST_EVALUATED)
+         {
+            *this = data_type(literals::detail::value_pack<>());
+            m_data[0] = static_cast<limb_type>(i);
+            m_data[1] = static_cast<limb_type>(i >> limb_bits);
+         }
+      }
+#else
       BOOST_CONSTEXPR data_type() : m_first_limb(0) {}
       BOOST_CONSTEXPR data_type(limb_type i) : m_first_limb(i) {}
       BOOST_CONSTEXPR data_type(double_limb_type i) : m_double_first_limb(i) {}
+#endif
 #if defined(BOOST_MP_USER_DEFINED_LITERALS)
       template <limb_type...VALUES>
       BOOST_CONSTEXPR data_type(literals::detail::value_pack<VALUES...>) : m_data{ VALUES... } {}
@@ -627,21 +756,25 @@ public:
    //
    // Helper functions for getting at our internal data, and manipulating storage:
    //
-   BOOST_MP_FORCEINLINE unsigned size()const BOOST_NOEXCEPT { return m_limbs; }
-   BOOST_MP_FORCEINLINE limb_pointer limbs() BOOST_NOEXCEPT { return m_wrapper.m_data; }
+   BOOST_MP_FORCEINLINE BOOST_CONSTEXPR unsigned size()const BOOST_NOEXCEPT { return m_limbs; }
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR limb_pointer limbs() BOOST_NOEXCEPT { return m_wrapper.m_data; }
    BOOST_MP_FORCEINLINE BOOST_CONSTEXPR const_limb_pointer limbs()const BOOST_NOEXCEPT { return m_wrapper.m_data; }
    BOOST_MP_FORCEINLINE BOOST_CONSTEXPR bool sign()const BOOST_NOEXCEPT { return false; }
    BOOST_MP_FORCEINLINE void sign(bool b) BOOST_MP_NOEXCEPT_IF((Checked == unchecked)) {  if(b) negate(); }
-   BOOST_MP_FORCEINLINE void resize(unsigned new_size, unsigned min_size) BOOST_MP_NOEXCEPT_IF((Checked == unchecked))
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR void resize(unsigned new_size, unsigned min_size) BOOST_MP_NOEXCEPT_IF((Checked == unchecked))
    {
       m_limbs = (std::min)(new_size, internal_limb_count);
       detail::verify_new_size(m_limbs, min_size, checked_type());
    }
-   BOOST_MP_FORCEINLINE void normalize() BOOST_MP_NOEXCEPT_IF((Checked == unchecked))
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR void normalize() BOOST_MP_NOEXCEPT_IF((Checked == unchecked))
    {
       limb_pointer p = limbs();
-      detail::verify_limb_mask(m_limbs == internal_limb_count, p[internal_limb_count-1], upper_limb_mask, checked_type());
-      p[internal_limb_count-1] &= upper_limb_mask;
+      if(m_limbs == internal_limb_count)
+      {
+         // Only the top limb of a full value can hold bits above MaxBits, any others are unused:
+         detail::verify_limb_mask(true, p[internal_limb_count-1], upper_limb_mask, checked_type());
+         p[internal_limb_count-1] &= upper_limb_mask;
+      }
       while((m_limbs-1) && !p[m_limbs - 1])--m_limbs;
    }
 
@@ -652,11 +785,16 @@ public:
    // Defaulted functions:
    //~cpp_int_base() BOOST_NOEXCEPT {}
 
-   BOOST_MP_FORCEINLINE void assign(const cpp_int_base& o) BOOST_NOEXCEPT
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR void assign(const cpp_int_base& o) BOOST_NOEXCEPT
    {
       if(this != &o)
       {
          m_limbs = o.m_limbs;
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+         if(BOOST_MP_IS_CONST_EVALUATED)
+            m_wrapper = o.m_wrapper;
+         else
+#endif
          std::memcpy(limbs(), o.limbs(), o.size() * sizeof(limbs()[0]));
       }
    }
@@ -1179,13 +1317,13 @@ public:
       : base_type(static_cast<const base_type&>(a), tag){}
 #endif
 
-   BOOST_MP_FORCEINLINE cpp_int_backend& operator = (const cpp_int_backend& o) BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<cpp_int_backend>().assign(std::declval<const cpp_int_backend&>())))
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR cpp_int_backend& operator = (const cpp_int_backend& o) BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<cpp_int_backend>().assign(std::declval<const cpp_int_backend&>())))
    {
       this->assign(o);
       return *this;
    }
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
-   BOOST_MP_FORCEINLINE cpp_int_backend& operator = (cpp_int_backend&& o) BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<base_type&>() = std::declval<base_type>()))
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR cpp_int_backend& operator = (cpp_int_backend&& o) BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<base_type&>() = std::declval<base_type>()))
    {
       *static_cast<base_type*>(this) = static_cast<base_type&&>(o);
       return *this;
@@ -1379,8 +1517,6 @@ private:
    }
    void do_assign_string(const char* s, const mpl::false_&)
    {
-      using default_ops::eval_multiply;
-      using default_ops::eval_add;
       std::size_t n = s ? std::strlen(s) : 0;
       *this = static_cast<limb_type>(0u);
       unsigned radix = 10;
@@ -1408,122 +1544,26 @@ private:
       //
       // Exception guarantee: create the result in stack variable "result"
       // then do a swap at the end.  In the event of a throw, *this will
-      // be left unchanged.
+      // be left unchanged.  Decimal strings are parsed into a temporary
+      // anyway, so those are assigned straight to *this, as long as
+      // negating the value can't throw afterwards:
       //
+      if(n && (radix == 10) && (!isneg || (Checked == unchecked) || !is_unsigned_number<cpp_int_backend>::value))
+      {
+         detail::assign_decimal_string(*this, s);
+         if(isneg)
+            this->negate();
+         return;
+      }
       cpp_int_backend result;
       if(n)
       {
          if(radix == 16)
-         {
-            while(*s == '0') ++s;
-            std::size_t bitcount = 4 * std::strlen(s);
-            limb_type val;
-            std::size_t limb, shift;
-            if(bitcount > 4)
-               bitcount -= 4;
-            else
-               bitcount = 0;
-            std::size_t newsize = bitcount / (sizeof(limb_type) * CHAR_BIT) + 1;
-            result.resize(static_cast<unsigned>(newsize), static_cast<unsigned>(newsize));  // will throw if this is a checked integer that cannot be resized
-            std::memset(result.limbs(), 0, result.size() * sizeof(limb_type));
-            while(*s)
-            {
-               if(*s >= '0' && *s <= '9')
-                  val = *s - '0';
-               else if(*s >= 'a' && *s <= 'f')
-                  val = 10 + *s - 'a';
-               else if(*s >= 'A' && *s <= 'F')
-                  val = 10 + *s - 'A';
-               else
-               {
-                  BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected content found while parsing character string."));
-               }
-               limb = bitcount / (sizeof(limb_type) * CHAR_BIT);
-               shift = bitcount % (sizeof(limb_type) * CHAR_BIT);
-               val <<= shift;
-               if(result.size() > limb)
-               {
-                  result.limbs()[limb] |= val;
-               }
-               ++s;
-               bitcount -= 4;
-            }
-            result.normalize();
-         }
+            detail::assign_power_of_two_string(result, s, 4);
          else if(radix == 8)
-         {
-            while(*s == '0') ++s;
-            std::size_t bitcount = 3 * std::strlen(s);
-            limb_type val;
-            std::size_t limb, shift;
-            if(bitcount > 3)
-               bitcount -= 3;
-            else
-               bitcount = 0;
-            std::size_t newsize = bitcount / (sizeof(limb_type) * CHAR_BIT) + 1;
-            result.resize(static_cast<unsigned>(newsize), static_cast<unsigned>(newsize));  // will throw if this is a checked integer that cannot be resized
-            std::memset(result.limbs(), 0, result.size() * sizeof(limb_type));
-            while(*s)
-            {
-               if(*s >= '0' && *s <= '7')
-                  val = *s - '0';
-               else
-               {
-                  BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected content found while parsing character string."));
-               }
-               limb = bitcount / (sizeof(limb_type) * CHAR_BIT);
-               shift = bitcount % (sizeof(limb_type) * CHAR_BIT);
-               if(result.size() > limb)
-               {
-                  result.limbs()[limb] |= (val << shift);
-                  if(shift > sizeof(limb_type) * CHAR_BIT - 3)
-                  {
-                     // Deal with the bits in val that overflow into the next limb:
-                     val >>= (sizeof(limb_type) * CHAR_BIT - shift);
-                     if(val)
-                     {
-                        // If this is the most-significant-limb, we may need to allocate an extra one for the overflow:
-                        if(limb + 1 == newsize)
-                           result.resize(static_cast<unsigned>(newsize + 1), static_cast<unsigned>(newsize + 1));
-                        if(result.size() > limb + 1)
-                        {
-                           result.limbs()[limb + 1] |= val;
-                        }
-                     }
-                  }
-               }
-               ++s;
-               bitcount -= 3;
-            }
-            result.normalize();
-         }
+            detail::assign_power_of_two_string(result, s, 3);
          else
-         {
-            // Base 10, we extract blocks of size 10^9 at a time, that way
-            // the number of multiplications is kept to a minimum:
-            limb_type block_mult = max_block_10;
-            while(*s)
-            {
-               limb_type block = 0;
-               for(unsigned i = 0; i < digits_per_block_10; ++i)
-               {
-                  limb_type val;
-                  if(*s >= '0' && *s <= '9')
-                     val = *s - '0';
-                  else
-                     BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected character encountered in input."));
-                  block *= 10;
-                  block += val;
-                  if(!*++s)
-                  {
-                     block_mult = block_multiplier(i);
-                     break;
-                  }
-               }
-               eval_multiply(result, block_mult);
-               eval_add(result, block);
-            }
-         }
+            detail::assign_decimal_string(result, s);
       }
       if(isneg)
          result.negate();
@@ -1540,16 +1580,27 @@ public:
       this->do_swap(o);
    }
 private:
+   //
+   // The two's complement of a negative trivial value, which is how hex and octal output shows negative
+   // values of types with modulo arithmetic, as built in types do:
+   //
+   template <class LocalLimb>
+   static LocalLimb trivial_twos_complement(LocalLimb v)
+   {
+      if(Checked == checked)
+         BOOST_THROW_EXCEPTION(std::runtime_error("Base 8 or 16 printing of negative numbers is not supported."));
+      LocalLimb mask = static_cast<LocalLimb>(static_cast<LocalLimb>(~LocalLimb(0)) >> (sizeof(LocalLimb) * CHAR_BIT - MinBits));
+      return static_cast<LocalLimb>(static_cast<LocalLimb>(~v + 1) & mask);
+   }
    std::string do_get_trivial_string(std::ios_base::fmtflags f, const mpl::false_&)const
    {
       typedef typename mpl::if_c<sizeof(typename base_type::local_limb_type) == 1, unsigned, typename base_type::local_limb_type>::type io_type;
-      if(this->sign() && (((f & std::ios_base::hex) == std::ios_base::hex) || ((f & std::ios_base::oct) == std::ios_base::oct)))
-         BOOST_THROW_EXCEPTION(std::runtime_error("Base 8 or 16 printing of negative numbers is not supported."));
+      bool complement = this->sign() && (((f & std::ios_base::hex) == std::ios_base::hex) || ((f & std::ios_base::oct) == std::ios_base::oct));
       std::stringstream ss;
       ss.flags(f & ~std::ios_base::showpos);
-      ss << static_cast<io_type>(*this->limbs());
+      ss << static_cast<io_type>(complement ? trivial_twos_complement(*this->limbs()) : *this->limbs());
       std::string result;
-      if(this->sign())
+      if(this->sign() && !complement)
          result += '-';
       else if(f & std::ios_base::showpos)
          result += '+';
@@ -1570,11 +1621,9 @@ private:
 
       if(base == 8 || base == 16)
       {
-         if(this->sign())
-            BOOST_THROW_EXCEPTION(std::runtime_error("Base 8 or 16 printing of negative numbers is not supported."));
          limb_type shift = base == 8 ? 3 : 4;
          limb_type mask = static_cast<limb_type>((1u << shift) - 1);
-         typename base_type::local_limb_type v = *this->limbs();
+         typename base_type::local_limb_type v = this->sign() ? trivial_twos_complement(*this->limbs()) : *this->limbs();
          result.assign(Bits / shift + (Bits % shift ? 1 : 0), '0');
          std::string::difference_type pos = result.size() - 1;
          for(unsigned i = 0; i < Bits / shift; ++i)
@@ -1651,40 +1700,17 @@ private:
          base = 16;
       std::string result;
 
-      unsigned Bits = this->size() * base_type::limb_bits;
-
       if(base == 8 || base == 16)
       {
          if(this->sign())
-            BOOST_THROW_EXCEPTION(std::runtime_error("Base 8 or 16 printing of negative numbers is not supported."));
-         limb_type shift = base == 8 ? 3 : 4;
-         limb_type mask = static_cast<limb_type>((1u << shift) - 1);
-         cpp_int_backend t(*this);
-         result.assign(Bits / shift + ((Bits % shift) ? 1 : 0), '0');
-         std::string::difference_type pos = result.size() - 1;
-         for(unsigned i = 0; i < Bits / shift; ++i)
          {
-            char c = '0' + static_cast<char>(t.limbs()[0] & mask);
-            if(c > '9')
-               c += 'A' - '9' - 1;
-            result[pos--] = c;
-            eval_right_shift(t, shift);
+            // Negative values of types with modulo arithmetic are printed in two's complement, as built in types are:
+            cpp_int_backend t(*this);
+            detail::twos_complement(t, mpl::bool_<is_fixed_precision<self_type>::value && (Checked == unchecked)>());
+            detail::power_of_two_string(result, t, base == 8 ? 3 : 4);
          }
-         if(Bits % shift)
-         {
-            mask = static_cast<limb_type>((1u << (Bits % shift)) - 1);
-            char c = '0' + static_cast<char>(t.limbs()[0] & mask);
-            if(c > '9')
-               c += 'A' - '9';
-            result[pos] = c;
-         }
-         //
-         // Get rid of leading zeros:
-         //
-         std::string::size_type n = result.find_first_not_of('0');
-         if(!result.empty() && (n == std::string::npos))
-            n = result.size() - 1;
-         result.erase(0, n);
+         else
+            detail::power_of_two_string(result, *this, base == 8 ? 3 : 4);
          if(f & std::ios_base::showbase)
          {
             const char* pp = base == 8 ? "0" : "0x";
@@ -1693,39 +1719,14 @@ private:
       }
       else
       {
-         result.assign(Bits / 3 + 1, '0');
-         std::string::difference_type pos = result.size() - 1;
-         cpp_int_backend t(*this);
-         cpp_int_backend r;
-         bool neg = false;
-         if(t.sign())
-         {
-            t.negate();
-            neg = true;
-         }
+         bool neg = this->sign();
          if(this->size() == 1)
          {
-            result = boost::lexical_cast<std::string>(t.limbs()[0]);
+            result = boost::lexical_cast<std::string>(this->limbs()[0]);
          }
          else
          {
-            cpp_int_backend block10;
-            block10 = max_block_10;
-            while(eval_get_sign(t) != 0)
-            {
-               cpp_int_backend t2;
-               divide_unsigned_helper(&t2, t, block10, r);
-               t = t2;
-               limb_type v = r.limbs()[0];
-               for(unsigned i = 0; i < digits_per_block_10; ++i)
-               {
-                  char c = '0' + v % 10;
-                  v /= 10;
-                  result[pos] = c;
-                  if(pos-- == 0)
-                     break;
-               }
-            }
+            detail::decimal_string(result, *this);
          }
          std::string::size_type n = result.find_first_not_of('0');
          result.erase(0, n);
@@ -1805,7 +1806,7 @@ public:
       construct_from_container(c, trivial_tag());
    }
    template <unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-   int compare_imp(const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o, const mpl::false_&, const mpl::false_&)const BOOST_NOEXCEPT
+   BOOST_CXX14_CONSTEXPR int compare_imp(const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o, const mpl::false_&, const mpl::false_&)const BOOST_NOEXCEPT
    {
       if(this->sign() != o.sign())
          return this->sign() ? -1 : 1;
@@ -1849,14 +1850,14 @@ public:
       }
    }
    template <unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-   int compare(const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o)const BOOST_NOEXCEPT
+   BOOST_CXX14_CONSTEXPR int compare(const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o)const BOOST_NOEXCEPT
    {
       typedef mpl::bool_<is_trivial_cpp_int<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> >::value> t1;
       typedef mpl::bool_<is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value> t2;
       return compare_imp(o, t1(), t2());
    }
    template <unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-   int compare_unsigned(const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o)const BOOST_NOEXCEPT
+   BOOST_CXX14_CONSTEXPR int compare_unsigned(const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o)const BOOST_NOEXCEPT
    {
       if(this->size() != o.size())
       {
@@ -1951,6 +1952,42 @@ typedef number<cpp_int_backend<256, 256, signed_magnitude, checked, void> >    c
 typedef number<cpp_int_backend<512, 512, signed_magnitude, checked, void> >    checked_int512_t;
 typedef number<cpp_int_backend<1024, 1024, signed_magnitude, checked, void> >  checked_int1024_t;
 
+namespace backends{ namespace detail{
+
+template <class CppInt>
+inline void reserve_storage(CppInt& val, unsigned limbs, const mpl::false_&)
+{
+   val.reserve(limbs);
+}
+template <class CppInt>
+inline void reserve_storage(CppInt&, unsigned, const mpl::true_&) BOOST_NOEXCEPT {}
+template <class CppInt>
+inline void shrink_storage(CppInt& val, const mpl::false_&)
+{
+   val.shrink_to_fit();
+}
+template <class CppInt>
+inline void shrink_storage(CppInt&, const mpl::true_&) BOOST_NOEXCEPT {}
+
+}} // namespace backends::detail
+
+//
+// Storage management for arbitrary precision cpp_int's: reserve makes room for values of up to
+// bits bits without further allocation, and shrink_to_fit releases whatever the current value
+// does not need.  Neither changes the value, and both do nothing for fixed precision types:
+//
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator, expression_template_option ExpressionTemplates>
+inline void reserve(number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>& val, unsigned bits)
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   backends::detail::reserve_storage(val.backend(), bits / limb_bits + ((bits % limb_bits) ? 1 : 0), mpl::bool_<is_void<Allocator>::value>());
+}
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator, expression_template_option ExpressionTemplates>
+inline void shrink_to_fit(number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>& val)
+{
+   backends::detail::shrink_storage(val.backend(), mpl::bool_<is_void<Allocator>::value>());
+}
+
 #ifdef BOOST_NO_SFINAE_EXPR
 
 namespace detail{
@@ -1970,12 +2007,18 @@ struct is_explicitly_convertible<cpp_int_backend<MinBits, MaxBits, SignType, Che
 //
 // Last of all we include the implementations of all the eval_* non member functions:
 //
+#include <boost/multiprecision/cpp_int/limb_kernels.hpp>
+#include <boost/multiprecision/cpp_int/unrolled_kernels.hpp>
+#include <boost/multiprecision/cpp_int/constexpr_kernels.hpp>
 #include <boost/multiprecision/cpp_int/comparison.hpp>
 #include <boost/multiprecision/cpp_int/add.hpp>
 #include <boost/multiprecision/cpp_int/multiply.hpp>
 #include <boost/multiprecision/cpp_int/divide.hpp>
 #include <boost/multiprecision/cpp_int/bitwise.hpp>
 #include <boost/multiprecision/cpp_int/misc.hpp>
+#include <boost/multiprecision/cpp_int/montgomery.hpp>
+#include <boost/multiprecision/cpp_int/barrett.hpp>
+#include <boost/multiprecision/cpp_int/string.hpp>
 #include <boost/multiprecision/cpp_int/limits.hpp>
 #ifdef BOOST_MP_USER_DEFINED_LITERALS
 #include <boost/multiprecision/cpp_int/literals.hpp>
@@ -23,7 +23,6 @@ inline void add_unsigned(CppInt1& result, const CppInt2& a, const CppInt3& b) BO
 {
    using std::swap;
 
-   // Nothing fancy, just let uintmax_t take the strain:
    double_limb_type carry = 0;
    unsigned m, x;
    unsigned as = a.size();
@@ -46,17 +45,8 @@ inline void add_unsigned(CppInt1& result, const CppInt2& a, const CppInt3& b) BO
       swap(pa, pb);
    
    // First where a and b overlap:
-   while(pr != pr_end)
-   {
-      carry += static_cast<double_limb_type>(*pa) + static_cast<double_limb_type>(*pb);
-#ifdef __MSVC_RUNTIME_CHECKS
-      *pr = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-      *pr = static_cast<limb_type>(carry);
-#endif
-      carry >>= CppInt1::limb_bits;
-      ++pr, ++pa, ++pb;
-   }
+   carry = detail::add_limbs_n(pr, pa, pb, m);
+   pr += m, pa += m;
    pr_end += x - m;
    // Now where only a has digits:
    while(pr != pr_end)
@@ -140,7 +130,6 @@ inline void subtract_unsigned(CppInt1& result, const CppInt2& a, const CppInt3&
 {
    using std::swap;
 
-   // Nothing fancy, just let uintmax_t take the strain:
    double_limb_type borrow = 0;
    unsigned m, x;
    minmax(a.size(), b.size(), m, x);
@@ -182,15 +171,9 @@ inline void subtract_unsigned(CppInt1& result, const CppInt2& a, const CppInt3&
       return;
    }
    
-   unsigned i = 0;
    // First where a and b overlap:
-   while(i < m)
-   {
-      borrow = static_cast<double_limb_type>(pa[i]) - static_cast<double_limb_type>(pb[i]) - borrow;
-      pr[i] = static_cast<limb_type>(borrow);
-      borrow = (borrow >> CppInt1::limb_bits) & 1u;
-      ++i;
-   }
+   borrow = detail::subtract_limbs_n(pr, pa, pb, m);
+   unsigned i = m;
    // Now where only a has digits, only as long as we've borrowed:
    while(borrow && (i < x))
    {
@@ -217,6 +200,55 @@ inline void subtract_unsigned(CppInt1& result, const CppInt2& a, const CppInt3&
       result.negate();
 }
 //
+// Fixed precision types which are small enough have their own versions of the above with the
+// loops unrolled, see unrolled_kernels.hpp.  The result can't be longer than the longer argument
+// plus a carry, so normalize only has to look from there down:
+//
+template <unsigned Bits, cpp_integer_type SignType>
+inline typename enable_if_c<is_unrolled_cpp_int<cpp_int_backend<Bits, Bits, SignType, unchecked, void> >::value>::type
+   add_unsigned(
+      cpp_int_backend<Bits, Bits, SignType, unchecked, void>& result,
+      const cpp_int_backend<Bits, Bits, SignType, unchecked, void>& a,
+      const cpp_int_backend<Bits, Bits, SignType, unchecked, void>& b) BOOST_NOEXCEPT
+{
+   static const unsigned n = cpp_int_backend<Bits, Bits, SignType, unchecked, void>::internal_limb_count;
+   unsigned x = (std::max)(a.size(), b.size());
+   bool s = a.sign();
+   detail::unrolled_add<n>(result.limbs(), a.limbs(), a.size(), b.limbs(), b.size());
+   result.resize(x + 1, x + 1);
+   result.normalize();
+   result.sign(s);
+}
+//
+// When b > a the subtraction borrows out of the top limb and leaves 2^(n * bits_per_limb) - (b - a),
+// which is already the answer, modulo 2^Bits, for unsigned types.  Signed types negate it back to
+// the magnitude and flip the sign, so the magnitudes never need comparing first:
+//
+template <unsigned Bits, cpp_integer_type SignType>
+inline typename enable_if_c<is_unrolled_cpp_int<cpp_int_backend<Bits, Bits, SignType, unchecked, void> >::value>::type
+   subtract_unsigned(
+      cpp_int_backend<Bits, Bits, SignType, unchecked, void>& result,
+      const cpp_int_backend<Bits, Bits, SignType, unchecked, void>& a,
+      const cpp_int_backend<Bits, Bits, SignType, unchecked, void>& b) BOOST_NOEXCEPT
+{
+   static const unsigned n = cpp_int_backend<Bits, Bits, SignType, unchecked, void>::internal_limb_count;
+   unsigned x = (std::max)(a.size(), b.size());
+   bool s = a.sign();
+   if(detail::unrolled_subtract<n>(result.limbs(), a.limbs(), a.size(), b.limbs(), b.size()))
+   {
+      if(SignType == signed_magnitude)
+      {
+         detail::unrolled_negate<n>(result.limbs());
+         s = !s;
+      }
+      else
+         x = n;
+   }
+   result.resize(x, x);
+   result.normalize();
+   result.sign(s);
+}
+//
 // And again to subtract a single limb:
 //
 template <class CppInt1, class CppInt2>
@@ -278,7 +310,7 @@ inline void subtract_unsigned(CppInt1& result, const CppInt2& a, const limb_type
 // Now the actual functions called by the front end, all of which forward to one of the above:
 //
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
    eval_add(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
@@ -286,12 +318,19 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
    eval_add(result, result, o);
 }
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2, unsigned MinBits3, unsigned MaxBits3, cpp_integer_type SignType3, cpp_int_check_type Checked3, class Allocator3>
-inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
+inline BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
    eval_add(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a, 
       const cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3>& b) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_add(result, a, b, false);
+      return;
+   }
+#endif
    if(a.sign() != b.sign())
    {
       subtract_unsigned(result, a, b);
@@ -439,7 +478,7 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
       eval_subtract(result, one);
 }
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
    eval_subtract(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
@@ -447,12 +486,19 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
    eval_subtract(result, result, o);
 }
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2, unsigned MinBits3, unsigned MaxBits3, cpp_integer_type SignType3, cpp_int_check_type Checked3, class Allocator3>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
    eval_subtract(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a, 
       const cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3>& b) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_add(result, a, b, true);
+      return;
+   }
+#endif
    if(a.sign() != b.sign())
    {
       add_unsigned(result, a, b);
@@ -0,0 +1,308 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+//
+// Reduction modulo a fixed modulus for cpp_int_backend, using Barrett's method:
+//
+#ifndef BOOST_MP_CPP_INT_BARRETT_HPP
+#define BOOST_MP_CPP_INT_BARRETT_HPP
+
+#include <boost/multiprecision/detail/bitscan.hpp> // find_msb
+#include <vector>
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable:4127) // conditional expression is constant
+#endif
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+//
+// For a modulus m of k limbs, and B = 2^limb_bits, we precompute mu = floor(B^2k / m) of k + 1
+// limbs.  Then for x < B^2k the quotient x / m is estimated from the upper limbs of x, as
+// q = floor(floor(x / B^(k-1)) * mu / B^(k+1)), which is at most 2 less than the true quotient (see
+// Menezes, van Oorschot and Vanstone, "Handbook of Applied Cryptography", 14.42), and x - qm is
+// found modulo B^(k+1).  Neither product is needed in full: of the first we skip the columns below
+// k - 1, which can carry at most 1 into q, and of the second only the low k + 1 limbs are formed.
+// That leaves at most 3 subtractions of m at the end, and unlike Montgomery's method there's no
+// division, and no restriction to odd moduli.
+//
+// The products are by long multiplication, so that for large moduli division, which gets to use
+// the subquadratic multiplication routines, wins eventually.  Moduli of at least this many limbs
+// are divided instead:
+//
+#ifndef BOOST_MP_BARRETT_CUTOFF
+#define BOOST_MP_BARRETT_CUTOFF 250
+#endif
+
+static const unsigned barrett_cutoff = BOOST_MP_BARRETT_CUTOFF;
+
+namespace detail{
+//
+// r = the columns of a * b from the skip'th up, r has as + bs limbs and may not alias a or b, and
+// the columns below skip are left zero:
+//
+inline void multiply_high_limbs(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, unsigned skip) BOOST_NOEXCEPT
+{
+   std::fill(pr, pr + as + bs, static_cast<limb_type>(0u));
+   for(unsigned i = 0; i < as; ++i)
+   {
+      unsigned j = skip > i ? skip - i : 0;
+      if(j < bs)
+         pr[i + bs] = multiply_add_limb_row(pr + i + j, pb + j, bs - j, pa[i]);
+   }
+}
+//
+// r = a * b mod B^n, r has n limbs and may not alias a or b:
+//
+inline void multiply_low_limbs(limb_type* pr, unsigned n, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   std::fill(pr, pr + n, static_cast<limb_type>(0u));
+   for(unsigned i = 0; (i < as) && (i < n); ++i)
+   {
+      unsigned len = (std::min)(bs, n - i);
+      limb_type carry = multiply_add_limb_row(pr + i, pb, len, pa[i]);
+      if(i + len < n)
+         pr[i + len] = carry;
+   }
+}
+//
+// Temporary storage needed by barrett_reciprocal:
+//
+inline std::size_t barrett_reciprocal_storage_size(unsigned k) BOOST_NOEXCEPT
+{
+   return 4 * static_cast<std::size_t>(k) + 4 + divide_limbs_storage_size(k);
+}
+//
+// mu = floor(B^2k / m) of k + 1 limbs, for m of k limbs.  When m is a power of B, mu is B^(k+1)
+// which doesn't fit, and we use B^(k+1) - 1 instead, which costs at most one more subtraction:
+//
+inline void barrett_reciprocal(limb_type* pmu, const limb_type* pm, unsigned k, limb_type* storage) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   BOOST_ASSERT(pm[k - 1]);
+   //
+   // Normalised as for any other division, with an extra limb on the numerator so that its most
+   // significant limb is less than the divisor's:
+   //
+   unsigned nn = 2 * k + 2;
+   limb_type* pn = storage;
+   limb_type* pd = pn + nn;
+   limb_type* pq = pd + k;
+   storage = pq + k + 2;
+   std::fill(pn, pn + nn, static_cast<limb_type>(0u));
+   pn[2 * k] = 1;
+   std::copy(pm, pm + k, pd);
+   unsigned shift = limb_bits - 1 - boost::multiprecision::detail::find_msb(pm[k - 1]);
+   if(shift)
+   {
+      left_shift_limbs(pn, nn, shift);
+      left_shift_limbs(pd, k, shift);
+   }
+   if(k == 1)
+      divide_limbs_by_limb(pq, 3, pn, 3, divisor(pd[0]));
+   else
+      divide_limbs(pq, pn, nn, pd, k, storage);
+   if(pq[k + 1])
+      std::fill(pmu, pmu + k + 1, ~static_cast<limb_type>(0u));
+   else
+      std::copy(pq, pq + k + 1, pmu);
+}
+//
+// Temporary storage needed by barrett_reduce, and the same again as a compile time constant:
+//
+inline std::size_t barrett_reduce_storage_size(unsigned k) BOOST_NOEXCEPT
+{
+   return 3 * static_cast<std::size_t>(k) + 3;
+}
+template <unsigned K>
+struct barrett_reduce_storage_size_c
+{
+   BOOST_STATIC_CONSTANT(unsigned, value = 3 * K + 3);
+};
+//
+// r = x mod m, where x has n <= 2k limbs and m has k limbs with reciprocal mu from barrett_reciprocal.
+// r has k + 1 limbs, of which the upper one is left zero, and may not alias x:
+//
+inline void barrett_reduce(limb_type* pr, const limb_type* px, unsigned n, const limb_type* pm, unsigned k, const limb_type* pmu, limb_type* storage) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(n <= 2 * k);
+   if(n < k)
+   {
+      // x < B^(k-1) <= m already:
+      std::copy(px, px + n, pr);
+      std::fill(pr + n, pr + k + 1, static_cast<limb_type>(0u));
+      return;
+   }
+   //
+   // q = x / B^(k-1) * mu / B^(k+1) from the upper part of the product, then r = x - qm mod B^(k+1):
+   //
+   unsigned qn = n - k + 1;
+   limb_type* pt = storage;
+   limb_type* pqm = pt + qn + k + 1;
+   multiply_high_limbs(pt, px + k - 1, qn, pmu, k + 1, k - 1);
+   multiply_low_limbs(pqm, k + 1, pt + k + 1, qn, pm, k);
+   unsigned xn = (std::min)(n, k + 1);
+   std::copy(px, px + xn, pr);
+   std::fill(pr + xn, pr + k + 1, static_cast<limb_type>(0u));
+   subtract_limbs(pr, pr, k + 1, pqm, k + 1);
+   while(compare_limbs(pr, k + 1, pm, k) >= 0)
+      subtract_limbs(pr, pr, k + 1, pm, k);
+}
+
+} // namespace detail
+
+} // namespace backends
+
+//
+// Reduction modulo a fixed modulus m > 0 of a cpp_int type, for code which reduces many values by the
+// same modulus, whether odd or even.  The reciprocal of m is computed once on construction, after
+// which values of up to twice the size of m, such as the product of two values less than m, are
+// reduced with two multiplications and no division, see above.  Larger values, and moduli of at
+// least BOOST_MP_BARRETT_CUTOFF limbs, are divided as usual.  The result is the same as x % m, so
+// has the sign of x.  A barrett_reducer isn't modified by reduce, so may be shared between threads:
+//
+template <class Integer>
+class barrett_reducer
+{
+public:
+   typedef Integer                         value_type;
+   typedef typename Integer::backend_type  backend_type;
+
+   explicit barrett_reducer(const value_type& m) : m_modulus(m)
+   {
+      if(m <= 0)
+         BOOST_THROW_EXCEPTION(std::domain_error("The modulus must be positive."));
+      init(mpl::bool_<backends::is_trivial_cpp_int<backend_type>::value>());
+   }
+   const value_type& modulus()const BOOST_NOEXCEPT { return m_modulus; }
+   //
+   // The k + 1 limbs of floor(B^2k / m), or null if reduction is by division:
+   //
+   const limb_type* reciprocal()const BOOST_NOEXCEPT { return m_reciprocal.empty() ? 0 : &m_reciprocal[0]; }
+
+   void reduce(value_type& result, const value_type& x)const
+   {
+      using backends::eval_modulus;
+      eval_modulus(result.backend(), x.backend(), *this);
+   }
+   value_type reduce(const value_type& x)const
+   {
+      value_type result;
+      reduce(result, x);
+      return result;
+   }
+
+private:
+   void init(const mpl::true_&) {}
+   void init(const mpl::false_&)
+   {
+      const backend_type& m = m_modulus.backend();
+      unsigned k = m.size();
+      if(k < backends::barrett_cutoff)
+      {
+         std::vector<limb_type> storage(backends::detail::barrett_reciprocal_storage_size(k));
+         m_reciprocal.resize(k + 1);
+         backends::detail::barrett_reciprocal(&m_reciprocal[0], m.limbs(), k, &storage[0]);
+      }
+   }
+
+   value_type m_modulus;
+   std::vector<limb_type> m_reciprocal;
+};
+
+namespace backends{
+
+//
+// result = |x| mod m by Barrett reduction.  The remainder is formed in temporary storage, on the heap
+// for types with an allocator and on the stack for fixed precision types, so result may alias x:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline void barrett_reduce(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& x, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& m, const limb_type* pmu)
+{
+   //
+   // Small moduli are common enough, and the reduction cheap enough, that the allocation would
+   // be a large part of the cost, so those use the stack too:
+   //
+   static const unsigned small_limbs = 16;
+   unsigned k = m.size();
+   if(k <= small_limbs)
+   {
+      limb_type storage[small_limbs + 1 + detail::barrett_reduce_storage_size_c<small_limbs>::value];
+      detail::barrett_reduce(storage, x.limbs(), x.size(), m.limbs(), k, pmu, storage + k + 1);
+      result.resize(k, k);
+      std::copy(storage, storage + result.size(), result.limbs());
+   }
+   else
+   {
+      detail::scoped_limb_storage<typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::allocator_type> storage(x.allocator(), k + 1 + detail::barrett_reduce_storage_size(k));
+      detail::barrett_reduce(storage.data(), x.limbs(), x.size(), m.limbs(), k, pmu, storage.data() + k + 1);
+      result.resize(k, k);
+      std::copy(storage.data(), storage.data() + result.size(), result.limbs());
+   }
+   result.normalize();
+}
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1>
+inline void barrett_reduce(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>& result, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>& x, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>& m, const limb_type* pmu)
+{
+   //
+   // No reciprocal is built for moduli of barrett_cutoff limbs or more, so the storage need only
+   // cover moduli below that, and large types don't reserve stack they never use:
+   //
+   static const unsigned internal_limb_count = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>::internal_limb_count;
+   static const unsigned max_limbs = internal_limb_count < barrett_cutoff ? internal_limb_count : barrett_cutoff;
+   unsigned k = m.size();
+   if(k > max_limbs)
+   {
+      eval_modulus(result, x, m);
+      result.sign(false);
+      return;
+   }
+   limb_type storage[max_limbs + 1 + detail::barrett_reduce_storage_size_c<max_limbs>::value];
+   detail::barrett_reduce(storage, x.limbs(), x.size(), m.limbs(), k, pmu, storage + k + 1);
+   result.resize(k, k);
+   std::copy(storage, storage + result.size(), result.limbs());
+   result.normalize();
+}
+//
+// result = x % m, with the reciprocal of m precomputed, result may alias x:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, expression_template_option ExpressionTemplates>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_modulus(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& x, const barrett_reducer<number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>, ExpressionTemplates> >& m)
+{
+   const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& n = m.modulus().backend();
+   if(!m.reciprocal() || (x.size() > 2 * n.size()))
+   {
+      eval_modulus(result, x, n);
+      return;
+   }
+   if(x.size() < n.size())
+   {
+      // |x| < m already:
+      result = x;
+      return;
+   }
+   bool s = x.sign();
+   barrett_reduce(result, x, n, m.reciprocal());
+   result.sign(s && !eval_is_zero(result));
+}
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, expression_template_option ExpressionTemplates>
+inline typename enable_if_c<is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_modulus(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& x, const barrett_reducer<number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>, ExpressionTemplates> >& m)
+{
+   // A single hardware division is as good as it gets:
+   result = x;
+   eval_modulus(result, m.modulus().backend());
+}
+
+} // namespace backends
+
+}} // namespaces
+
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+#endif
@@ -58,13 +58,21 @@ void bitwise_op(
    // * o negative, result positive.
    // * Both negative.
    //
-   // When one arg is negative we convert to 2's complement form "on the fly",
-   // and then convert back to signed-magnitude form at the end.
+   // When one arg is negative we convert to 2's complement form, in place for
+   // "result" and on the fly for "o", and then convert back to signed-magnitude
+   // form at the end.
    //
    // Note however, that if the type is checked, then bitwise ops on negative values
    // are not permitted and an exception will result.
    //
    is_valid_bitwise_op(result, o, typename CppInt1::checked_type());
+   if(o.sign() && (static_cast<const void*>(&result) == static_cast<const void*>(&o)))
+   {
+      // We're about to convert result in place, so "o" needs a copy first:
+      CppInt2 t(o);
+      bitwise_op(result, t, op, mpl::true_());
+      return;
+   }
    //
    // First figure out how big the result needs to be and set up some data:
    //
@@ -78,104 +86,51 @@ void bitwise_op(
    for(unsigned i = rs; i < x; ++i)
       pr[i] = 0;
 
-   limb_type next_limb = 0;
-
-   if(!result.sign())
+   //
+   // Negative values are converted to two's complement in place.  The sign extension of each
+   // argument, all ones for negative values, gives the limb beyond the end of the result:
+   //
+   limb_type r_extension = 0;
+   limb_type o_extension = 0;
+   if(result.sign())
    {
-      if(!o.sign())
-      {
-         for(unsigned i = 0; i < os; ++i)
-            pr[i] = op(pr[i], po[i]);
-         for(unsigned i = os; i < x; ++i)
-            pr[i] = op(pr[i], limb_type(0));
-      }
-      else
-      {
-         // "o" is negative:
-         double_limb_type carry = 1;
-         for(unsigned i = 0; i < os; ++i)
-         {
-            carry += static_cast<double_limb_type>(~po[i]);
-            pr[i] = op(pr[i], static_cast<limb_type>(carry));
-            carry >>= CppInt1::limb_bits;
-         }
-         for(unsigned i = os; i < x; ++i)
-         {
-            carry += static_cast<double_limb_type>(~limb_type(0));
-            pr[i] = op(pr[i], static_cast<limb_type>(carry));
-            carry >>= CppInt1::limb_bits;
-         }
-         // Set the overflow into the "extra" limb:
-         carry += static_cast<double_limb_type>(~limb_type(0));
-         next_limb = op(limb_type(0), static_cast<limb_type>(carry));
-      }
+      detail::negate_limbs(pr, x);
+      r_extension = ~limb_type(0);
+   }
+   if(!o.sign())
+   {
+      op(pr, pr, po, os);
+      for(unsigned i = os; i < x; ++i)
+         pr[i] = op(pr[i], limb_type(0));
    }
    else
    {
-      if(!o.sign())
-      {
-         // "result" is negative:
-         double_limb_type carry = 1;
-         for(unsigned i = 0; i < os; ++i)
-         {
-            carry += static_cast<double_limb_type>(~pr[i]);
-            pr[i] = op(static_cast<limb_type>(carry), po[i]);
-            carry >>= CppInt1::limb_bits;
-         }
-         for(unsigned i = os; i < x; ++i)
-         {
-            carry += static_cast<double_limb_type>(~pr[i]);
-            pr[i] = op(static_cast<limb_type>(carry), limb_type(0));
-            carry >>= CppInt1::limb_bits;
-         }
-         // Set the overflow into the "extra" limb:
-         carry += static_cast<double_limb_type>(~limb_type(0));
-         next_limb = op(static_cast<limb_type>(carry), limb_type(0));
-      }
-      else
-      {
-         // both are negative:
-         double_limb_type r_carry = 1;
-         double_limb_type o_carry = 1;
-         for(unsigned i = 0; i < os; ++i)
-         {
-            r_carry += static_cast<double_limb_type>(~pr[i]);
-            o_carry += static_cast<double_limb_type>(~po[i]);
-            pr[i] = op(static_cast<limb_type>(r_carry), static_cast<limb_type>(o_carry));
-            r_carry >>= CppInt1::limb_bits;
-            o_carry >>= CppInt1::limb_bits;
-         }
-         for(unsigned i = os; i < x; ++i)
-         {
-            r_carry += static_cast<double_limb_type>(~pr[i]);
-            o_carry += static_cast<double_limb_type>(~limb_type(0));
-            pr[i] = op(static_cast<limb_type>(r_carry), static_cast<limb_type>(o_carry));
-            r_carry >>= CppInt1::limb_bits;
-            o_carry >>= CppInt1::limb_bits;
-         }
-         // Set the overflow into the "extra" limb:
-         r_carry += static_cast<double_limb_type>(~limb_type(0));
-         o_carry += static_cast<double_limb_type>(~limb_type(0));
-         next_limb = op(static_cast<limb_type>(r_carry), static_cast<limb_type>(o_carry));
-      }
+      //
+      // "o" is negative, and we can't change it, so apply the conversion as we go:
+      // its two's complement is zero below the least significant non-zero limb, the negation
+      // of that limb, and then the complement of all the limbs above:
+      //
+      unsigned k = 0;
+      BOOST_ASSERT((os > 1) || *po);
+      for(; !po[k]; ++k)
+         pr[k] = op(pr[k], limb_type(0));
+      pr[k] = op(pr[k], static_cast<limb_type>(0u - po[k]));
+      op.with_complement(pr + k + 1, pr + k + 1, po + k + 1, os - k - 1);
+      for(unsigned i = os; i < x; ++i)
+         pr[i] = op(pr[i], ~limb_type(0));
+      o_extension = ~limb_type(0);
    }
    //
-   // See if the result is negative or not:
+   // See if the result is negative or not, and if so convert back to signed magnitude.
+   // When every limb is zero the result is -2^(x * limb_bits) which needs one more limb:
    //
-   if(static_cast<signed_limb_type>(next_limb) < 0)
+   if(op(r_extension, o_extension))
    {
-      double_limb_type carry = 1;
-      for(unsigned i = 0; i < x; ++i)
-      {
-         carry += static_cast<double_limb_type>(~pr[i]);
-         pr[i] = static_cast<limb_type>(carry);
-         carry >>= CppInt1::limb_bits;
-      }
-      if(carry)
+      if(!detail::negate_limbs(pr, x))
       {
          result.resize(x + 1, x);
          if(result.size() > x)
-            result.limbs()[x] = static_cast<limb_type>(carry);
+            result.limbs()[x] = 1;
       }
       result.sign(true);
    }
@@ -206,44 +161,100 @@ void bitwise_op(
    for(unsigned i = rs; i < x; ++i)
       pr[i] = 0;
 
-   for(unsigned i = 0; i < os; ++i)
-      pr[i] = op(pr[i], po[i]);
+   op(pr, pr, po, os);
    for(unsigned i = os; i < x; ++i)
       pr[i] = op(pr[i], limb_type(0));
 
    result.normalize();
 }
 
-struct bit_and{ limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a & b; } };
-struct bit_or { limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a | b; } };
-struct bit_xor{ limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a ^ b; } };
+//
+// Each operator applies to either a single limb, or to whole vectors of limbs via the kernels in limb_kernels.hpp.
+// with_complement(r, a, b, n) sets r = a op ~b, for the two's complement of negative values:
+//
+struct bit_and
+{
+   BOOST_CONSTEXPR limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a & b; }
+   void operator()(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n)const BOOST_NOEXCEPT { detail::and_limbs_n(pr, pa, pb, n); }
+   void with_complement(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n)const BOOST_NOEXCEPT
+   {
+      // a & ~b == ~(~a | b):
+      detail::complement_limbs_n(pr, pa, n);
+      detail::or_limbs_n(pr, pr, pb, n);
+      detail::complement_limbs_n(pr, pr, n);
+   }
+};
+struct bit_or
+{
+   BOOST_CONSTEXPR limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a | b; }
+   void operator()(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n)const BOOST_NOEXCEPT { detail::or_limbs_n(pr, pa, pb, n); }
+   void with_complement(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n)const BOOST_NOEXCEPT
+   {
+      // a | ~b == ~(~a & b):
+      detail::complement_limbs_n(pr, pa, n);
+      detail::and_limbs_n(pr, pr, pb, n);
+      detail::complement_limbs_n(pr, pr, n);
+   }
+};
+struct bit_xor
+{
+   BOOST_CONSTEXPR limb_type operator()(limb_type a, limb_type b)const BOOST_NOEXCEPT { return a ^ b; }
+   void operator()(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n)const BOOST_NOEXCEPT { detail::xor_limbs_n(pr, pa, pb, n); }
+   void with_complement(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n)const BOOST_NOEXCEPT
+   {
+      // a ^ ~b == ~(a ^ b):
+      detail::xor_limbs_n(pr, pa, pb, n);
+      detail::complement_limbs_n(pr, pr, n);
+   }
+};
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
    eval_bitwise_and(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_bitwise(result, result, o, bit_and());
+      return;
+   }
+#endif
    bitwise_op(result, o, bit_and(), 
       mpl::bool_<std::numeric_limits<number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> > >::is_signed || std::numeric_limits<number<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> > >::is_signed>());
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
    eval_bitwise_or(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_bitwise(result, result, o, bit_or());
+      return;
+   }
+#endif
    bitwise_op(result, o, bit_or(),
       mpl::bool_<std::numeric_limits<number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> > >::is_signed || std::numeric_limits<number<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> > >::is_signed>());
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
    eval_bitwise_xor(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_bitwise(result, result, o, bit_xor());
+      return;
+   }
+#endif
    bitwise_op(result, o, bit_xor(),
       mpl::bool_<std::numeric_limits<number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> > >::is_signed || std::numeric_limits<number<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> > >::is_signed>());
 }
@@ -279,12 +290,19 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<is_signed_number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<is_signed_number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
    eval_complement(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& o) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
    BOOST_STATIC_ASSERT_MSG(((Checked1 != checked) || (Checked2 != checked)), "Attempt to take the complement of a signed type results in undefined behavior.");
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_complement(result, o);
+      return;
+   }
+#endif
    // Increment and negate:
    result = o;
    eval_increment(result);
@@ -292,15 +310,21 @@ BOOST_MP_FORCEINLINE typename enable_if_c<is_signed_number<cpp_int_backend<MinBi
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
-BOOST_MP_FORCEINLINE typename enable_if_c<is_unsigned_number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value >::type
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<is_unsigned_number<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value >::type
    eval_complement(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
       const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& o) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_complement(result, o);
+      return;
+   }
+#endif
    unsigned os = o.size();
    result.resize(UINT_MAX, os);
-   for(unsigned i = 0; i < os; ++i)
-      result.limbs()[i] = ~o.limbs()[i];
+   detail::complement_limbs_n(result.limbs(), o.limbs(), os);
    for(unsigned i = os; i < result.size(); ++i)
       result.limbs()[i] = ~static_cast<limb_type>(0);
    result.normalize();
@@ -382,62 +406,46 @@ inline void left_shift_generic(Int& result, double_limb_type s)
       ++rs; // Most significant limb will overflow when shifted
    rs += offset;
    result.resize(rs, rs);
-   bool truncated = result.size() != rs;
+   rs = result.size();
 
    typename Int::limb_pointer pr = result.limbs();
 
-   if(offset > rs)
+   if(offset >= rs)
    {
       // The result is shifted past the end of the result:
       result = static_cast<limb_type>(0);
       return;
    }
-
-   unsigned i = rs - result.size();
    // This code only works when shift is non-zero, otherwise we invoke undefined behaviour!
    BOOST_ASSERT(shift);
-   if(!truncated)
-   {
-      if(rs > ors + offset)
-      {
-         pr[rs - 1 - i] = pr[ors - 1 - i] >> (Int::limb_bits - shift);
-         --rs;
-      }
-      else
-      {
-         pr[rs - 1 - i] = pr[ors - 1 - i] << shift;
-         if(ors > 1)
-            pr[rs - 1 - i] |= pr[ors - 2 - i] >> (Int::limb_bits - shift);
-         ++i;
-      }
-   }
-   for(; rs - i >= 2 + offset; ++i)
-   {
-      pr[rs - 1 - i] = pr[rs - 1 - i - offset] << shift;
-      pr[rs - 1 - i] |= pr[rs - 2 - i - offset] >> (Int::limb_bits - shift);
-   }
-   if(rs - i >= 1 + offset)
-   {
-      pr[rs - 1 - i] = pr[rs - 1 - i - offset] << shift;
-      ++i;
-   }
-   for(; i < rs; ++i)
-      pr[rs - 1 - i] = 0;
+   // Only the limbs which still fit in the result once shifted take part:
+   unsigned n = (std::min)(ors, static_cast<unsigned>(rs - offset));
+   limb_type overflow = detail::left_shift_limbs_n(pr + offset, pr, n, static_cast<unsigned>(shift));
+   if(offset + n < rs)
+      pr[offset + n] = overflow;
+   std::fill(pr, pr + offset, static_cast<limb_type>(0u));
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
-inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+inline BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
    eval_left_shift(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result,
       double_limb_type s) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_shift(result, s, true);
+      return;
+   }
+#endif
    is_valid_bitwise_op(result, typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::checked_type());
    if(!s)
       return;
 
 #if BOOST_ENDIAN_LITTLE_BYTE && defined(BOOST_MP_USE_LIMB_SHIFT)
-   static const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits - 1;
-   static const limb_type byte_shift_mask = CHAR_BIT - 1;
+   const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits - 1;
+   const limb_type byte_shift_mask = CHAR_BIT - 1;
    if((s & limb_shift_mask) == 0)
    {
       left_shift_limb(result, s);
@@ -447,13 +455,13 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       left_shift_byte(result, s);
    }
 #elif BOOST_ENDIAN_LITTLE_BYTE
-   static const limb_type byte_shift_mask = CHAR_BIT - 1;
+   const limb_type byte_shift_mask = CHAR_BIT - 1;
    if((s & byte_shift_mask) == 0)
    {
       left_shift_byte(result, s);
    }
 #else
-   static const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits - 1;
+   const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits - 1;
    if((s & limb_shift_mask) == 0)
    {
       left_shift_limb(result, s);
@@ -539,42 +547,42 @@ inline void right_shift_generic(Int& result, double_limb_type s)
          return;
       }
    }
-   unsigned i = 0;
-
    // This code only works for non-zero shift, otherwise we invoke undefined behaviour!
    BOOST_ASSERT(shift);
-   for(; i + offset + 1 < ors; ++i)
-   {
-      pr[i] = pr[i + offset] >> shift;
-      pr[i] |= pr[i + offset + 1] << (Int::limb_bits - shift);
-   }
-   pr[i] = pr[i + offset] >> shift;
+   detail::right_shift_limbs_n(pr, pr + offset, ors - static_cast<unsigned>(offset), static_cast<unsigned>(shift));
    result.resize(rs, rs);
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_int_check_type Checked1, class Allocator1>
-inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, unsigned_magnitude, Checked1, Allocator1> >::value>::type
+inline BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, unsigned_magnitude, Checked1, Allocator1> >::value>::type
    eval_right_shift(
       cpp_int_backend<MinBits1, MaxBits1, unsigned_magnitude, Checked1, Allocator1>& result,
       double_limb_type s) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, unsigned_magnitude, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_shift(result, s, false);
+      return;
+   }
+#endif
    is_valid_bitwise_op(result, typename cpp_int_backend<MinBits1, MaxBits1, unsigned_magnitude, Checked1, Allocator1>::checked_type());
    if(!s)
       return;
 
 #if BOOST_ENDIAN_LITTLE_BYTE && defined(BOOST_MP_USE_LIMB_SHIFT)
-   static const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::limb_bits - 1;
-   static const limb_type byte_shift_mask = CHAR_BIT - 1;
+   const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::limb_bits - 1;
+   const limb_type byte_shift_mask = CHAR_BIT - 1;
    if((s & limb_shift_mask) == 0)
       right_shift_limb(result, s);
    else if((s & byte_shift_mask) == 0)
       right_shift_byte(result, s);
 #elif BOOST_ENDIAN_LITTLE_BYTE
-   static const limb_type byte_shift_mask = CHAR_BIT - 1;
+   const limb_type byte_shift_mask = CHAR_BIT - 1;
    if((s & byte_shift_mask) == 0)
       right_shift_byte(result, s);
 #else
-   static const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::limb_bits - 1;
+   const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::limb_bits - 1;
    if((s & limb_shift_mask) == 0)
       right_shift_limb(result, s);
 #endif
@@ -582,11 +590,18 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       right_shift_generic(result, s);
 }
 template <unsigned MinBits1, unsigned MaxBits1, cpp_int_check_type Checked1, class Allocator1>
-inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1> >::value>::type
+inline BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1> >::value>::type
    eval_right_shift(
       cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>& result,
       double_limb_type s) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1> >::value))
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_shift(result, s, false);
+      return;
+   }
+#endif
    is_valid_bitwise_op(result, typename cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::checked_type());
    if(!s)
       return;
@@ -596,18 +611,18 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       eval_increment(result);
 
 #if BOOST_ENDIAN_LITTLE_BYTE && defined(BOOST_MP_USE_LIMB_SHIFT)
-   static const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::limb_bits - 1;
-   static const limb_type byte_shift_mask = CHAR_BIT - 1;
+   const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::limb_bits - 1;
+   const limb_type byte_shift_mask = CHAR_BIT - 1;
    if((s & limb_shift_mask) == 0)
       right_shift_limb(result, s);
    else if((s & byte_shift_mask) == 0)
       right_shift_byte(result, s);
 #elif BOOST_ENDIAN_LITTLE_BYTE
-   static const limb_type byte_shift_mask = CHAR_BIT - 1;
+   const limb_type byte_shift_mask = CHAR_BIT - 1;
    if((s & byte_shift_mask) == 0)
       right_shift_byte(result, s);
 #else
-   static const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::limb_bits - 1;
+   const limb_type limb_shift_mask = cpp_int_backend<MinBits1, MaxBits1, signed_magnitude, Checked1, Allocator1>::limb_bits - 1;
    if((s & limb_shift_mask) == 0)
       right_shift_limb(result, s);
 #endif
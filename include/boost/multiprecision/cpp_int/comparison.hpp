@@ -21,12 +21,16 @@ namespace boost{ namespace multiprecision{ namespace backends{
 // Start with non-trivial cpp_int's:
 //
 template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator>
-BOOST_MP_FORCEINLINE typename enable_if_c<
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<
       !is_trivial_cpp_int<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> >::value, 
       bool
    >::type 
    eval_eq(const cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>& a, const cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>& b) BOOST_NOEXCEPT
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+      return a.compare(b) == 0;
+#endif
 #if BOOST_WORKAROUND(BOOST_MSVC, >= 1600)
    return (a.sign() == b.sign())
       && (a.size() == b.size())
@@ -0,0 +1,325 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+//
+// Arithmetic on fixed precision cpp_int's inside constant expressions:
+//
+#ifndef BOOST_MP_CPP_INT_CONSTEXPR_KERNELS_HPP
+#define BOOST_MP_CPP_INT_CONSTEXPR_KERNELS_HPP
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+//
+// None of the runtime routines can be used in a constant expression: they use memcpy, std::copy
+// and intrinsics, and they read the limbs through whichever union member happened to be written.
+// So when an unchecked fixed precision type is constant evaluated, each of the front end functions
+// hands off to one of the routines below instead.  These work on zero extended copies of the
+// magnitudes, use the simplest possible algorithms (compile time is not the place to be clever),
+// and then build the result as a whole new value.  They are never called at runtime, and other
+// types have non-constexpr stubs so that misuse is a compile time error:
+//
+template <class CppInt>
+struct is_constexpr_cpp_int : public mpl::false_ {};
+
+template <unsigned Bits, cpp_integer_type SignType>
+struct is_constexpr_cpp_int<cpp_int_backend<Bits, Bits, SignType, unchecked, void> >
+   : public mpl::bool_<!is_trivial_cpp_int<cpp_int_backend<Bits, Bits, SignType, unchecked, void> >::value> {};
+
+namespace detail{
+
+template <unsigned N>
+struct constexpr_limbs
+{
+   limb_type m_data[N];
+};
+
+template <class CppInt>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<CppInt::internal_limb_count> constexpr_load(const CppInt& a)
+{
+   constexpr_limbs<CppInt::internal_limb_count> r = {};
+   for(unsigned i = 0; i < a.size(); ++i)
+      r.m_data[i] = a.limbs()[i];
+   return r;
+}
+template <class CppInt>
+BOOST_CXX14_CONSTEXPR void constexpr_store(CppInt& result, const constexpr_limbs<CppInt::internal_limb_count>& r, bool neg)
+{
+   CppInt t;
+   for(unsigned i = 0; i < CppInt::internal_limb_count; ++i)
+      t.limbs()[i] = r.m_data[i];
+   t.resize(CppInt::internal_limb_count, CppInt::internal_limb_count);
+   // Masks off the bits above the precision of the type, and finds the true size:
+   t.normalize();
+   if(neg)
+      t.negate();
+   result = t;
+}
+
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR int constexpr_compare(const constexpr_limbs<N>& a, const constexpr_limbs<N>& b)
+{
+   for(unsigned i = N; i > 0; --i)
+   {
+      if(a.m_data[i - 1] != b.m_data[i - 1])
+         return a.m_data[i - 1] > b.m_data[i - 1] ? 1 : -1;
+   }
+   return 0;
+}
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR bool constexpr_is_zero(const constexpr_limbs<N>& a)
+{
+   for(unsigned i = 0; i < N; ++i)
+      if(a.m_data[i])
+         return false;
+   return true;
+}
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N> constexpr_add(const constexpr_limbs<N>& a, const constexpr_limbs<N>& b, limb_type carry)
+{
+   constexpr_limbs<N> r = {};
+   for(unsigned i = 0; i < N; ++i)
+   {
+      limb_type s = a.m_data[i] + b.m_data[i];
+      limb_type c = s < a.m_data[i];
+      r.m_data[i] = s + carry;
+      carry = c | (r.m_data[i] < s);
+   }
+   return r;
+}
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N> constexpr_subtract(const constexpr_limbs<N>& a, const constexpr_limbs<N>& b)
+{
+   constexpr_limbs<N> r = {};
+   limb_type borrow = 0;
+   for(unsigned i = 0; i < N; ++i)
+   {
+      limb_type d = a.m_data[i] - b.m_data[i];
+      limb_type c = d > a.m_data[i];
+      r.m_data[i] = d - borrow;
+      borrow = c | (r.m_data[i] > d);
+   }
+   return r;
+}
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N> constexpr_complement(const constexpr_limbs<N>& a)
+{
+   constexpr_limbs<N> r = {};
+   for(unsigned i = 0; i < N; ++i)
+      r.m_data[i] = ~a.m_data[i];
+   return r;
+}
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N> constexpr_negate(const constexpr_limbs<N>& a)
+{
+   constexpr_limbs<N> zero = {};
+   return constexpr_subtract(zero, a);
+}
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N> constexpr_multiply(const constexpr_limbs<N>& a, const constexpr_limbs<N>& b)
+{
+   // Schoolbook, and only the limbs which fit in the result:
+   constexpr_limbs<N> r = {};
+   for(unsigned i = 0; i < N; ++i)
+   {
+      limb_type carry = 0;
+      for(unsigned j = 0; i + j < N; ++j)
+      {
+         double_limb_type t = static_cast<double_limb_type>(a.m_data[i]) * b.m_data[j] + r.m_data[i + j] + carry;
+         r.m_data[i + j] = static_cast<limb_type>(t);
+         carry = static_cast<limb_type>(t >> (sizeof(limb_type) * CHAR_BIT));
+      }
+   }
+   return r;
+}
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N> constexpr_left_shift(const constexpr_limbs<N>& a, double_limb_type s)
+{
+   const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   constexpr_limbs<N> r = {};
+   if(s >= static_cast<double_limb_type>(N) * limb_bits)
+      return r;
+   unsigned offset = static_cast<unsigned>(s / limb_bits);
+   unsigned shift = static_cast<unsigned>(s % limb_bits);
+   for(unsigned i = N; i > offset; --i)
+   {
+      r.m_data[i - 1] = a.m_data[i - 1 - offset] << shift;
+      if(shift && (i - 1 > offset))
+         r.m_data[i - 1] |= a.m_data[i - 2 - offset] >> (limb_bits - shift);
+   }
+   return r;
+}
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N> constexpr_right_shift(const constexpr_limbs<N>& a, double_limb_type s)
+{
+   const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   constexpr_limbs<N> r = {};
+   if(s >= static_cast<double_limb_type>(N) * limb_bits)
+      return r;
+   unsigned offset = static_cast<unsigned>(s / limb_bits);
+   unsigned shift = static_cast<unsigned>(s % limb_bits);
+   for(unsigned i = 0; i + offset < N; ++i)
+   {
+      r.m_data[i] = a.m_data[i + offset] >> shift;
+      if(shift && (i + offset + 1 < N))
+         r.m_data[i] |= a.m_data[i + offset + 1] << (limb_bits - shift);
+   }
+   return r;
+}
+//
+// Restoring division one bit at a time, leaves the remainder in r:
+//
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N> constexpr_divide(const constexpr_limbs<N>& a, const constexpr_limbs<N>& b, constexpr_limbs<N>& r)
+{
+   const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   constexpr_limbs<N> q = {};
+   r = q;
+   // Leading zero limbs of a contribute nothing but zero quotient bits:
+   unsigned len = N;
+   while(len && !a.m_data[len - 1])
+      --len;
+   for(unsigned i = len * limb_bits; i > 0; --i)
+   {
+      unsigned bit = i - 1;
+      limb_type top = r.m_data[N - 1] >> (limb_bits - 1);
+      r = constexpr_left_shift(r, 1);
+      r.m_data[0] |= (a.m_data[bit / limb_bits] >> (bit % limb_bits)) & 1u;
+      if(top || (constexpr_compare(r, b) >= 0))
+      {
+         r = constexpr_subtract(r, b);
+         q.m_data[bit / limb_bits] |= static_cast<limb_type>(1u) << (bit % limb_bits);
+      }
+   }
+   return q;
+}
+//
+// Signed values take part in bitwise operations in two's complement form:
+//
+template <unsigned N>
+BOOST_CXX14_CONSTEXPR constexpr_limbs<N + 1> constexpr_twos_complement(const constexpr_limbs<N>& a, bool neg)
+{
+   constexpr_limbs<N + 1> r = {};
+   for(unsigned i = 0; i < N; ++i)
+      r.m_data[i] = a.m_data[i];
+   return neg ? constexpr_negate(r) : r;
+}
+
+//
+// And the entry points, first for the types we can handle:
+//
+template <class CppInt>
+BOOST_CXX14_CONSTEXPR typename enable_if_c<is_constexpr_cpp_int<CppInt>::value>::type
+   constexpr_add(CppInt& result, const CppInt& a, const CppInt& b, bool subtract)
+{
+   constexpr_limbs<CppInt::internal_limb_count> x = constexpr_load(a), y = constexpr_load(b);
+   bool neg = a.sign();
+   if(a.sign() == (b.sign() != subtract))
+      x = constexpr_add(x, y, 0);
+   else if(is_signed_number<CppInt>::value && (constexpr_compare(x, y) < 0))
+   {
+      x = constexpr_subtract(y, x);
+      neg = !neg;
+   }
+   else
+      x = constexpr_subtract(x, y);
+   constexpr_store(result, x, neg);
+}
+template <class CppInt>
+BOOST_CXX14_CONSTEXPR typename enable_if_c<is_constexpr_cpp_int<CppInt>::value>::type
+   constexpr_multiply(CppInt& result, const CppInt& a, const CppInt& b)
+{
+   constexpr_store(result, constexpr_multiply(constexpr_load(a), constexpr_load(b)), a.sign() != b.sign());
+}
+template <class CppInt>
+BOOST_CXX14_CONSTEXPR typename enable_if_c<is_constexpr_cpp_int<CppInt>::value>::type
+   constexpr_divide(CppInt& result, const CppInt& a, const CppInt& b, bool modulus)
+{
+   constexpr_limbs<CppInt::internal_limb_count> y = constexpr_load(b), r = {};
+   if(constexpr_is_zero(y))
+      BOOST_THROW_EXCEPTION(std::overflow_error("Integer Division by zero."));
+   constexpr_limbs<CppInt::internal_limb_count> q = constexpr_divide(constexpr_load(a), y, r);
+   // The quotient truncates towards zero, and the remainder takes the sign of a:
+   if(modulus)
+      constexpr_store(result, r, a.sign());
+   else
+      constexpr_store(result, q, a.sign() != b.sign());
+}
+template <class CppInt, class Op>
+BOOST_CXX14_CONSTEXPR typename enable_if_c<is_constexpr_cpp_int<CppInt>::value>::type
+   constexpr_bitwise(CppInt& result, const CppInt& a, const CppInt& b, Op op)
+{
+   const unsigned n = CppInt::internal_limb_count;
+   constexpr_limbs<n + 1> x = constexpr_twos_complement(constexpr_load(a), a.sign()), y = constexpr_twos_complement(constexpr_load(b), b.sign());
+   for(unsigned i = 0; i <= n; ++i)
+      x.m_data[i] = op(x.m_data[i], y.m_data[i]);
+   bool neg = is_signed_number<CppInt>::value && (x.m_data[n] >> (sizeof(limb_type) * CHAR_BIT - 1));
+   if(neg)
+      x = constexpr_negate(x);
+   constexpr_limbs<n> r = {};
+   for(unsigned i = 0; i < n; ++i)
+      r.m_data[i] = x.m_data[i];
+   constexpr_store(result, r, neg);
+}
+template <class CppInt>
+BOOST_CXX14_CONSTEXPR typename enable_if_c<is_constexpr_cpp_int<CppInt>::value>::type
+   constexpr_complement(CppInt& result, const CppInt& a)
+{
+   constexpr_limbs<CppInt::internal_limb_count> x = constexpr_load(a), one = {};
+   if(!is_signed_number<CppInt>::value)
+   {
+      constexpr_store(result, constexpr_complement(x), false);
+      return;
+   }
+   // ~a == -a - 1, which moves the magnitude one away from zero when a is positive, and one towards it otherwise:
+   one.m_data[0] = 1;
+   if(a.sign())
+      constexpr_store(result, constexpr_subtract(x, one), false);
+   else
+      constexpr_store(result, constexpr_add(x, one, 0), true);
+}
+template <class CppInt>
+BOOST_CXX14_CONSTEXPR typename enable_if_c<is_constexpr_cpp_int<CppInt>::value>::type
+   constexpr_shift(CppInt& result, double_limb_type s, bool left)
+{
+   constexpr_limbs<CppInt::internal_limb_count> x = constexpr_load(result), one = {};
+   bool neg = result.sign();
+   if(left)
+      x = constexpr_left_shift(x, s);
+   else if(neg)
+   {
+      // Rounds towards -infinity, as a two's complement shift would:
+      one.m_data[0] = 1;
+      x = constexpr_add(constexpr_right_shift(constexpr_subtract(x, one), s), one, 0);
+   }
+   else
+      x = constexpr_right_shift(x, s);
+   constexpr_store(result, x, neg);
+}
+//
+// Everything else can't be constant evaluated, these are never reached at runtime:
+//
+template <class R, class A, class B>
+inline typename disable_if_c<is_constexpr_cpp_int<R>::value && is_same<R, A>::value && is_same<R, B>::value>::type
+   constexpr_add(R&, const A&, const B&, bool) {}
+template <class R, class A, class B>
+inline typename disable_if_c<is_constexpr_cpp_int<R>::value && is_same<R, A>::value && is_same<R, B>::value>::type
+   constexpr_multiply(R&, const A&, const B&) {}
+template <class R, class A, class B>
+inline typename disable_if_c<is_constexpr_cpp_int<R>::value && is_same<R, A>::value && is_same<R, B>::value>::type
+   constexpr_divide(R&, const A&, const B&, bool) {}
+template <class R, class A, class B, class Op>
+inline typename disable_if_c<is_constexpr_cpp_int<R>::value && is_same<R, A>::value && is_same<R, B>::value>::type
+   constexpr_bitwise(R&, const A&, const B&, Op) {}
+template <class R, class A>
+inline typename disable_if_c<is_constexpr_cpp_int<R>::value && is_same<R, A>::value>::type
+   constexpr_complement(R&, const A&) {}
+template <class R>
+inline typename disable_if_c<is_constexpr_cpp_int<R>::value>::type
+   constexpr_shift(R&, double_limb_type, bool) {}
+
+} // namespace detail
+
+}}} // namespaces
+
+#endif
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_MP_CPP_INT_COUNTING_ALLOCATOR_HPP
+#define BOOST_MP_CPP_INT_COUNTING_ALLOCATOR_HPP
+
+#include <boost/multiprecision/detail/number_base.hpp>
+#include <boost/multiprecision/detail/rebind.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost{ namespace multiprecision{
+
+//
+// Instrumentation for checking where, and how often, memory is allocated: counting_allocator
+// forwards to another allocator, and records every call in the statistics of the calling thread.
+//
+struct allocation_statistics
+{
+   unsigned long long allocations;
+   unsigned long long deallocations;
+   unsigned long long bytes_allocated;
+};
+
+inline allocation_statistics& thread_allocation_statistics() BOOST_NOEXCEPT
+{
+   static BOOST_MP_THREAD_LOCAL allocation_statistics stats = { 0, 0, 0 };
+   return stats;
+}
+
+inline void reset_thread_allocation_statistics() BOOST_NOEXCEPT
+{
+   allocation_statistics& stats = thread_allocation_statistics();
+   stats.allocations = stats.deallocations = stats.bytes_allocated = 0;
+}
+
+template <class T, class Allocator = std::allocator<T> >
+class counting_allocator : public Allocator
+{
+public:
+   typedef T value_type;
+
+   template <class U>
+   struct rebind
+   {
+      typedef counting_allocator<U, typename backends::detail::rebind<U, Allocator>::type> other;
+   };
+
+   counting_allocator() {}
+   counting_allocator(const Allocator& a) : Allocator(a) {}
+   template <class U, class Allocator2>
+   counting_allocator(const counting_allocator<U, Allocator2>& a) : Allocator(a.base()) {}
+
+   T* allocate(std::size_t n)
+   {
+      T* p = Allocator::allocate(n);
+      allocation_statistics& stats = thread_allocation_statistics();
+      ++stats.allocations;
+      stats.bytes_allocated += n * sizeof(T);
+      return p;
+   }
+   void deallocate(T* p, std::size_t n)
+   {
+      ++thread_allocation_statistics().deallocations;
+      Allocator::deallocate(p, n);
+   }
+
+   const Allocator& base()const BOOST_NOEXCEPT { return *this; }
+};
+
+template <class T, class Allocator, class U, class Allocator2>
+inline bool operator==(const counting_allocator<T, Allocator>& a, const counting_allocator<U, Allocator2>& b)
+{
+   return a.base() == b.base();
+}
+template <class T, class Allocator, class U, class Allocator2>
+inline bool operator!=(const counting_allocator<T, Allocator>& a, const counting_allocator<U, Allocator2>& b)
+{
+   return !(a == b);
+}
+
+}} // namespaces
+
+#endif
@@ -158,6 +158,13 @@ enum cpp_int_check_type
       && !defined(BOOST_NO_CXX11_CONSTEXPR)
 #  define BOOST_MP_USER_DEFINED_LITERALS
 #endif
+//
+// Arithmetic on fixed precision cpp_int's in constant expressions needs the literal support for
+// building values, and a way to tell that we're being constant evaluated:
+//
+#if defined(BOOST_MP_USER_DEFINED_LITERALS) && defined(BOOST_MP_IS_CONST_EVALUATED)
+#  define BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+#endif
 
 #endif // BOOST_MP_CPP_INT_CORE_HPP
 
@@ -8,21 +8,494 @@
 #ifndef BOOST_MP_CPP_INT_DIV_HPP
 #define BOOST_MP_CPP_INT_DIV_HPP
 
-namespace boost{ namespace multiprecision{ namespace backends{
+#include <boost/multiprecision/detail/bitscan.hpp> // find_msb
 
+namespace boost{ namespace multiprecision{
+
+namespace backends{ namespace detail{
+//
+// Division by a single limb.  Dividing a double limb by a limb in hardware is slow, and on some
+// platforms goes through a library call, so after Moller and Granlund ("Improved division by
+// invariant integers", IEEE Transactions on Computers, 60 (2011)) we precompute the reciprocal
+// v = floor((B^2 - 1) / d) - B of the divisor d, normalised so that its most significant bit is
+// set, after which each quotient limb costs a multiplication and a couple of adjustments.  Computing
+// v takes one hardware division, so this pays as soon as there are two limbs to divide:
+//
+inline limb_type limb_reciprocal(limb_type d) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   BOOST_ASSERT(d >> (limb_bits - 1));
+   //
+   // B^2 - 1 - Bd = (B - 1 - d)B + B - 1, whose high limb is less than d, so the quotient fits in
+   // a limb and the division is a single hardware instruction where there is one:
+   //
+   return static_cast<limb_type>(((static_cast<double_limb_type>(~d) << limb_bits) | static_cast<limb_type>(~static_cast<limb_type>(0u))) / d);
+}
+//
+// Returns the quotient of the double limb u1:u0 by the normalised d with reciprocal v, where u1 < d,
+// and sets r to the remainder:
+//
+BOOST_MP_FORCEINLINE limb_type divide_2_by_1(limb_type u1, limb_type u0, limb_type d, limb_type v, limb_type& r) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   BOOST_ASSERT(u1 < d);
+   // The sum wraps modulo B^2 by design:
+   double_limb_type q = static_cast<double_limb_type>(v) * u1 + ((static_cast<double_limb_type>(u1) << limb_bits) | u0);
+   limb_type q1 = static_cast<limb_type>(q >> limb_bits) + 1;
+   limb_type q0 = static_cast<limb_type>(q);
+   limb_type rem = u0 - q1 * d;
+   if(rem > q0)
+   {
+      --q1;
+      rem += d;
+   }
+   if(rem >= d)
+   {
+      // Rarely taken:
+      ++q1;
+      rem -= d;
+   }
+   r = rem;
+   return q1;
+}
+
+}} // namespace backends::detail
+
+//
+// A single limb divisor with its reciprocal precomputed, for dividing many values by the same
+// small number, see divide_qr and integer_modulus below:
+//
+class divisor
+{
+public:
+   explicit divisor(limb_type d) : m_value(d)
+   {
+      if(d == 0)
+         BOOST_THROW_EXCEPTION(std::overflow_error("Integer Division by zero."));
+      m_shift = sizeof(limb_type) * CHAR_BIT - 1 - boost::multiprecision::detail::find_msb(d);
+      m_normalised = d << m_shift;
+      m_reciprocal = backends::detail::limb_reciprocal(m_normalised);
+   }
+   limb_type value()const BOOST_NOEXCEPT { return m_value; }
+   //
+   // The divisor shifted left until its most significant bit is set, the shift, and the reciprocal
+   // of the shifted value:
+   //
+   limb_type normalised()const BOOST_NOEXCEPT { return m_normalised; }
+   unsigned  shift()const BOOST_NOEXCEPT { return m_shift; }
+   limb_type reciprocal()const BOOST_NOEXCEPT { return m_reciprocal; }
+
+private:
+   limb_type m_value, m_normalised, m_reciprocal;
+   unsigned  m_shift;
+};
+
+namespace backends{
+
+namespace detail{
+//
+// Divides the n limbs at px by d, writing the low qn limbs of the quotient to pq, and returns the
+// remainder.  Each limb of px is read before the same limb of the quotient is written, so pq may
+// be px:
+//
+inline limb_type divide_limbs_by_limb(limb_type* pq, unsigned qn, const limb_type* px, unsigned n, const divisor& d) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   const unsigned  shift = d.shift();
+   const limb_type dn = d.normalised();
+   const limb_type v = d.reciprocal();
+   limb_type r = 0;
+   if(!shift)
+   {
+      for(unsigned i = n; i-- > 0;)
+      {
+         limb_type q = divide_2_by_1(r, px[i], dn, v, r);
+         if(i < qn)
+            pq[i] = q;
+      }
+      return r;
+   }
+   //
+   // Otherwise the numerator is shifted by the same amount as the divisor on the fly, and the
+   // remainder shifted back at the end:
+   //
+   r = px[n - 1] >> (limb_bits - shift);
+   for(unsigned i = n - 1; i > 0; --i)
+   {
+      limb_type q = divide_2_by_1(r, (px[i] << shift) | (px[i - 1] >> (limb_bits - shift)), dn, v, r);
+      if(i < qn)
+         pq[i] = q;
+   }
+   limb_type q = divide_2_by_1(r, px[0] << shift, dn, v, r);
+   if(qn)
+      pq[0] = q;
+   return r >> shift;
+}
+
+} // namespace detail
+
+//
+// Division of large values:
+//
+// The long division in divide_unsigned_helper below takes time proportional to the product of
+// the sizes of the quotient and divisor.  When both are large we instead use the recursive
+// algorithm of Burnikel and Ziegler ("Fast Recursive Division", MPI-I-98-1-022), which splits
+// the quotient in two, computes the upper half by dividing by the upper half of the divisor,
+// corrects that with a single multiplication by the lower half of the divisor, and then does
+// the same again for the lower half of the quotient.  Since the multiplications go through the
+// Karatsuba/Toom-Cook/NTT routines, division costs a small multiple of a multiplication.
+// The cutoff is expressed in limbs of both the divisor and the quotient, and may be changed by
+// defining the macro below before including this header.
+//
+#ifndef BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF
+#define BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF 16
+#endif
+
+static const unsigned burnikel_ziegler_cutoff = BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF;
+
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF >= 4, "BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF is too small for the recursion to terminate.");
+
+namespace detail{
+//
+// All the routines below work on a divisor d of dn limbs, normalised so that its most significant
+// bit is set.  They leave the remainder in the low dn limbs of the numerator, and return the most
+// significant limb of the quotient (0 or 1) which doesn't fit in the quotient buffer.
+//
+// Long division, Knuth Algorithm D, with a quotient of nn - dn limbs.  pq may be null when only
+// the remainder is wanted, or pn + dn, in which case each limb of the quotient replaces the limb
+// of the numerator that has just been used up:
+//
+inline limb_type divide_schoolbook(limb_type* pq, limb_type* pn, unsigned nn, const limb_type* pd, unsigned dn) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(dn >= 2);
+   BOOST_ASSERT(nn >= dn);
+   BOOST_ASSERT(pd[dn - 1] >> (sizeof(limb_type) * CHAR_BIT - 1));
+   static const double_limb_type base = static_cast<double_limb_type>(1u) << (sizeof(limb_type) * CHAR_BIT);
+   limb_type qh = 0;
+   if(compare_limbs(pn + nn - dn, dn, pd, dn) >= 0)
+   {
+      subtract_limbs(pn + nn - dn, pn + nn - dn, dn, pd, dn);
+      qh = 1;
+   }
+   const limb_type d1 = pd[dn - 1];
+   const limb_type d0 = pd[dn - 2];
+   for(unsigned j = nn - dn; j-- > 0;)
+   {
+      //
+      // Estimate the next quotient limb from the top 3 limbs of the remainder and the top 2 of
+      // the divisor, the estimate is then either correct or one too large:
+      //
+      limb_type n2 = pn[j + dn];
+      double_limb_type n = (static_cast<double_limb_type>(n2) << (sizeof(limb_type) * CHAR_BIT)) | pn[j + dn - 1];
+      double_limb_type q = n / d1;
+      double_limb_type rem = n % d1;
+      if(q >= base)
+      {
+         q = base - 1;
+         rem = n - q * d1;
+      }
+      while((rem < base) && (q * d0 > ((rem << (sizeof(limb_type) * CHAR_BIT)) | pn[j + dn - 2])))
+      {
+         --q;
+         rem += d1;
+      }
+      limb_type borrow = multiply_subtract_limbs(pn + j, dn, pd, dn, static_cast<limb_type>(q));
+      if(borrow > n2)
+      {
+         --q;
+         add_limbs(pn + j, pn + j, dn, pd, dn);
+      }
+      pn[j + dn] = 0;
+      if(pq)
+         pq[j] = static_cast<limb_type>(q);
+   }
+   return qh;
+}
+//
+// Upper bound on the temporary storage needed by divide_burnikel_ziegler for a divisor of n limbs:
+// each level needs n limbs for a product, plus room for either the multiplication or the next
+// level down:
+//
+inline std::size_t divide_burnikel_ziegler_storage_size(unsigned n) BOOST_NOEXCEPT
+{
+   if(n < burnikel_ziegler_cutoff)
+      return 0;
+   return n + (std::max)(multiply_limbs_storage_size(n), divide_burnikel_ziegler_storage_size(n - n / 2));
+}
+//
+// Recursive division of 2n limbs by n limbs giving n limbs of quotient, storage needs
+// divide_burnikel_ziegler_storage_size(n) limbs:
+//
+inline limb_type divide_burnikel_ziegler(limb_type* pq, limb_type* pn, const limb_type* pd, unsigned n, limb_type* storage) BOOST_NOEXCEPT
+{
+   if(n < burnikel_ziegler_cutoff)
+      return divide_schoolbook(pq, pn, 2 * n, pd, n);
+   static const limb_type one = 1;
+   unsigned lo = n / 2;
+   unsigned hi = n - lo;
+   limb_type* t = storage;
+   storage += n;
+   //
+   // Upper half of the quotient from the upper 2 * hi limbs of the numerator and the upper hi
+   // limbs of the divisor, then subtract that times the lower lo limbs of the divisor.  The
+   // estimate is never too small, and if it's too large then the remainder is negative and
+   // we add back the divisor until it's not:
+   //
+   limb_type qh = divide_burnikel_ziegler(pq + lo, pn + 2 * lo, pd + lo, hi, storage);
+   multiply_limbs(t, pq + lo, hi, pd, lo, storage);
+   limb_type borrow = subtract_limbs(pn + lo, pn + lo, n, t, n);
+   if(qh)
+      borrow += subtract_limbs(pn + n, pn + n, lo, pd, lo);
+   while(borrow)
+   {
+      qh -= subtract_limbs(pq + lo, pq + lo, hi, &one, 1);
+      borrow -= add_limbs(pn + lo, pn + lo, n, pd, n);
+   }
+   //
+   // Lower half the same way, from what's left of the numerator:
+   //
+   limb_type ql = divide_burnikel_ziegler(pq, pn + hi, pd + hi, lo, storage);
+   multiply_limbs(t, pq, lo, pd, hi, storage);
+   borrow = subtract_limbs(pn, pn, n, t, n);
+   if(ql)
+      borrow += subtract_limbs(pn + lo, pn + lo, hi, pd, hi);
+   while(borrow)
+   {
+      subtract_limbs(pq, pq, lo, &one, 1);
+      borrow -= add_limbs(pn, pn, n, pd, n);
+   }
+   return qh;
+}
+//
+// Temporary storage needed by divide_block and divide_limbs for a divisor of dn limbs:
+//
+inline std::size_t divide_limbs_storage_size(unsigned dn) BOOST_NOEXCEPT
+{
+   return dn + (std::max)(multiply_limbs_storage_size(dn), divide_burnikel_ziegler_storage_size(dn));
+}
+//
+// Division of dn + k limbs by dn limbs giving k <= dn limbs of quotient, where the upper dn limbs
+// of the numerator are less than the divisor:
+//
+inline void divide_block(limb_type* pq, limb_type* pn, const limb_type* pd, unsigned dn, unsigned k, limb_type* storage) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(k <= dn);
+   limb_type qh;
+   if(k == dn)
+      qh = divide_burnikel_ziegler(pq, pn, pd, dn, storage);
+   else if(k < burnikel_ziegler_cutoff)
+      qh = divide_schoolbook(pq, pn, dn + k, pd, dn);
+   else
+   {
+      //
+      // As for the halves above: divide the upper 2k limbs by the upper k limbs of the
+      // divisor, and correct with the remaining dn - k:
+      //
+      static const limb_type one = 1;
+      limb_type* t = storage;
+      storage += dn;
+      qh = divide_burnikel_ziegler(pq, pn + dn - k, pd + dn - k, k, storage);
+      multiply_limbs(t, pq, k, pd, dn - k, storage);
+      limb_type borrow = subtract_limbs(pn, pn, dn, t, dn);
+      if(qh)
+         borrow += subtract_limbs(pn + k, pn + k, dn - k, pd, dn - k);
+      while(borrow)
+      {
+         qh -= subtract_limbs(pq, pq, k, &one, 1);
+         borrow -= add_limbs(pn, pn, dn, pd, dn);
+      }
+   }
+   BOOST_ASSERT(!qh);
+   (void)qh;
+}
+//
+// q = n / d of nn - dn limbs, where the most significant limb of n is less than that of d.
+// The remainder is left in the low dn limbs of n:
+//
+inline void divide_limbs(limb_type* pq, limb_type* pn, unsigned nn, const limb_type* pd, unsigned dn, limb_type* storage) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(pn[nn - 1] < pd[dn - 1]);
+   //
+   // Work down from the most significant end of the quotient, dn limbs at a time, with
+   // whatever is left over done first:
+   //
+   unsigned qn = nn - dn;
+   unsigned k = qn % dn ? qn % dn : dn;
+   while(qn)
+   {
+      qn -= k;
+      divide_block(pq + qn, pn + qn, pd, dn, k, storage);
+      k = dn;
+   }
+}
+
+} // namespace detail
+
+//
+// Sets result = x / y and r = x % y, ignoring signs, by the recursive routines above, or just
+// result = x / y when result and r are the same object.  These are only used for types which can
+// grow.  The numerator is normalised in the storage of r, where the remainder is left.  The divisor,
+// the quotient and the temporaries of the recursion come from the workspace if one is bound with
+// room for them, and otherwise go in r after the numerator, so that once r has grown nothing is
+// allocated.  Only types whose size is bounded can be too small for that, and allocate instead.
+// Both x and y are copied before anything else is written, so result and r may alias either:
+//
 template <class CppInt1, class CppInt2, class CppInt3>
-void divide_unsigned_helper(
+void divide_unsigned_recursive(
    CppInt1* result, 
    const CppInt2& x, 
    const CppInt3& y, 
-   CppInt1& r)
+   CppInt1& r,
+   const mpl::true_&)
 {
-   if(((void*)result == (void*)&x) || ((void*)&r == (void*)&x))
+   typedef detail::scoped_limb_storage<typename CppInt1::allocator_type> storage_type;
+   static const unsigned max_limbs = max_precision<CppInt1>::value / CppInt1::limb_bits + ((max_precision<CppInt1>::value % CppInt1::limb_bits) ? 1 : 0);
+   //
+   // Normalise so that the most significant bit of the divisor is set, giving the numerator
+   // an extra limb so that its most significant limb is less than the divisor's:
+   //
+   unsigned dn = y.size();
+   unsigned nn = x.size() + 1;
+   unsigned qn = nn - dn;
+   unsigned shift = CppInt1::limb_bits - 1 - boost::multiprecision::detail::find_msb(y.limbs()[dn - 1]);
+   std::size_t n = dn + qn + detail::divide_limbs_storage_size(dn);
+   bool in_r = nn + n <= max_limbs;
+   storage_type storage(r.allocator(), in_r ? n : nn + n, !in_r);
+   limb_type* ps = storage.data();
+   limb_type* pn;
+   if(in_r)
+   {
+      bool aliased = (void*)&x == (void*)&r;
+      unsigned size = static_cast<unsigned>(ps ? nn : nn + n);
+      r.resize(size, size);
+      pn = r.limbs();
+      if(!aliased)
+         std::copy(x.limbs(), x.limbs() + nn - 1, pn);
+      if(!ps)
+         ps = pn + nn;
+   }
+   else
+   {
+      pn = ps;
+      ps += nn;
+      std::copy(x.limbs(), x.limbs() + nn - 1, pn);
+   }
+   limb_type* pd = ps;
+   limb_type* pq = pd + dn;
+   pn[nn - 1] = 0;
+   std::copy(y.limbs(), y.limbs() + dn, pd);
+   if(shift)
    {
-      CppInt2 t(x);
-      divide_unsigned_helper(result, t, y, r);
+      detail::left_shift_limbs(pn, nn, shift);
+      detail::left_shift_limbs(pd, dn, shift);
+   }
+   detail::divide_limbs(pq, pn, nn, pd, dn, pq + qn);
+
+   if(result != &r)
+   {
+      if(shift)
+         detail::right_shift_limbs(pn, dn, shift);
+      r.resize(dn, dn);
+      if(!in_r)
+         std::copy(pn, pn + r.size(), r.limbs());
+      r.normalize();
+      r.sign(false);
+   }
+   if(result)
+   {
+      result->resize(qn, qn);
+      std::copy(pq, pq + result->size(), result->limbs());
+      result->normalize();
+      result->sign(false);
+   }
+}
+template <class CppInt1, class CppInt2, class CppInt3>
+inline void divide_unsigned_recursive(CppInt1*, const CppInt2&, const CppInt3&, CppInt1&, const mpl::false_&)
+{
+   // Fixed precision types never get here:
+   BOOST_ASSERT(0);
+}
+//
+// Sets result = r / y and r = r % y, ignoring signs, by Knuth's algorithm D above, or just
+// result = r / y when result is r.  The normalised numerator and divisor are built in the storage
+// of r, and the quotient is written straight into result, or when result is r, over the top of the
+// numerator as it's used up.  So there are no temporaries: r needs room for r.size() + y.size() + 1
+// limbs, and nothing else is allocated once r and result have grown to the sizes needed.  Neither r
+// nor result may alias y:
+//
+template <class CppInt1, class CppInt3>
+void divide_unsigned_in_place(
+   CppInt1* result, 
+   const CppInt3& y, 
+   CppInt1& r,
+   const mpl::true_&)
+{
+   unsigned dn = y.size();
+   unsigned nn = r.size() + 1;
+   unsigned qn = nn - dn;
+   unsigned shift = CppInt1::limb_bits - 1 - boost::multiprecision::detail::find_msb(y.limbs()[dn - 1]);
+   r.resize(nn + dn, nn + dn);
+   limb_type* pn = r.limbs();
+   limb_type* pd = pn + nn;
+   pn[nn - 1] = 0;
+   std::copy(y.limbs(), y.limbs() + dn, pd);
+   if(shift)
+   {
+      detail::left_shift_limbs(pn, nn, shift);
+      detail::left_shift_limbs(pd, dn, shift);
+   }
+   limb_type* pq = 0;
+   if(result == &r)
+      pq = pn + dn;
+   else if(result)
+   {
+      result->resize(qn, qn);
+      pq = result->limbs();
+   }
+   limb_type qh = detail::divide_schoolbook(pq, pn, nn, pd, dn);
+   BOOST_ASSERT(!qh);
+   (void)qh;
+   if(result == &r)
+   {
+      std::copy(pq, pq + qn, pn);
+      r.resize(qn, qn);
+      r.normalize();
       return;
    }
+   if(shift)
+      detail::right_shift_limbs(pn, dn, shift);
+   r.resize(dn, dn);
+   r.normalize();
+   if(result)
+      result->normalize();
+}
+template <class CppInt1, class CppInt3>
+inline void divide_unsigned_in_place(CppInt1*, const CppInt3&, CppInt1&, const mpl::false_&)
+{
+   // Fixed precision types never get here:
+   BOOST_ASSERT(0);
+}
+
+//
+// Sets result = x / y, unless result is null, and r = x % y, ignoring signs, or just result = x / y
+// when result and r are the same object.  A single limb divisor goes to the short division below,
+// and values of at most two limbs use double limb arithmetic.  Otherwise types which can grow use
+// the recursive division above once the divisor and quotient both have burnikel_ziegler_cutoff
+// limbs or more (BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF, 16 by default), and Knuth's algorithm D in the
+// storage of r below that.  Fixed precision types, and bounded types with no room for the
+// normalised numerator and divisor, fall back on the long division at the end:
+//
+template <class CppInt1, class CppInt2, class CppInt3>
+void divide_unsigned_helper(
+   CppInt1* result, 
+   const CppInt2& x, 
+   const CppInt3& y, 
+   CppInt1& r)
+{
+   //
+   // The remainder starts out as a copy of x and is then reduced in place, so x may alias either
+   // result or r.  The divisor is needed until the end:
+   //
    if(((void*)result == (void*)&y) || ((void*)&r == (void*)&y))
    {
       CppInt3 t(y);
@@ -30,32 +503,33 @@ void divide_unsigned_helper(
       return;
    }
 
-   /*
-    Very simple, fairly braindead long division.
-    Start by setting the remainder equal to x, and the
-    result equal to 0.  Then in each loop we calculate our
-    "best guess" for how many times y divides into r,
-    add our guess to the result, and subtract guess*y
-    from the remainder r.  One wrinkle is that the remainder
-    may go negative, in which case we subtract the current guess
-    from the result rather than adding.  The value of the guess
-    is determined by dividing the most-significant-limb of the
-    current remainder by the most-significant-limb of y.
-
-    Note that there are more efficient algorithms than this
-    available, in particular see Knuth Vol 2.  However for small
-    numbers of limbs this generally outperforms the alternatives
-    and avoids the normalisation step which would require extra storage.
-    */
-
-
    using default_ops::eval_subtract;
 
+   static const unsigned max_limbs = max_precision<CppInt1>::value / CppInt1::limb_bits + ((max_precision<CppInt1>::value % CppInt1::limb_bits) ? 1 : 0);
+
    if(result == &r)
    {
+      //
+      // Only the quotient is wanted.  Types which can grow divide by a multi-limb y in the storage
+      // of result, see above, and otherwise the remainder goes in a temporary, which is either on
+      // the stack or a single limb:
+      //
+      if(CppInt1::variable && (y.size() > 1) && (x.size() + y.size() + 1 <= max_limbs))
+      {
+         if(x.size() < y.size())
+            *result = static_cast<limb_type>(0u);
+         else if((y.size() >= burnikel_ziegler_cutoff) && (x.size() >= y.size() + burnikel_ziegler_cutoff))
+            divide_unsigned_recursive(result, x, y, r, mpl::bool_<CppInt1::variable>());
+         else
+         {
+            r = x;
+            r.sign(false);
+            divide_unsigned_in_place(result, y, r, mpl::bool_<CppInt1::variable>());
+         }
+         return;
+      }
       CppInt1 rem;
       divide_unsigned_helper(result, x, y, rem);
-      r = rem;
       return;
    }
 
@@ -88,11 +562,24 @@ void divide_unsigned_helper(
       return;
    }
 
+   if(CppInt1::variable && (y_order + 1 >= burnikel_ziegler_cutoff) && (r_order >= y_order + burnikel_ziegler_cutoff))
+   {
+      //
+      // Large divisor and quotient, see above:
+      //
+      divide_unsigned_recursive(result, x, y, r, mpl::bool_<CppInt1::variable>());
+      return;
+   }
+
    r = x;
    r.sign(false);
    if(result)
       *result = static_cast<limb_type>(0u);
    //
+   // From here on x is only read through r, as result may be the same object:
+   //
+   typename CppInt1::const_limb_pointer prem = r.limbs();
+   //
    // Check if the remainder is already less than the divisor, if so
    // we already have the result.  Note we try and avoid a full compare
    // if we can:
@@ -105,25 +592,23 @@ void divide_unsigned_helper(
       }
    }
 
-   CppInt1 t;
-   bool r_neg = false;
-
    //
    // See if we can short-circuit long division, and use basic arithmetic instead:
    //
    if(r_order == 0)
    {
+      limb_type a = prem[0];
       if(result)
       {
-         *result = px[0] / py[0];
+         *result = a / py[0];
       }
-      r = px[0] % py[0];
+      r = a % py[0];
       return;
    }
    else if(r_order == 1)
    {
       double_limb_type a, b;
-      a = (static_cast<double_limb_type>(px[1]) << CppInt1::limb_bits) | px[0];
+      a = (static_cast<double_limb_type>(prem[1]) << CppInt1::limb_bits) | prem[0];
       b = y_order ? 
          (static_cast<double_limb_type>(py[1]) << CppInt1::limb_bits) | py[0] 
          : py[0];
@@ -134,12 +619,43 @@ void divide_unsigned_helper(
       r = a % b;
       return;
    }
+   if(CppInt1::variable && (r_order + y_order + 3 <= max_limbs))
+   {
+      //
+      // Types which can grow do the division in the storage of r, see above:
+      //
+      divide_unsigned_in_place(result, y, r, mpl::bool_<CppInt1::variable>());
+      return;
+   }
+
+   /*
+    Very simple, fairly braindead long division.
+    Start by setting the remainder equal to x, and the
+    result equal to 0.  Then in each loop we calculate our
+    "best guess" for how many times y divides into r,
+    add our guess to the result, and subtract guess*y
+    from the remainder r.  One wrinkle is that the remainder
+    may go negative, in which case we subtract the current guess
+    from the result rather than adding.  The value of the guess
+    is determined by dividing the most-significant-limb of the
+    current remainder by the most-significant-limb of y.
+
+    Note that there are more efficient algorithms than this
+    available, in particular see Knuth Vol 2.  However for small
+    numbers of limbs this generally outperforms the alternatives
+    and avoids the normalisation step which would require extra storage.
+    That matters for fixed precision types, which have nowhere to
+    put it, types which can grow use divide_unsigned_in_place above.
+    */
+
+   CppInt1 t;
+   bool r_neg = false;
+
    //
    // prepare result:
    //
    if(result)
       result->resize(1 + r_order - y_order, 1 + r_order - y_order);
-   typename CppInt1::const_limb_pointer prem = r.limbs();
    // This is initialised just to keep the compiler from emitting useless warnings later on:
    typename CppInt1::limb_pointer pr 
       = typename CppInt1::limb_pointer();
@@ -320,155 +836,91 @@ template <class CppInt1, class CppInt2>
 void divide_unsigned_helper(
    CppInt1* result, 
    const CppInt2& x, 
-   limb_type y, 
+   const divisor& d, 
    CppInt1& r)
 {
-   if(((void*)result == (void*)&x) || ((void*)&r == (void*)&x))
+   //
+   // Short division from the most significant limb down, see divide_limbs_by_limb above.  The
+   // remainder is only a single limb until the end, so either result or r may be x itself, and
+   // when result and r are the same object only the quotient is stored:
+   //
+   bool s = x.sign();
+   unsigned n = x.size();
+   typename CppInt2::const_limb_pointer px = x.limbs();
+   // This is initialised just to keep the compiler from emitting useless warnings later on:
+   typename CppInt1::limb_pointer pq = typename CppInt1::limb_pointer();
+   unsigned qn = 0;
+   if(result)
    {
-      CppInt2 t(x);
-      divide_unsigned_helper(result, t, y, r);
-      return;
+      result->resize(n, n);
+      pq = result->limbs();
+      qn = result->size();  // may be less than n if the result is of fixed precision
    }
+   limb_type rem = detail::divide_limbs_by_limb(pq, qn, px, n, d);
+   BOOST_ASSERT(rem < d.value()); // remainder must be less than the divisor or our code has failed
 
-   if(result == &r)
+   if(result)
+   {
+      result->normalize();
+      result->sign(s);
+   }
+   if(result != &r)
    {
-      CppInt1 rem;
-      divide_unsigned_helper(result, x, y, rem);
       r = rem;
-      return;
+      r.sign(s);
    }
+}
 
-   // As above, but simplified for integer divisor:
-
-   using default_ops::eval_subtract;
-
+template <class CppInt1, class CppInt2>
+void divide_unsigned_helper(
+   CppInt1* result, 
+   const CppInt2& x, 
+   limb_type y, 
+   CppInt1& r)
+{
    if(y == 0)
    {
       BOOST_THROW_EXCEPTION(std::overflow_error("Integer Division by zero."));
    }
-   //
-   // Find the most significant word of numerator.
-   //
-   limb_type r_order = x.size() - 1;
-
-   //
-   // Set remainder and result to their initial values:
-   //
-   r = x;
-   r.sign(false);
-   typename CppInt1::limb_pointer pr = r.limbs();
-
-   //
-   // check for x < y, try to do this without actually having to 
-   // do a full comparison:
-   //
-   if((r_order == 0) && (*pr < y))
+   if(x.size() > 1)
    {
-      if(result)
-         *result = static_cast<limb_type>(0u);
+      divide_unsigned_helper(result, x, divisor(y), r);
       return;
    }
-
    //
-   // See if we can short-circuit long division, and use basic arithmetic instead:
+   // A single limb needs just the one hardware division:
    //
-   if(r_order == 0)
-   {
-      if(result)
-      {
-         *result = *pr / y;
-         result->sign(x.sign());
-      }
-      *pr %= y;
-      r.sign(x.sign());
-      return;
-   }
-   else if(r_order == 1)
-   {
-      double_limb_type a;
-      a = (static_cast<double_limb_type>(pr[r_order]) << CppInt1::limb_bits) | pr[0];
-      if(result)
-      {
-         *result = a / y;
-         result->sign(x.sign());
-      }
-      r = a % y;
-      r.sign(x.sign());
-      return;
-   }
-
-   // This is initialised just to keep the compiler from emitting useless warnings later on:
-   typename CppInt1::limb_pointer pres = typename CppInt1::limb_pointer();
+   bool s = x.sign();
+   limb_type a = *x.limbs();
    if(result)
    {
-      result->resize(r_order + 1, r_order + 1);
-      pres = result->limbs();
-      if(result->size() > r_order)
-         pres[r_order] = 0;  // just in case we don't set the most significant limb below.
+      *result = a / y;
+      result->sign(s);
    }
-
-   do
+   if(result != &r)
    {
-      //
-      // Calculate our best guess for how many times y divides into r:
-      //
-      if((pr[r_order] < y) && r_order)
-      {
-         double_limb_type a, b;
-         a = (static_cast<double_limb_type>(pr[r_order]) << CppInt1::limb_bits) | pr[r_order - 1];
-         b = a % y;
-         r.resize(r.size() - 1, r.size() - 1);
-         --r_order;
-         pr[r_order] = static_cast<limb_type>(b);
-         if(result)
-            pres[r_order] = static_cast<limb_type>(a / y);
-         if(r_order && pr[r_order] == 0)
-         {
-            --r_order;  // No remainder, division was exact.
-            r.resize(r.size() - 1, r.size() - 1);
-            if(result)
-               pres[r_order] = static_cast<limb_type>(0u);
-         }
-      }
-      else
-      {
-         if(result)
-            pres[r_order] = pr[r_order] / y;
-         pr[r_order] %= y;
-         if(r_order && pr[r_order] == 0)
-         {
-            --r_order;  // No remainder, division was exact.
-            r.resize(r.size() - 1, r.size() - 1);
-            if(result)
-               pres[r_order] = static_cast<limb_type>(0u);
-         }
-      }
-   }
-   // Termination condition is really just a check that r >= y, but with two common
-   // short-circuit cases handled first:
-   while(r_order || (pr[r_order] >= y));
-
-   if(result)
-   {
-      result->normalize();
-      result->sign(x.sign());
+      r = a % y;
+      r.sign(s);
    }
-   r.normalize();
-   r.sign(x.sign());
-
-   BOOST_ASSERT(r.compare(y) < 0); // remainder must be less than the divisor or our code has failed
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2, unsigned MinBits3, unsigned MaxBits3, cpp_integer_type SignType3, cpp_int_check_type Checked3, class Allocator3>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type 
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type 
    eval_divide(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a, 
       const cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3>& b)
 {
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> r;
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_divide(result, a, b, false);
+      return;
+   }
+#endif
    bool s = a.sign() != b.sign();
-   divide_unsigned_helper(&result, a, b, r);
+   // Passing result for the remainder as well asks for the quotient alone:
+   divide_unsigned_helper(&result, a, b, result);
    result.sign(s);
 }
 
@@ -479,9 +931,8 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a, 
       limb_type& b)
 {
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> r;
    bool s = a.sign();
-   divide_unsigned_helper(&result, a, b, r);
+   divide_unsigned_helper(&result, a, b, result);
    result.sign(s);
 }
 
@@ -492,21 +943,19 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a, 
       signed_limb_type& b)
 {
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> r;
    bool s = a.sign() != (b < 0);
-   divide_unsigned_helper(&result, a, static_cast<limb_type>(boost::multiprecision::detail::unsigned_abs(b)), r);
+   divide_unsigned_helper(&result, a, static_cast<limb_type>(boost::multiprecision::detail::unsigned_abs(b)), result);
    result.sign(s);
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
    eval_divide(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& b)
 {
-   // There is no in place divide:
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> a(result);
-   eval_divide(result, a, b);
+   // The helpers above work correctly when the result aliases the numerator:
+   eval_divide(result, result, b);
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
@@ -515,9 +964,8 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       limb_type b)
 {
-   // There is no in place divide:
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> a(result);
-   eval_divide(result, a, b);
+   // The helpers above work correctly when the result aliases the numerator:
+   eval_divide(result, result, b);
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
@@ -526,18 +974,24 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       signed_limb_type b)
 {
-   // There is no in place divide:
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> a(result);
-   eval_divide(result, a, b);
+   // The helpers above work correctly when the result aliases the numerator:
+   eval_divide(result, result, b);
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2, unsigned MinBits3, unsigned MaxBits3, cpp_integer_type SignType3, cpp_int_check_type Checked3, class Allocator3>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
    eval_modulus(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a, 
       const cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3>& b)
 {
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_divide(result, a, b, true);
+      return;
+   }
+#endif
    bool s = a.sign();
    divide_unsigned_helper(static_cast<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>* >(0), a, b, result);
    result.sign(s);
@@ -567,14 +1021,13 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
    eval_modulus(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& b)
 {
-   // There is no in place divide:
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> a(result);
-   eval_modulus(result, a, b);
+   // The helpers above work correctly when the result aliases the numerator:
+   eval_modulus(result, result, b);
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
@@ -583,9 +1036,8 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       limb_type b)
 {
-   // There is no in place divide:
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> a(result);
-   eval_modulus(result, a, b);
+   // The helpers above work correctly when the result aliases the numerator:
+   eval_modulus(result, result, b);
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
@@ -594,9 +1046,8 @@ BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<Mi
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       signed_limb_type b)
 {
-   // There is no in place divide:
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> a(result);
-   eval_modulus(result, a, b);
+   // The helpers above work correctly when the result aliases the numerator:
+   eval_modulus(result, result, b);
 }
 
 //
@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+//
+// Wrappers for the x86 carry chain intrinsics used by the inner loops of cpp_int:
+//
+#ifndef BOOST_MP_CPP_INT_INTEL_INTRINSICS_HPP
+#define BOOST_MP_CPP_INT_INTEL_INTRINSICS_HPP
+
+#include <boost/multiprecision/cpp_int/cpp_int_config.hpp>
+
+//
+// Add with carry and subtract with borrow are part of the base x86 instruction set, so the
+// intrinsics can be used whenever the compiler provides them.  Define BOOST_MP_NO_INTEL_INTRINSICS
+// to always use the portable double_limb_type code instead:
+//
+#if !defined(BOOST_MP_NO_INTEL_INTRINSICS) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#  if defined(BOOST_MSVC) || (defined(BOOST_INTEL) && defined(_MSC_VER))
+#     include <intrin.h>
+#     define BOOST_MP_HAS_INTEL_INTRINSICS
+#  elif (defined(__clang__) && (__clang_major__ >= 4)) || (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ >= 5))
+#     include <immintrin.h>
+#     define BOOST_MP_HAS_INTEL_INTRINSICS
+#  endif
+#endif
+//
+// Instructions beyond the base set are used only after checking for them at runtime with cpuid, see
+// limb_kernels.hpp.  That requires compiling individual functions for a later CPU than the rest of
+// the program, which GCC and clang do with the target attribute, and MSVC allows anyway.  Define
+// BOOST_MP_NO_CPU_DISPATCH to always use the generic kernels:
+//
+#if defined(BOOST_MP_HAS_INTEL_INTRINSICS) && !defined(BOOST_MP_NO_CPU_DISPATCH)
+#  if defined(BOOST_MSVC) || (defined(BOOST_INTEL) && defined(_MSC_VER))
+#     define BOOST_MP_HAS_CPU_DISPATCH
+#     define BOOST_MP_TARGET(isa)
+#  else
+#     include <cpuid.h>
+#     define BOOST_MP_HAS_CPU_DISPATCH
+#     define BOOST_MP_TARGET(isa) __attribute__((target(isa)))
+#  endif
+//
+// The AVX-512 population count instructions need a more recent compiler than the other extensions:
+//
+#  if (defined(__clang__) && (__clang_major__ >= 6)) || (!defined(__clang__) && defined(__GNUC__) && (__GNUC__ >= 8)) || (defined(_MSC_VER) && (_MSC_VER >= 1920))
+#     define BOOST_MP_HAS_AVX512_POPCNT
+#  endif
+#endif
+
+#ifdef BOOST_MP_HAS_INTEL_INTRINSICS
+
+namespace boost{ namespace multiprecision{ namespace detail{
+
+//
+// *p = a + b + carry, returns the carry out:
+//
+BOOST_MP_FORCEINLINE unsigned char addcarry_limb(unsigned char carry, limb_type a, limb_type b, limb_type* p)
+{
+#ifdef BOOST_HAS_INT128
+   unsigned long long r;
+   carry = _addcarry_u64(carry, a, b, &r);
+#else
+   unsigned int r;
+   carry = _addcarry_u32(carry, a, b, &r);
+#endif
+   *p = r;
+   return carry;
+}
+//
+// *p = a - b - borrow, returns the borrow out:
+//
+BOOST_MP_FORCEINLINE unsigned char subborrow_limb(unsigned char borrow, limb_type a, limb_type b, limb_type* p)
+{
+#ifdef BOOST_HAS_INT128
+   unsigned long long r;
+   borrow = _subborrow_u64(borrow, a, b, &r);
+#else
+   unsigned int r;
+   borrow = _subborrow_u32(borrow, a, b, &r);
+#endif
+   *p = r;
+   return borrow;
+}
+
+#ifdef BOOST_MP_HAS_CPU_DISPATCH
+//
+// The instruction set extensions which the CPU we're running on supports:
+//
+struct cpu_features
+{
+   bool sse2;
+   bool popcnt;
+   bool avx2;
+   bool avx512f;
+   bool avx512vpopcntdq;
+};
+
+inline void cpuid(unsigned leaf, unsigned* regs)
+{
+#if defined(BOOST_MSVC) || (defined(BOOST_INTEL) && defined(_MSC_VER))
+   int r[4];
+   __cpuidex(r, static_cast<int>(leaf), 0);
+   for(unsigned i = 0; i < 4; ++i)
+      regs[i] = static_cast<unsigned>(r[i]);
+#else
+   __cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+//
+// The register state the operating system saves on a context switch, we can only use the
+// ymm and zmm registers if it saves those too:
+//
+inline unsigned long long xgetbv()
+{
+#if defined(BOOST_MSVC) || (defined(BOOST_INTEL) && defined(_MSC_VER))
+   return _xgetbv(0);
+#else
+   unsigned eax, edx;
+   __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+   return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+inline cpu_features detect_cpu_features()
+{
+   cpu_features result = { false, false, false, false, false };
+   unsigned regs[4];
+   cpuid(0, regs);
+   unsigned max_leaf = regs[0];
+   if(max_leaf < 1)
+      return result;
+   cpuid(1, regs);
+   result.sse2 = (regs[3] >> 26) & 1u;
+   result.popcnt = (regs[2] >> 23) & 1u;
+   bool ymm = false, zmm = false;
+   if((regs[2] >> 27) & 1u)
+   {
+      // OSXSAVE, now check that the xmm and ymm state is saved, and for zmm the opmask and upper zmm state too:
+      unsigned long long xcr0 = xgetbv();
+      ymm = (xcr0 & 0x06u) == 0x06u;
+      zmm = (xcr0 & 0xE6u) == 0xE6u;
+   }
+   if(max_leaf < 7)
+      return result;
+   cpuid(7, regs);
+   result.avx2 = ymm && ((regs[1] >> 5) & 1u);
+   result.avx512f = zmm && ((regs[1] >> 16) & 1u);
+   result.avx512vpopcntdq = result.avx512f && ((regs[2] >> 14) & 1u);
+   return result;
+}
+#endif
+
+}}} // namespaces
+
+#endif
+
+#endif
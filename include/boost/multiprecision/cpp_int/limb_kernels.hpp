@@ -0,0 +1,706 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+//
+// The inner loops of cpp_int arithmetic, and their selection at runtime:
+//
+#ifndef BOOST_MP_CPP_INT_LIMB_KERNELS_HPP
+#define BOOST_MP_CPP_INT_LIMB_KERNELS_HPP
+
+#include <boost/multiprecision/cpp_int/intel_intrinsics.hpp>
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+//
+// The routines here operate on raw vectors of n limbs, and each has a generic version which is
+// used on all platforms.  On x86 some of them also have versions for later CPUs, and the best
+// version the CPU supports is chosen, on first use, from a table which is built once and then cached.
+// Binaries built for the baseline instruction set therefore still use the later instructions when
+// they're available.  The table is only consulted for at least BOOST_MP_DISPATCH_CUTOFF limbs,
+// smaller vectors aren't worth the indirect call and use the generic code inline.  Routines with
+// only the generic version, such as addition and the multiplication rows, are always called directly:
+//
+#ifndef BOOST_MP_DISPATCH_CUTOFF
+#define BOOST_MP_DISPATCH_CUTOFF 8
+#endif
+
+static const unsigned dispatch_cutoff = BOOST_MP_DISPATCH_CUTOFF;
+
+namespace detail{
+
+//
+// r = a + b, returns the carry, r may alias a or b.  On x86 the carry stays in the flags register
+// via the intrinsics in intel_intrinsics.hpp, otherwise we let double_limb_type take the strain:
+//
+inline limb_type add_limbs_n_generic(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+#ifdef BOOST_MP_HAS_INTEL_INTRINSICS
+   unsigned char carry = 0;
+   unsigned i = 0;
+   for(; i + 4 <= n; i += 4)
+   {
+      carry = multiprecision::detail::addcarry_limb(carry, pa[i], pb[i], pr + i);
+      carry = multiprecision::detail::addcarry_limb(carry, pa[i + 1], pb[i + 1], pr + i + 1);
+      carry = multiprecision::detail::addcarry_limb(carry, pa[i + 2], pb[i + 2], pr + i + 2);
+      carry = multiprecision::detail::addcarry_limb(carry, pa[i + 3], pb[i + 3], pr + i + 3);
+   }
+   for(; i < n; ++i)
+      carry = multiprecision::detail::addcarry_limb(carry, pa[i], pb[i], pr + i);
+   return carry;
+#else
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      carry += static_cast<double_limb_type>(pa[i]) + static_cast<double_limb_type>(pb[i]);
+#ifdef __MSVC_RUNTIME_CHECKS
+      pr[i] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      pr[i] = static_cast<limb_type>(carry);
+#endif
+      carry >>= sizeof(limb_type) * CHAR_BIT;
+   }
+   return static_cast<limb_type>(carry);
+#endif
+}
+//
+// r = a - b, returns the borrow, r may alias a or b:
+//
+inline limb_type subtract_limbs_n_generic(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+#ifdef BOOST_MP_HAS_INTEL_INTRINSICS
+   unsigned char borrow = 0;
+   unsigned i = 0;
+   for(; i + 4 <= n; i += 4)
+   {
+      borrow = multiprecision::detail::subborrow_limb(borrow, pa[i], pb[i], pr + i);
+      borrow = multiprecision::detail::subborrow_limb(borrow, pa[i + 1], pb[i + 1], pr + i + 1);
+      borrow = multiprecision::detail::subborrow_limb(borrow, pa[i + 2], pb[i + 2], pr + i + 2);
+      borrow = multiprecision::detail::subborrow_limb(borrow, pa[i + 3], pb[i + 3], pr + i + 3);
+   }
+   for(; i < n; ++i)
+      borrow = multiprecision::detail::subborrow_limb(borrow, pa[i], pb[i], pr + i);
+   return borrow;
+#else
+   double_limb_type borrow = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      borrow = static_cast<double_limb_type>(pa[i]) - static_cast<double_limb_type>(pb[i]) - borrow;
+#ifdef __MSVC_RUNTIME_CHECKS
+      pr[i] = static_cast<limb_type>(borrow & ~static_cast<limb_type>(0));
+#else
+      pr[i] = static_cast<limb_type>(borrow);
+#endif
+      borrow = (borrow >> (sizeof(limb_type) * CHAR_BIT)) & 1u;
+   }
+   return static_cast<limb_type>(borrow);
+#endif
+}
+//
+// The two rows of long multiplication: r = x * m, and r += x * m, both return the high limb of
+// the result, r may alias x.  Unlike addition there's nothing to be gained from the carry
+// intrinsics here: the compiler can't keep the two carry chains (one for the high halves of the
+// products, one for the additions into r) in the flags at the same time, while this loop
+// already compiles to mulx when the target has BMI2:
+//
+inline limb_type multiply_limb_row_generic(limb_type* pr, const limb_type* px, unsigned n, limb_type m) BOOST_NOEXCEPT
+{
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      carry += static_cast<double_limb_type>(px[i]) * static_cast<double_limb_type>(m);
+#ifdef __MSVC_RUNTIME_CHECKS
+      pr[i] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      pr[i] = static_cast<limb_type>(carry);
+#endif
+      carry >>= sizeof(limb_type) * CHAR_BIT;
+   }
+   return static_cast<limb_type>(carry);
+}
+inline limb_type multiply_add_limb_row_generic(limb_type* pr, const limb_type* px, unsigned n, limb_type m) BOOST_NOEXCEPT
+{
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      carry += static_cast<double_limb_type>(px[i]) * static_cast<double_limb_type>(m) + pr[i];
+#ifdef __MSVC_RUNTIME_CHECKS
+      pr[i] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      pr[i] = static_cast<limb_type>(carry);
+#endif
+      carry >>= sizeof(limb_type) * CHAR_BIT;
+   }
+   return static_cast<limb_type>(carry);
+}
+//
+// Shifts by 0 < shift < bits_per_limb.  r = x << shift returns the bits shifted out of the top, and
+// works down from the most significant limb so r may overlap x as long as r >= x.
+// r = x >> shift returns the bits shifted out of the bottom (in the high bits of the result),
+// and works up from the least significant limb so r may overlap x as long as r <= x:
+//
+inline limb_type left_shift_limbs_n_generic(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(shift && (shift < sizeof(limb_type) * CHAR_BIT));
+   if(!n)
+      return 0;
+   limb_type result = px[n - 1] >> (sizeof(limb_type) * CHAR_BIT - shift);
+   for(unsigned i = n - 1; i > 0; --i)
+      pr[i] = (px[i] << shift) | (px[i - 1] >> (sizeof(limb_type) * CHAR_BIT - shift));
+   pr[0] = px[0] << shift;
+   return result;
+}
+inline limb_type right_shift_limbs_n_generic(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(shift && (shift < sizeof(limb_type) * CHAR_BIT));
+   if(!n)
+      return 0;
+   limb_type result = px[0] << (sizeof(limb_type) * CHAR_BIT - shift);
+   for(unsigned i = 0; i + 1 < n; ++i)
+      pr[i] = (px[i] >> shift) | (px[i + 1] << (sizeof(limb_type) * CHAR_BIT - shift));
+   pr[n - 1] = px[n - 1] >> shift;
+   return result;
+}
+//
+// r = a op b for the bitwise operators, r may alias a or b:
+//
+inline void and_limbs_n_generic(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      pr[i] = pa[i] & pb[i];
+}
+inline void or_limbs_n_generic(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      pr[i] = pa[i] | pb[i];
+}
+inline void xor_limbs_n_generic(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      pr[i] = pa[i] ^ pb[i];
+}
+//
+// r = ~x, r may alias x:
+//
+inline void complement_limbs_n_generic(limb_type* pr, const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   for(unsigned i = 0; i < n; ++i)
+      pr[i] = ~px[i];
+}
+//
+// The number of bits set in x, counting each limb in parallel a few bits at a time:
+//
+inline unsigned popcount_limb(limb_type x) BOOST_NOEXCEPT
+{
+   x = x - ((x >> 1) & (~static_cast<limb_type>(0) / 3));
+   x = (x & (~static_cast<limb_type>(0) / 5)) + ((x >> 2) & (~static_cast<limb_type>(0) / 5));
+   x = (x + (x >> 4)) & (~static_cast<limb_type>(0) / 17);
+   return static_cast<unsigned>((x * (~static_cast<limb_type>(0) / 255)) >> ((sizeof(limb_type) - 1) * CHAR_BIT));
+}
+inline unsigned popcount_limbs_n_generic(const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned result = 0;
+   for(unsigned i = 0; i < n; ++i)
+      result += popcount_limb(px[i]);
+   return result;
+}
+
+#ifdef BOOST_MP_HAS_CPU_DISPATCH
+//
+// Vector versions of the bitwise operators, shifts and population count, for SSE2 (which every x64
+// CPU has), AVX2 and AVX-512.  Each operator is a struct with one member per instruction set, so
+// that a single loop per instruction set serves all three:
+//
+#ifdef BOOST_HAS_INT128
+#define BOOST_MP_LIMB_LANES(intrinsic) intrinsic##_epi64
+#else
+#define BOOST_MP_LIMB_LANES(intrinsic) intrinsic##_epi32
+#endif
+
+struct and_limbs_op
+{
+   static limb_type limb(limb_type a, limb_type b) BOOST_NOEXCEPT { return a & b; }
+   BOOST_MP_TARGET("sse2") static BOOST_MP_FORCEINLINE __m128i sse2(__m128i a, __m128i b) BOOST_NOEXCEPT { return _mm_and_si128(a, b); }
+   BOOST_MP_TARGET("avx2") static BOOST_MP_FORCEINLINE __m256i avx2(__m256i a, __m256i b) BOOST_NOEXCEPT { return _mm256_and_si256(a, b); }
+   BOOST_MP_TARGET("avx512f") static BOOST_MP_FORCEINLINE __m512i avx512(__m512i a, __m512i b) BOOST_NOEXCEPT { return _mm512_and_si512(a, b); }
+};
+struct or_limbs_op
+{
+   static limb_type limb(limb_type a, limb_type b) BOOST_NOEXCEPT { return a | b; }
+   BOOST_MP_TARGET("sse2") static BOOST_MP_FORCEINLINE __m128i sse2(__m128i a, __m128i b) BOOST_NOEXCEPT { return _mm_or_si128(a, b); }
+   BOOST_MP_TARGET("avx2") static BOOST_MP_FORCEINLINE __m256i avx2(__m256i a, __m256i b) BOOST_NOEXCEPT { return _mm256_or_si256(a, b); }
+   BOOST_MP_TARGET("avx512f") static BOOST_MP_FORCEINLINE __m512i avx512(__m512i a, __m512i b) BOOST_NOEXCEPT { return _mm512_or_si512(a, b); }
+};
+struct xor_limbs_op
+{
+   static limb_type limb(limb_type a, limb_type b) BOOST_NOEXCEPT { return a ^ b; }
+   BOOST_MP_TARGET("sse2") static BOOST_MP_FORCEINLINE __m128i sse2(__m128i a, __m128i b) BOOST_NOEXCEPT { return _mm_xor_si128(a, b); }
+   BOOST_MP_TARGET("avx2") static BOOST_MP_FORCEINLINE __m256i avx2(__m256i a, __m256i b) BOOST_NOEXCEPT { return _mm256_xor_si256(a, b); }
+   BOOST_MP_TARGET("avx512f") static BOOST_MP_FORCEINLINE __m512i avx512(__m512i a, __m512i b) BOOST_NOEXCEPT { return _mm512_xor_si512(a, b); }
+};
+
+//
+// SSE2, 16 bytes at a time:
+//
+template <class Op>
+BOOST_MP_TARGET("sse2") inline void bitwise_limbs_n_sse2(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   const unsigned lanes = sizeof(__m128i) / sizeof(limb_type);
+   unsigned i = 0;
+   for(; i + lanes <= n; i += lanes)
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(pr + i), Op::sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pa + i)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(pb + i))));
+   for(; i < n; ++i)
+      pr[i] = Op::limb(pa[i], pb[i]);
+}
+BOOST_MP_TARGET("sse2") inline void complement_limbs_n_sse2(limb_type* pr, const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   const unsigned lanes = sizeof(__m128i) / sizeof(limb_type);
+   const __m128i ones = _mm_set1_epi32(-1);
+   unsigned i = 0;
+   for(; i + lanes <= n; i += lanes)
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(pr + i), _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(px + i)), ones));
+   for(; i < n; ++i)
+      pr[i] = ~px[i];
+}
+//
+// The shifts combine each vector of limbs with the same vector offset by one limb, so that every
+// lane gets the bits from its neighbour, the order of the loops is the same as the generic versions:
+//
+BOOST_MP_TARGET("sse2") inline limb_type left_shift_limbs_n_sse2(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(shift && (shift < sizeof(limb_type) * CHAR_BIT));
+   if(!n)
+      return 0;
+   const unsigned lanes = sizeof(__m128i) / sizeof(limb_type);
+   const unsigned rshift = sizeof(limb_type) * CHAR_BIT - shift;
+   const __m128i lcount = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i rcount = _mm_cvtsi32_si128(static_cast<int>(rshift));
+   limb_type result = px[n - 1] >> rshift;
+   unsigned i = n;
+   for(; i > lanes; i -= lanes)
+   {
+      __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px + i - lanes));
+      __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px + i - lanes - 1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(pr + i - lanes), _mm_or_si128(BOOST_MP_LIMB_LANES(_mm_sll)(hi, lcount), BOOST_MP_LIMB_LANES(_mm_srl)(lo, rcount)));
+   }
+   for(; i > 1; --i)
+      pr[i - 1] = (px[i - 1] << shift) | (px[i - 2] >> rshift);
+   pr[0] = px[0] << shift;
+   return result;
+}
+BOOST_MP_TARGET("sse2") inline limb_type right_shift_limbs_n_sse2(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(shift && (shift < sizeof(limb_type) * CHAR_BIT));
+   if(!n)
+      return 0;
+   const unsigned lanes = sizeof(__m128i) / sizeof(limb_type);
+   const unsigned lshift = sizeof(limb_type) * CHAR_BIT - shift;
+   const __m128i rcount = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i lcount = _mm_cvtsi32_si128(static_cast<int>(lshift));
+   limb_type result = px[0] << lshift;
+   unsigned i = 0;
+   for(; i + lanes < n; i += lanes)
+   {
+      __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px + i));
+      __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(px + i + 1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(pr + i), _mm_or_si128(BOOST_MP_LIMB_LANES(_mm_srl)(lo, rcount), BOOST_MP_LIMB_LANES(_mm_sll)(hi, lcount)));
+   }
+   for(; i + 1 < n; ++i)
+      pr[i] = (px[i] >> shift) | (px[i + 1] << lshift);
+   pr[n - 1] = px[n - 1] >> shift;
+   return result;
+}
+//
+// Hardware population count, with several independent sums so that the instructions overlap:
+//
+BOOST_MP_TARGET("popcnt") inline unsigned popcnt_limb(limb_type x) BOOST_NOEXCEPT
+{
+#ifdef BOOST_HAS_INT128
+   return static_cast<unsigned>(_mm_popcnt_u64(x));
+#else
+   return static_cast<unsigned>(_mm_popcnt_u32(x));
+#endif
+}
+BOOST_MP_TARGET("popcnt") inline unsigned popcount_limbs_n_popcnt(const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned r0 = 0, r1 = 0, r2 = 0, r3 = 0;
+   unsigned i = 0;
+   for(; i + 4 <= n; i += 4)
+   {
+      r0 += popcnt_limb(px[i]);
+      r1 += popcnt_limb(px[i + 1]);
+      r2 += popcnt_limb(px[i + 2]);
+      r3 += popcnt_limb(px[i + 3]);
+   }
+   for(; i < n; ++i)
+      r0 += popcnt_limb(px[i]);
+   return r0 + r1 + r2 + r3;
+}
+
+//
+// AVX2, 32 bytes at a time:
+//
+template <class Op>
+BOOST_MP_TARGET("avx2") inline void bitwise_limbs_n_avx2(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   const unsigned lanes = sizeof(__m256i) / sizeof(limb_type);
+   unsigned i = 0;
+   for(; i + lanes <= n; i += lanes)
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(pr + i), Op::avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pa + i)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pb + i))));
+   for(; i < n; ++i)
+      pr[i] = Op::limb(pa[i], pb[i]);
+}
+BOOST_MP_TARGET("avx2") inline void complement_limbs_n_avx2(limb_type* pr, const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   const unsigned lanes = sizeof(__m256i) / sizeof(limb_type);
+   const __m256i ones = _mm256_set1_epi32(-1);
+   unsigned i = 0;
+   for(; i + lanes <= n; i += lanes)
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(pr + i), _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(px + i)), ones));
+   for(; i < n; ++i)
+      pr[i] = ~px[i];
+}
+BOOST_MP_TARGET("avx2") inline limb_type left_shift_limbs_n_avx2(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(shift && (shift < sizeof(limb_type) * CHAR_BIT));
+   if(!n)
+      return 0;
+   const unsigned lanes = sizeof(__m256i) / sizeof(limb_type);
+   const unsigned rshift = sizeof(limb_type) * CHAR_BIT - shift;
+   const __m128i lcount = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i rcount = _mm_cvtsi32_si128(static_cast<int>(rshift));
+   limb_type result = px[n - 1] >> rshift;
+   unsigned i = n;
+   for(; i > lanes; i -= lanes)
+   {
+      __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px + i - lanes));
+      __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px + i - lanes - 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(pr + i - lanes), _mm256_or_si256(BOOST_MP_LIMB_LANES(_mm256_sll)(hi, lcount), BOOST_MP_LIMB_LANES(_mm256_srl)(lo, rcount)));
+   }
+   for(; i > 1; --i)
+      pr[i - 1] = (px[i - 1] << shift) | (px[i - 2] >> rshift);
+   pr[0] = px[0] << shift;
+   return result;
+}
+BOOST_MP_TARGET("avx2") inline limb_type right_shift_limbs_n_avx2(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(shift && (shift < sizeof(limb_type) * CHAR_BIT));
+   if(!n)
+      return 0;
+   const unsigned lanes = sizeof(__m256i) / sizeof(limb_type);
+   const unsigned lshift = sizeof(limb_type) * CHAR_BIT - shift;
+   const __m128i rcount = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i lcount = _mm_cvtsi32_si128(static_cast<int>(lshift));
+   limb_type result = px[0] << lshift;
+   unsigned i = 0;
+   for(; i + lanes < n; i += lanes)
+   {
+      __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px + i));
+      __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px + i + 1));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(pr + i), _mm256_or_si256(BOOST_MP_LIMB_LANES(_mm256_srl)(lo, rcount), BOOST_MP_LIMB_LANES(_mm256_sll)(hi, lcount)));
+   }
+   for(; i + 1 < n; ++i)
+      pr[i] = (px[i] >> shift) | (px[i + 1] << lshift);
+   pr[n - 1] = px[n - 1] >> shift;
+   return result;
+}
+//
+// Population count by looking up each nibble in a 16 entry table held in a register:
+//
+BOOST_MP_TARGET("avx2,popcnt") inline unsigned popcount_limbs_n_avx2(const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   const unsigned lanes = sizeof(__m256i) / sizeof(limb_type);
+   const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+   const __m256i low_nibbles = _mm256_set1_epi8(0x0f);
+   __m256i sum = _mm256_setzero_si256();
+   unsigned i = 0;
+   for(; i + lanes <= n; i += lanes)
+   {
+      __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px + i));
+      __m256i counts = _mm256_add_epi8(
+         _mm256_shuffle_epi8(table, _mm256_and_si256(v, low_nibbles)),
+         _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibbles)));
+      sum = _mm256_add_epi64(sum, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+   }
+   unsigned long long sums[4];
+   _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), sum);
+   unsigned result = static_cast<unsigned>(sums[0] + sums[1] + sums[2] + sums[3]);
+   for(; i < n; ++i)
+      result += popcnt_limb(px[i]);
+   return result;
+}
+
+//
+// AVX-512, 64 bytes at a time.  Some versions of GCC warn about the unused pass-through operand of
+// the unmasked shifts, so we use the zero-masked forms with every lane selected:
+//
+BOOST_MP_TARGET("avx512f") BOOST_MP_FORCEINLINE __m512i sll_limbs_avx512(__m512i v, __m128i count) BOOST_NOEXCEPT
+{
+#ifdef BOOST_HAS_INT128
+   return _mm512_maskz_sll_epi64(static_cast<__mmask8>(0xFFu), v, count);
+#else
+   return _mm512_maskz_sll_epi32(static_cast<__mmask16>(0xFFFFu), v, count);
+#endif
+}
+BOOST_MP_TARGET("avx512f") BOOST_MP_FORCEINLINE __m512i srl_limbs_avx512(__m512i v, __m128i count) BOOST_NOEXCEPT
+{
+#ifdef BOOST_HAS_INT128
+   return _mm512_maskz_srl_epi64(static_cast<__mmask8>(0xFFu), v, count);
+#else
+   return _mm512_maskz_srl_epi32(static_cast<__mmask16>(0xFFFFu), v, count);
+#endif
+}
+
+template <class Op>
+BOOST_MP_TARGET("avx512f") inline void bitwise_limbs_n_avx512(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   const unsigned lanes = sizeof(__m512i) / sizeof(limb_type);
+   unsigned i = 0;
+   for(; i + lanes <= n; i += lanes)
+      _mm512_storeu_si512(pr + i, Op::avx512(_mm512_loadu_si512(pa + i), _mm512_loadu_si512(pb + i)));
+   for(; i < n; ++i)
+      pr[i] = Op::limb(pa[i], pb[i]);
+}
+BOOST_MP_TARGET("avx512f") inline void complement_limbs_n_avx512(limb_type* pr, const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   const unsigned lanes = sizeof(__m512i) / sizeof(limb_type);
+   const __m512i ones = _mm512_set1_epi32(-1);
+   unsigned i = 0;
+   for(; i + lanes <= n; i += lanes)
+      _mm512_storeu_si512(pr + i, _mm512_xor_si512(_mm512_loadu_si512(px + i), ones));
+   for(; i < n; ++i)
+      pr[i] = ~px[i];
+}
+BOOST_MP_TARGET("avx512f") inline limb_type left_shift_limbs_n_avx512(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(shift && (shift < sizeof(limb_type) * CHAR_BIT));
+   if(!n)
+      return 0;
+   const unsigned lanes = sizeof(__m512i) / sizeof(limb_type);
+   const unsigned rshift = sizeof(limb_type) * CHAR_BIT - shift;
+   const __m128i lcount = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i rcount = _mm_cvtsi32_si128(static_cast<int>(rshift));
+   limb_type result = px[n - 1] >> rshift;
+   unsigned i = n;
+   for(; i > lanes; i -= lanes)
+   {
+      __m512i hi = _mm512_loadu_si512(px + i - lanes);
+      __m512i lo = _mm512_loadu_si512(px + i - lanes - 1);
+      _mm512_storeu_si512(pr + i - lanes, _mm512_or_si512(sll_limbs_avx512(hi, lcount), srl_limbs_avx512(lo, rcount)));
+   }
+   for(; i > 1; --i)
+      pr[i - 1] = (px[i - 1] << shift) | (px[i - 2] >> rshift);
+   pr[0] = px[0] << shift;
+   return result;
+}
+BOOST_MP_TARGET("avx512f") inline limb_type right_shift_limbs_n_avx512(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(shift && (shift < sizeof(limb_type) * CHAR_BIT));
+   if(!n)
+      return 0;
+   const unsigned lanes = sizeof(__m512i) / sizeof(limb_type);
+   const unsigned lshift = sizeof(limb_type) * CHAR_BIT - shift;
+   const __m128i rcount = _mm_cvtsi32_si128(static_cast<int>(shift));
+   const __m128i lcount = _mm_cvtsi32_si128(static_cast<int>(lshift));
+   limb_type result = px[0] << lshift;
+   unsigned i = 0;
+   for(; i + lanes < n; i += lanes)
+   {
+      __m512i lo = _mm512_loadu_si512(px + i);
+      __m512i hi = _mm512_loadu_si512(px + i + 1);
+      _mm512_storeu_si512(pr + i, _mm512_or_si512(srl_limbs_avx512(lo, rcount), sll_limbs_avx512(hi, lcount)));
+   }
+   for(; i + 1 < n; ++i)
+      pr[i] = (px[i] >> shift) | (px[i + 1] << lshift);
+   pr[n - 1] = px[n - 1] >> shift;
+   return result;
+}
+#ifdef BOOST_MP_HAS_AVX512_POPCNT
+BOOST_MP_TARGET("avx512f,avx512vpopcntdq,popcnt") inline unsigned popcount_limbs_n_avx512(const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   const unsigned lanes = sizeof(__m512i) / sizeof(limb_type);
+   __m512i sum = _mm512_setzero_si512();
+   unsigned i = 0;
+   for(; i + lanes <= n; i += lanes)
+      sum = BOOST_MP_LIMB_LANES(_mm512_add)(sum, BOOST_MP_LIMB_LANES(_mm512_popcnt)(_mm512_loadu_si512(px + i)));
+   limb_type sums[lanes];
+   _mm512_storeu_si512(sums, sum);
+   unsigned result = 0;
+   for(unsigned j = 0; j < lanes; ++j)
+      result += static_cast<unsigned>(sums[j]);
+   for(; i < n; ++i)
+      result += popcnt_limb(px[i]);
+   return result;
+}
+#endif
+
+#undef BOOST_MP_LIMB_LANES
+
+//
+// The table of kernels, with one entry for each of the routines above which has a version for a
+// later CPU.  Each starts out as the generic version and is replaced by the best one the CPU supports:
+//
+struct limb_kernels
+{
+   limb_type (*left_shift_n)(limb_type*, const limb_type*, unsigned, unsigned);
+   limb_type (*right_shift_n)(limb_type*, const limb_type*, unsigned, unsigned);
+   void (*and_n)(limb_type*, const limb_type*, const limb_type*, unsigned);
+   void (*or_n)(limb_type*, const limb_type*, const limb_type*, unsigned);
+   void (*xor_n)(limb_type*, const limb_type*, const limb_type*, unsigned);
+   void (*complement_n)(limb_type*, const limb_type*, unsigned);
+   unsigned (*popcount_n)(const limb_type*, unsigned);
+};
+
+inline limb_kernels select_limb_kernels()
+{
+   limb_kernels result = {
+      left_shift_limbs_n_generic, right_shift_limbs_n_generic,
+      and_limbs_n_generic, or_limbs_n_generic, xor_limbs_n_generic,
+      complement_limbs_n_generic, popcount_limbs_n_generic
+   };
+   multiprecision::detail::cpu_features features = multiprecision::detail::detect_cpu_features();
+   if(features.sse2)
+   {
+      result.left_shift_n = left_shift_limbs_n_sse2;
+      result.right_shift_n = right_shift_limbs_n_sse2;
+      result.and_n = bitwise_limbs_n_sse2<and_limbs_op>;
+      result.or_n = bitwise_limbs_n_sse2<or_limbs_op>;
+      result.xor_n = bitwise_limbs_n_sse2<xor_limbs_op>;
+      result.complement_n = complement_limbs_n_sse2;
+   }
+   if(features.popcnt)
+      result.popcount_n = popcount_limbs_n_popcnt;
+   if(features.avx2)
+   {
+      result.left_shift_n = left_shift_limbs_n_avx2;
+      result.right_shift_n = right_shift_limbs_n_avx2;
+      result.and_n = bitwise_limbs_n_avx2<and_limbs_op>;
+      result.or_n = bitwise_limbs_n_avx2<or_limbs_op>;
+      result.xor_n = bitwise_limbs_n_avx2<xor_limbs_op>;
+      result.complement_n = complement_limbs_n_avx2;
+      if(features.popcnt)
+         result.popcount_n = popcount_limbs_n_avx2;
+   }
+   if(features.avx512f)
+   {
+      result.left_shift_n = left_shift_limbs_n_avx512;
+      result.right_shift_n = right_shift_limbs_n_avx512;
+      result.and_n = bitwise_limbs_n_avx512<and_limbs_op>;
+      result.or_n = bitwise_limbs_n_avx512<or_limbs_op>;
+      result.xor_n = bitwise_limbs_n_avx512<xor_limbs_op>;
+      result.complement_n = complement_limbs_n_avx512;
+#ifdef BOOST_MP_HAS_AVX512_POPCNT
+      if(features.avx512vpopcntdq && features.popcnt)
+         result.popcount_n = popcount_limbs_n_avx512;
+#endif
+   }
+   return result;
+}
+//
+// Initialised on first use, which is thread safe in C++11:
+//
+inline const limb_kernels& get_limb_kernels()
+{
+   static const limb_kernels kernels = select_limb_kernels();
+   return kernels;
+}
+#endif
+
+//
+// And finally the routines which the rest of cpp_int calls:
+//
+#ifdef BOOST_MP_HAS_CPU_DISPATCH
+#define BOOST_MP_DISPATCH_LIMB_KERNEL(kernel, n, args) \
+   if(n >= dispatch_cutoff)                            \
+      return get_limb_kernels().kernel args;
+#else
+#define BOOST_MP_DISPATCH_LIMB_KERNEL(kernel, n, args)
+#endif
+
+inline limb_type add_limbs_n(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   return add_limbs_n_generic(pr, pa, pb, n);
+}
+inline limb_type subtract_limbs_n(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   return subtract_limbs_n_generic(pr, pa, pb, n);
+}
+inline limb_type multiply_limb_row(limb_type* pr, const limb_type* px, unsigned n, limb_type m) BOOST_NOEXCEPT
+{
+   return multiply_limb_row_generic(pr, px, n, m);
+}
+inline limb_type multiply_add_limb_row(limb_type* pr, const limb_type* px, unsigned n, limb_type m) BOOST_NOEXCEPT
+{
+   return multiply_add_limb_row_generic(pr, px, n, m);
+}
+inline limb_type left_shift_limbs_n(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_MP_DISPATCH_LIMB_KERNEL(left_shift_n, n, (pr, px, n, shift))
+   return left_shift_limbs_n_generic(pr, px, n, shift);
+}
+inline limb_type right_shift_limbs_n(limb_type* pr, const limb_type* px, unsigned n, unsigned shift) BOOST_NOEXCEPT
+{
+   BOOST_MP_DISPATCH_LIMB_KERNEL(right_shift_n, n, (pr, px, n, shift))
+   return right_shift_limbs_n_generic(pr, px, n, shift);
+}
+inline void and_limbs_n(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   BOOST_MP_DISPATCH_LIMB_KERNEL(and_n, n, (pr, pa, pb, n))
+   and_limbs_n_generic(pr, pa, pb, n);
+}
+inline void or_limbs_n(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   BOOST_MP_DISPATCH_LIMB_KERNEL(or_n, n, (pr, pa, pb, n))
+   or_limbs_n_generic(pr, pa, pb, n);
+}
+inline void xor_limbs_n(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned n) BOOST_NOEXCEPT
+{
+   BOOST_MP_DISPATCH_LIMB_KERNEL(xor_n, n, (pr, pa, pb, n))
+   xor_limbs_n_generic(pr, pa, pb, n);
+}
+inline void complement_limbs_n(limb_type* pr, const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   BOOST_MP_DISPATCH_LIMB_KERNEL(complement_n, n, (pr, px, n))
+   complement_limbs_n_generic(pr, px, n);
+}
+inline unsigned popcount_limbs_n(const limb_type* px, unsigned n) BOOST_NOEXCEPT
+{
+   BOOST_MP_DISPATCH_LIMB_KERNEL(popcount_n, n, (px, n))
+   return popcount_limbs_n_generic(px, n);
+}
+
+#undef BOOST_MP_DISPATCH_LIMB_KERNEL
+
+//
+// Two's complement negation in place: zero below the least significant non-zero limb, the negation
+// of that limb, and the complement of every limb above it.  Returns false if the value is zero:
+//
+inline bool negate_limbs(limb_type* pr, unsigned n) BOOST_NOEXCEPT
+{
+   unsigned k = 0;
+   while((k < n) && !pr[k])
+      ++k;
+   if(k == n)
+      return false;
+   pr[k] = static_cast<limb_type>(0u - pr[k]);
+   complement_limbs_n(pr + k + 1, pr + k + 1, n - k - 1);
+   return true;
+}
+
+//
+// In place shifts, left_shift_limbs returns the bits shifted out:
+//
+inline limb_type left_shift_limbs(limb_type* pr, unsigned rs, unsigned shift) BOOST_NOEXCEPT
+{
+   return left_shift_limbs_n(pr, pr, rs, shift);
+}
+inline void right_shift_limbs(limb_type* pr, unsigned rs, unsigned shift) BOOST_NOEXCEPT
+{
+   right_shift_limbs_n(pr, pr, rs, shift);
+}
+
+} // namespace detail
+
+}}} // namespaces
+
+#endif
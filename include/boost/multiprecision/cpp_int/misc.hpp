@@ -230,6 +230,20 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
    return eval_msb_imp(a);
 }
 
+//
+// Count the bits that are set:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value, unsigned>::type
+   eval_popcount(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a)
+{
+   if(a.sign())
+   {
+      BOOST_THROW_EXCEPTION(std::range_error("Testing individual bits in negative values is not supported - results are undefined."));
+   }
+   return detail::popcount_limbs_n(a.limbs(), a.size());
+}
+
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
 inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value, bool>::type
    eval_bit_test(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& val, unsigned index) BOOST_NOEXCEPT
@@ -315,9 +329,41 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& q,
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& r) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
+   bool s = x.sign();
    divide_unsigned_helper(&q, x, y, r);
-   q.sign(x.sign());
-   r.sign(x.sign());
+   q.sign(s);
+   r.sign(s);
+}
+
+//
+// Division by a divisor with its reciprocal precomputed, the signs follow those of the built in
+// types as above:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_qr(
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& x,
+      const divisor& d,
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& q,
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& r) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
+{
+   // Either result may be x itself, so take the sign first:
+   bool s = x.sign();
+   divide_unsigned_helper(&q, x, d, r);
+   q.sign(s);
+   r.sign(s);
+}
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_qr(
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& x,
+      const divisor& d,
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& q,
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& r)
+{
+   // A single hardware division is as good as it gets, on a copy of x since either result may be x itself:
+   const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t(x);
+   eval_qr(t, d.value(), q, r);
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, class U>
@@ -339,9 +385,11 @@ inline typename enable_if_c<is_unsigned<Integer>::value && !is_trivial_cpp_int<c
 {
    if((sizeof(Integer) <= sizeof(limb_type)) || (val <= (std::numeric_limits<limb_type>::max)()))
    {
-      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> d;
-      divide_unsigned_helper(static_cast<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>*>(0), x, static_cast<limb_type>(val), d);
-      return d.limbs()[0];
+      if(x.size() > 1)
+         return static_cast<Integer>(eval_integer_modulus(x, divisor(static_cast<limb_type>(val))));
+      if(val == 0)
+         BOOST_THROW_EXCEPTION(std::overflow_error("Integer Division by zero."));
+      return static_cast<Integer>(*x.limbs() % static_cast<limb_type>(val));
    }
    else
    {
@@ -356,6 +404,22 @@ BOOST_MP_FORCEINLINE typename enable_if_c<is_signed<Integer>::value && !is_trivi
    return eval_integer_modulus(x, boost::multiprecision::detail::unsigned_abs(val));
 }
 
+//
+// The remainder of |x| by a divisor with its reciprocal precomputed, no temporaries are needed:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value, limb_type>::type
+   eval_integer_modulus(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& x, const divisor& d) BOOST_NOEXCEPT
+{
+   return detail::divide_limbs_by_limb(0, 0, x.limbs(), x.size(), d);
+}
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value, limb_type>::type
+   eval_integer_modulus(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& x, const divisor& d) BOOST_NOEXCEPT
+{
+   return static_cast<limb_type>(*x.limbs() % d.value());
+}
+
 inline limb_type integer_gcd_reduce(limb_type u, limb_type v)
 {
    do
@@ -394,6 +458,406 @@ inline double_limb_type integer_gcd_reduce(double_limb_type u, double_limb_type
    return u;
 }
 
+//
+// The GCD of multi-limb values uses Lehmer's algorithm: the quotients of the Euclidean algorithm depend
+// mostly on the leading bits of the values, so we run it on the leading 2*limb_bits-1 bits only (held in a
+// double_limb_type), collect the quotients into a 2x2 matrix of single limb cofactors, and then apply that
+// matrix to the full values in a single pass.  Each pass removes about limb_bits bits from both values, where
+// the binary algorithm removes one or two bits per pass.
+//
+// For very large values Lehmer's algorithm is still quadratic, so above BOOST_MP_HGCD_CUTOFF limbs we use the
+// "half-GCD": the cofactor matrix which reduces a pair of n-bit values to about n/2 bits is found recursively
+// from the leading n/2 bits of the values, and then applied using the subquadratic multiplication routines.
+//
+#ifndef BOOST_MP_HGCD_CUTOFF
+#define BOOST_MP_HGCD_CUTOFF 500
+#endif
+
+static const unsigned hgcd_cutoff = BOOST_MP_HGCD_CUTOFF;
+
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_HGCD_CUTOFF >= 4, "BOOST_MP_HGCD_CUTOFF is too small for the recursion to terminate.");
+
+namespace detail{
+//
+// Returns x / y and sets x to x % y, where x >= y.  Small quotients are by far the most common, so we try
+// subtraction first:
+//
+inline double_limb_type lehmer_quotient(double_limb_type& x, double_limb_type y) BOOST_NOEXCEPT
+{
+   double_limb_type q = 1;
+   x -= y;
+   while(x >= y)
+   {
+      if(q == 4)
+      {
+         double_limb_type r = x / y;
+         x -= r * y;
+         return q + r;
+      }
+      x -= y;
+      ++q;
+   }
+   return q;
+}
+//
+// Runs the Euclidean algorithm on the leading bits x >= y of two values u >= v, both shifted right by the
+// same number of bits h.  Following Knuth Vol 2 Algorithm L, the leading bits of u/v lie between (x+1)/y and
+// x/(y+1), and each quotient is accepted only when it's the same for both of those, which guarantees that it's
+// the quotient of the full values too.  The remainders of the full values lie between those of the two bounds
+// times 2^h, and we also stop before they would drop below bound * 2^h.
+//
+// After k steps the values become u' = Au + Bv and v' = Cu + Dv, where A and D are non-negative and B and C
+// non-positive for even k, and the other way around for odd k.  |A|, |B|, |C| and |D| are stored in m, and k
+// is returned.  When even is set, k is always even:
+//
+inline unsigned lehmer_matrix(double_limb_type x, double_limb_type y, double_limb_type bound, bool even, limb_type* m) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   static const limb_type max_limb = ~static_cast<limb_type>(0u);
+   double_limb_type r0 = x + 1, r1 = y, s0 = x, s1 = y + 1, q = 0;
+   limb_type a = 1, b = 0, c = 0, d = 1;
+   unsigned k = 0;
+   while(r1)
+   {
+      double_limb_type r2 = r0;
+      double_limb_type qr = lehmer_quotient(r2, r1);
+      if(qr > max_limb)
+         break;
+      //
+      // Check that s0 / s1 is qr as well, without overflowing in the multiplication:
+      //
+      double_limb_type high = (s1 >> limb_bits) * qr;
+      if(high > max_limb)
+         break;
+      double_limb_type qs = (high << limb_bits) + static_cast<limb_type>(s1) * qr;
+      if((qs < (high << limb_bits)) || (qs > s0))
+         break;
+      double_limb_type s2 = s0 - qs;
+      if((s2 >= s1) || (r2 < bound) || (s2 < bound))
+         break;
+      double_limb_type nc = qr * c + a;
+      double_limb_type nd = qr * d + b;
+      if((nc > max_limb) || (nd > max_limb))
+         break;
+      a = c;
+      b = d;
+      c = static_cast<limb_type>(nc);
+      d = static_cast<limb_type>(nd);
+      r0 = r1;
+      r1 = r2;
+      s0 = s1;
+      s1 = s2;
+      q = qr;
+      ++k;
+   }
+   if(even && (k & 1))
+   {
+      // Undo the last step:
+      limb_type pa = static_cast<limb_type>(c - q * a);
+      limb_type pb = static_cast<limb_type>(d - q * b);
+      c = a;
+      d = b;
+      a = pa;
+      b = pb;
+      --k;
+   }
+   m[0] = a;
+   m[1] = b;
+   m[2] = c;
+   m[3] = d;
+   return k;
+}
+//
+// Applies the matrix from lehmer_matrix to the n limb values u and v in place:
+//
+inline void lehmer_apply(limb_type* pu, limb_type* pv, unsigned n, const limb_type* m, bool odd) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   limb_type carry_au = 0, carry_bv = 0, carry_cu = 0, carry_dv = 0, borrow_u = 0, borrow_v = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      double_limb_type au = static_cast<double_limb_type>(m[0]) * pu[i] + carry_au;
+      double_limb_type bv = static_cast<double_limb_type>(m[1]) * pv[i] + carry_bv;
+      double_limb_type cu = static_cast<double_limb_type>(m[2]) * pu[i] + carry_cu;
+      double_limb_type dv = static_cast<double_limb_type>(m[3]) * pv[i] + carry_dv;
+      carry_au = static_cast<limb_type>(au >> limb_bits);
+      carry_bv = static_cast<limb_type>(bv >> limb_bits);
+      carry_cu = static_cast<limb_type>(cu >> limb_bits);
+      carry_dv = static_cast<limb_type>(dv >> limb_bits);
+      //
+      // u' = |A|u - |B|v and v' = |D|v - |C|u when k is even, and the negation of both when k is odd:
+      //
+      double_limb_type t = odd ? static_cast<double_limb_type>(static_cast<limb_type>(bv)) - static_cast<limb_type>(au) - borrow_u
+                               : static_cast<double_limb_type>(static_cast<limb_type>(au)) - static_cast<limb_type>(bv) - borrow_u;
+      double_limb_type w = odd ? static_cast<double_limb_type>(static_cast<limb_type>(cu)) - static_cast<limb_type>(dv) - borrow_v
+                               : static_cast<double_limb_type>(static_cast<limb_type>(dv)) - static_cast<limb_type>(cu) - borrow_v;
+      borrow_u = (t >> limb_bits) ? 1u : 0u;
+      borrow_v = (w >> limb_bits) ? 1u : 0u;
+      pu[i] = static_cast<limb_type>(t);
+      pv[i] = static_cast<limb_type>(w);
+   }
+}
+//
+// The 2*limb_bits-1 bits starting at bit h of the n limb value p, which has no bits set above those:
+//
+inline double_limb_type lehmer_leading_bits(const limb_type* p, unsigned n, unsigned h) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   unsigned i = h / limb_bits;
+   unsigned shift = h % limb_bits;
+   double_limb_type r = p[i] | (static_cast<double_limb_type>(p[i + 1]) << limb_bits);
+   if(shift)
+   {
+      r >>= shift;
+      if(i + 2 < n)
+         r |= static_cast<double_limb_type>(p[i + 2]) << (2 * limb_bits - shift);
+   }
+   return r;
+}
+//
+// One pass of Lehmer's algorithm on the n limb values u >= v, where u has at least three limbs.  Both new
+// values are at least 2^s.  Returns the number of quotients found, with the matrix in m, or zero if no
+// quotient could be found from the leading bits, in which case u and v are unchanged:
+//
+inline unsigned lehmer_step(limb_type* pu, limb_type* pv, unsigned n, unsigned s, bool even, limb_type* m) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   BOOST_ASSERT(n >= 3);
+   unsigned h = (n - 3) * limb_bits + boost::multiprecision::detail::find_msb(pu[n - 1]) + 2;
+   double_limb_type bound = 1;
+   if(s > h)
+   {
+      if(s - h >= 2 * limb_bits - 1)
+         return 0;
+      bound = static_cast<double_limb_type>(1u) << (s - h);
+   }
+   unsigned k = lehmer_matrix(lehmer_leading_bits(pu, n, h), lehmer_leading_bits(pv, n, h), bound, even, m);
+   if(k)
+      lehmer_apply(pu, pv, n, m, k & 1);
+   return k;
+}
+//
+// The half-GCD.  For a, b > 0 with n = max(msb(a), msb(b)) + 1 and s = n/2 + 1, reduces a and b in place by
+// steps of the Euclidean algorithm until both are at least 2^s and |a - b| < 2^s.  m is set to the matrix
+// {m[0], m[1]; m[2], m[3]}, with determinant 1 and non-negative elements, which takes the new values back to
+// the originals.  Since both new values are at least 2^s, the elements of m are less than 2^(n-s), which is
+// what makes the recursion work: the matrix found for the leading bits of a and b, when applied to the full
+// values, leaves them both positive and only a little larger than the leading bits' own results.  Returns
+// false if a and b can't be reduced at all, as when one of them is already less than 2^s.
+//
+template <class Int>
+bool hgcd(Int& a, Int& b, Int* m);
+
+template <class Int>
+void hgcd_identity(Int* m)
+{
+   m[0] = static_cast<limb_type>(1u);
+   m[1] = static_cast<limb_type>(0u);
+   m[2] = static_cast<limb_type>(0u);
+   m[3] = static_cast<limb_type>(1u);
+}
+//
+// m = m * {x[0], x[1]; x[2], x[3]}, with single limb x:
+//
+template <class Int>
+void hgcd_multiply(Int* m, const limb_type* x, Int& t)
+{
+   for(unsigned i = 0; i < 4; i += 2)
+   {
+      Int m0(m[i]);
+      eval_multiply(m[i], x[0]);
+      eval_multiply(t, m[i + 1], x[2]);
+      eval_add(m[i], t);
+      eval_multiply(m[i + 1], x[3]);
+      eval_multiply(t, m0, x[1]);
+      eval_add(m[i + 1], t);
+   }
+}
+//
+// m = m * x, for the product of two half-GCD matrices:
+//
+template <class Int>
+void hgcd_multiply(Int* m, const Int* x, Int& t)
+{
+   for(unsigned i = 0; i < 4; i += 2)
+   {
+      Int m0;
+      eval_multiply(m0, m[i], x[0]);
+      eval_multiply(t, m[i + 1], x[2]);
+      eval_add(m0, t);
+      eval_multiply(t, m[i], x[1]);
+      m[i].swap(m0);
+      eval_multiply(m0, m[i + 1], x[3]);
+      eval_add(m0, t);
+      m[i + 1].swap(m0);
+   }
+}
+//
+// The half-GCD of the leading bits of a and b, starting from bit p, and then its matrix is applied to the
+// full values.  Returns false if there was nothing to do:
+//
+template <class Int>
+bool hgcd_leading(Int& a, Int& b, unsigned p, Int* m, Int& t)
+{
+   using default_ops::eval_left_shift;
+   using default_ops::eval_right_shift;
+
+   Int ha, hb, la, lb;
+   eval_right_shift(ha, a, p);
+   eval_right_shift(hb, b, p);
+   if(!hgcd(ha, hb, m))
+      return false;
+   //
+   // a = 2^p ha + la, and the new a is 2^p ha' + (m[3] la - m[1] lb), similarly for b:
+   //
+   eval_right_shift(t, a, p);
+   eval_left_shift(t, p);
+   eval_subtract(la, a, t);
+   eval_right_shift(t, b, p);
+   eval_left_shift(t, p);
+   eval_subtract(lb, b, t);
+   eval_left_shift(a, ha, p);
+   eval_multiply(t, m[3], la);
+   eval_add(a, t);
+   eval_multiply(t, m[1], lb);
+   eval_subtract(a, t);
+   eval_left_shift(b, hb, p);
+   eval_multiply(t, m[0], lb);
+   eval_add(b, t);
+   eval_multiply(t, m[2], la);
+   eval_subtract(b, t);
+   BOOST_ASSERT(!a.sign() && !b.sign());
+   return true;
+}
+
+//
+// A single step of the Euclidean algorithm, which subtracts as many multiples of the smaller of a and b from
+// the larger as it can while keeping it at least 2^s (power holds 2^s).  Returns false if there's nothing to
+// subtract:
+//
+template <class Int>
+bool hgcd_step(Int& a, Int& b, const Int& power, Int* m, Int& q, Int& t)
+{
+   using default_ops::eval_is_zero;
+
+   bool a_larger = a.compare(b) >= 0;
+   Int& u = a_larger ? a : b;
+   Int& v = a_larger ? b : a;
+   eval_subtract(t, u, power);
+   divide_unsigned_helper(&q, t, v, u);
+   eval_add(u, power);
+   if(eval_is_zero(q))
+      return false;
+   if(a_larger)
+   {
+      eval_multiply(t, q, m[0]);
+      eval_add(m[1], t);
+      eval_multiply(t, q, m[2]);
+      eval_add(m[3], t);
+   }
+   else
+   {
+      eval_multiply(t, q, m[1]);
+      eval_add(m[0], t);
+      eval_multiply(t, q, m[3]);
+      eval_add(m[2], t);
+   }
+   return true;
+}
+
+template <class Int>
+bool hgcd(Int& a, Int& b, Int* m)
+{
+   using default_ops::eval_is_zero;
+   using default_ops::eval_left_shift;
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+
+   hgcd_identity(m);
+   if(eval_is_zero(a) || eval_is_zero(b))
+      return false;
+   unsigned n = (std::max)(eval_msb_imp(a), eval_msb_imp(b)) + 1;
+   unsigned s = n / 2 + 1;
+   if((std::min)(eval_msb_imp(a), eval_msb_imp(b)) < s)
+      return false;
+
+   bool result = false;
+   Int q, t, power;
+   eval_left_shift(power, Int(static_cast<limb_type>(1u)), s);
+   if(n >= hgcd_cutoff * limb_bits)
+   {
+      //
+      // Reduce the leading half of the values by recursion, which usually brings them down to about 3n/4
+      // bits, and then the leading 2(n' - s) bits of what's left, which gets to about s bits.  If the first
+      // half didn't get far enough (as when the values start out very close together), we take single
+      // steps first, so that the second half is no larger than the first:
+      //
+      Int x[4];
+      if(hgcd_leading(a, b, n / 2, m, t))
+         result = true;
+      unsigned n2;
+      while(2 * ((n2 = (std::max)(eval_msb_imp(a), eval_msb_imp(b)) + 1) - s) > n - n / 2)
+      {
+         if(!hgcd_step(a, b, power, m, q, t))
+            return result;
+         result = true;
+      }
+      if((n2 > s + 2) && hgcd_leading(a, b, 2 * s - n2, x, t))
+      {
+         hgcd_multiply(m, x, t);
+         result = true;
+      }
+   }
+   //
+   // Now whatever remains, by Lehmer's algorithm if we can, and otherwise by single steps:
+   //
+   limb_type x[4], y[4];
+   while(true)
+   {
+      bool a_larger = a.compare(b) >= 0;
+      Int& u = a_larger ? a : b;
+      Int& v = a_larger ? b : a;
+      unsigned un = u.size();
+      if((un >= 3) && (un - v.size() < 2))
+      {
+         unsigned vn = v.size();
+         v.resize(un, un);
+         std::fill(v.limbs() + vn, v.limbs() + un, static_cast<limb_type>(0u));
+         unsigned k = lehmer_step(u.limbs(), v.limbs(), un, s, true, x);
+         u.normalize();
+         v.normalize();
+         if(k)
+         {
+            //
+            // The matrix which takes the new u and v back to the old is {|D|, |B|; |C|, |A|}:
+            //
+            if(a_larger)
+            {
+               y[0] = x[3];
+               y[1] = x[1];
+               y[2] = x[2];
+               y[3] = x[0];
+            }
+            else
+            {
+               y[0] = x[0];
+               y[1] = x[2];
+               y[2] = x[1];
+               y[3] = x[3];
+            }
+            hgcd_multiply(m, y, t);
+            result = true;
+            continue;
+         }
+      }
+      if(!hgcd_step(a, b, power, m, q, t))
+         break;
+      result = true;
+   }
+   return result;
+}
+
+} // namespace detail
+
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
 inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
    eval_gcd(
@@ -427,39 +891,20 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       return;
    }
 
-   /* Let shift := lg K, where K is the greatest power of 2
-   dividing both u and v. */
+   /* gcd(u, v) = gcd(v, u % v), and then both fit in a limb.
+   Let shift := lg K, where K is the greatest power of 2
+   dividing both of those. */
 
-   unsigned us = eval_lsb(u);
-   unsigned vs = boost::multiprecision::detail::find_lsb(v);
-   shift = (std::min)(us, vs);
-   eval_right_shift(u, us);
-   if(vs)
-      v >>= vs;
-
-   do 
+   limb_type r = eval_integer_modulus(u, v);
+   if(r == 0)
    {
-      /* Now u and v are both odd, so diff(u, v) is even.
-      Let u = min(u, v), v = diff(u, v)/2. */
-      if(u.size() <= 2)
-      {
-         if(u.size() == 1)
-            v = integer_gcd_reduce(*u.limbs(), v);
-         else
-         {
-            double_limb_type i;
-            i = u.limbs()[0] | (static_cast<double_limb_type>(u.limbs()[1]) << sizeof(limb_type) * CHAR_BIT);
-            v = static_cast<limb_type>(integer_gcd_reduce(i, static_cast<double_limb_type>(v)));
-         }
-         break;
-      }
-      eval_subtract(u, v);
-      us = eval_lsb(u);
-      eval_right_shift(u, us);
-   } 
-   while(true);
-
-   result = v;
+      result = v;
+      return;
+   }
+   unsigned rs = boost::multiprecision::detail::find_lsb(r);
+   unsigned vs = boost::multiprecision::detail::find_lsb(v);
+   shift = (std::min)(rs, vs);
+   result = integer_gcd_reduce(static_cast<limb_type>(r >> rs), static_cast<limb_type>(v >> vs));
    eval_left_shift(result, shift);
 }
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, class Integer>
@@ -505,7 +950,11 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
 
    int shift;
 
-   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> u(a), v(b);
+   //
+   // The working copies come from the workspace for types which allocate:
+   //
+   typedef typename detail::scratch_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::type int_type;
+   int_type u(a), v(b);
 
    int s = eval_get_sign(u);
 
@@ -530,7 +979,67 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       return;
    }
 
-   /* Let shift := lg K, where K is the greatest power of 2
+   /* Reduce u >= v by Lehmer's algorithm, or the half-GCD for
+   very large values, until v fits in a double limb. */
+
+   if(u.compare(v) < 0)
+      u.swap(v);
+   int_type t;
+   limb_type m[4];
+   while(v.size() > 2)
+   {
+      unsigned un = u.size();
+      if(un - v.size() < 2)
+      {
+         if(v.size() >= hgcd_cutoff)
+         {
+            typename detail::workspace_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::type x(u), y(v), xm[4];
+            if(detail::hgcd(x, y, xm))
+            {
+               u = x;
+               v = y;
+               if(u.compare(v) < 0)
+                  u.swap(v);
+               continue;
+            }
+         }
+         else
+         {
+            unsigned vn = v.size();
+            v.resize(un, un);
+            std::fill(v.limbs() + vn, v.limbs() + un, static_cast<limb_type>(0u));
+            unsigned k = detail::lehmer_step(u.limbs(), v.limbs(), un, 0, false, m);
+            u.normalize();
+            v.normalize();
+            if(k)
+               continue;
+         }
+      }
+      /* The values are too different in size for the leading bits
+      to tell us anything, so take a full step: u, v = v, u % v. */
+      eval_modulus(t, u, v);
+      u.swap(v);
+      v.swap(t);
+   }
+   if(eval_is_zero(v))
+   {
+      result = u;
+      return;
+   }
+   if(u.size() > 2)
+   {
+      eval_modulus(t, u, v);
+      u.swap(v);
+      v.swap(t);
+      if(eval_is_zero(v))
+      {
+         result = u;
+         return;
+      }
+   }
+
+   /* Finish with the binary algorithm.
+   Let shift := lg K, where K is the greatest power of 2
    dividing both u and v. */
 
    unsigned us = eval_lsb(u);
@@ -538,34 +1047,15 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
    shift = (std::min)(us, vs);
    eval_right_shift(u, us);
    eval_right_shift(v, vs);
-
-   do 
+   if((u.size() == 1) && (v.size() == 1))
+      u = integer_gcd_reduce(*u.limbs(), *v.limbs());
+   else
    {
-      /* Now u and v are both odd, so diff(u, v) is even.
-      Let u = min(u, v), v = diff(u, v)/2. */
-      s = u.compare(v);
-      if(s > 0)
-         u.swap(v);
-      if(s == 0)
-         break;
-      if(v.size() <= 2)
-      {
-         if(v.size() == 1)
-            u = integer_gcd_reduce(*v.limbs(), *u.limbs());
-         else
-         {
-            double_limb_type i, j;
-            i = v.limbs()[0] | (static_cast<double_limb_type>(v.limbs()[1]) << sizeof(limb_type) * CHAR_BIT);
-            j = (u.size() == 1) ? *u.limbs() : u.limbs()[0] | (static_cast<double_limb_type>(u.limbs()[1]) << sizeof(limb_type) * CHAR_BIT);
-            u = integer_gcd_reduce(i, j);
-         }
-         break;
-      }
-      eval_subtract(v, u);
-      vs = eval_lsb(v);
-      eval_right_shift(v, vs);
-   } 
-   while(true);
+      double_limb_type i, j;
+      i = (u.size() == 1) ? *u.limbs() : u.limbs()[0] | (static_cast<double_limb_type>(u.limbs()[1]) << sizeof(limb_type) * CHAR_BIT);
+      j = (v.size() == 1) ? *v.limbs() : v.limbs()[0] | (static_cast<double_limb_type>(v.limbs()[1]) << sizeof(limb_type) * CHAR_BIT);
+      u = integer_gcd_reduce(i, j);
+   }
 
    result = u;
    eval_left_shift(result, shift);
@@ -588,6 +1078,303 @@ BOOST_MP_FORCEINLINE typename enable_if_c<is_trivial_cpp_int<cpp_int_backend<Min
    result.normalize(); // result may overflow the specified number of bits
 }
 
+//
+// Extended GCD and modular inverse.
+//
+// These run the same Lehmer's algorithm as eval_gcd above on u = |a| and v = |b|, and carry the cofactors
+// of a (and optionally b) alongside.  The cofactors of the Euclidean algorithm alternate in sign, so we keep
+// just their magnitudes along with the parity of the number of steps taken, and then both the Lehmer matrix
+// and the full quotient steps only ever add to them.  All the updates are done in place, and the cofactors
+// never exceed max(|a|, |b|), so for fixed precision types everything stays on the stack, and for allocating
+// types the storage is allocated once up front:
+//
+namespace detail{
+//
+// Applies the matrix from lehmer_matrix to the n limb cofactor magnitudes x and y: x' = |A|x + |B|y and
+// y' = |C|x + |D|y, the parts of the results above n limbs are returned in top:
+//
+inline void lehmer_apply_cofactors(limb_type* px, limb_type* py, unsigned n, const limb_type* m, double_limb_type* top) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   limb_type carry_ax = 0, carry_by = 0, carry_cx = 0, carry_dy = 0, carry_x = 0, carry_y = 0;
+   for(unsigned i = 0; i < n; ++i)
+   {
+      double_limb_type ax = static_cast<double_limb_type>(m[0]) * px[i] + carry_ax;
+      double_limb_type by = static_cast<double_limb_type>(m[1]) * py[i] + carry_by;
+      double_limb_type cx = static_cast<double_limb_type>(m[2]) * px[i] + carry_cx;
+      double_limb_type dy = static_cast<double_limb_type>(m[3]) * py[i] + carry_dy;
+      carry_ax = static_cast<limb_type>(ax >> limb_bits);
+      carry_by = static_cast<limb_type>(by >> limb_bits);
+      carry_cx = static_cast<limb_type>(cx >> limb_bits);
+      carry_dy = static_cast<limb_type>(dy >> limb_bits);
+      double_limb_type t = static_cast<double_limb_type>(static_cast<limb_type>(ax)) + static_cast<limb_type>(by) + carry_x;
+      double_limb_type w = static_cast<double_limb_type>(static_cast<limb_type>(cx)) + static_cast<limb_type>(dy) + carry_y;
+      carry_x = static_cast<limb_type>(t >> limb_bits);
+      carry_y = static_cast<limb_type>(w >> limb_bits);
+      px[i] = static_cast<limb_type>(t);
+      py[i] = static_cast<limb_type>(w);
+   }
+   top[0] = static_cast<double_limb_type>(carry_ax) + carry_by + carry_x;
+   top[1] = static_cast<double_limb_type>(carry_cx) + carry_dy + carry_y;
+}
+
+template <class CppInt>
+void gcdext_store_top(CppInt& x, unsigned n, double_limb_type top)
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   // Fixed precision types may not have room for the top, but it's zero when they don't:
+   if(x.size() > n)
+      x.limbs()[n] = static_cast<limb_type>(top);
+   if(x.size() > n + 1)
+      x.limbs()[n + 1] = static_cast<limb_type>(top >> limb_bits);
+   BOOST_ASSERT((x.size() > n + 1) || !(top >> ((x.size() > n) ? limb_bits : 0)));
+   x.normalize();
+}
+
+template <class CppInt>
+void gcdext_pad(CppInt& x, unsigned n)
+{
+   unsigned xs = x.size();
+   x.resize(n, xs);
+   std::fill(x.limbs() + xs, x.limbs() + x.size(), static_cast<limb_type>(0u));
+}
+//
+// x, y = y, x + q * y after a full quotient step, where q is either a single limb or the multi-limb q:
+//
+template <class CppInt>
+void gcdext_cofactor_step(CppInt& x, CppInt& y, limb_type q)
+{
+   unsigned n = (std::max)(x.size(), y.size());
+   gcdext_pad(x, n + 1);
+   limb_type carry = multiply_add_limbs(x.limbs(), n, y.limbs(), y.size(), q);
+   gcdext_store_top(x, n, carry);
+   x.swap(y);
+}
+template <class CppInt>
+void gcdext_cofactor_step(CppInt& x, CppInt& y, const CppInt& q, CppInt& t)
+{
+   if(q.size() == 1)
+      gcdext_cofactor_step(x, y, *q.limbs());
+   else
+   {
+      eval_multiply(t, y, q);
+      eval_add(x, t);
+      x.swap(y);
+   }
+}
+
+template <class CppInt>
+void gcdext_cofactor_update(CppInt& x, CppInt& y, const limb_type* m)
+{
+   unsigned n = (std::max)(x.size(), y.size());
+   double_limb_type top[2];
+   gcdext_pad(x, n + 2);
+   gcdext_pad(y, n + 2);
+   lehmer_apply_cofactors(x.limbs(), y.limbs(), n, m, top);
+   gcdext_store_top(x, n, top[0]);
+   gcdext_store_top(y, n, top[1]);
+}
+//
+// Runs the Euclidean algorithm on u >= v >= 0, updating the cofactor magnitudes in (x, y) and, when present,
+// (z, w).  On exit u is the gcd and v is zero, and the result is true when an odd number of steps were taken.
+// q, r and t are temporaries:
+//
+template <class CppInt>
+bool gcdext_reduce(CppInt& u, CppInt& v, CppInt& x, CppInt& y, CppInt* z, CppInt* w, CppInt& q, CppInt& r, CppInt& t)
+{
+   using default_ops::eval_is_zero;
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+
+   limb_type m[4];
+   bool odd = false;
+   while((u.size() > 2) && !eval_is_zero(v))
+   {
+      unsigned un = u.size();
+      if(un - v.size() < 2)
+      {
+         gcdext_pad(v, un);
+         unsigned k = lehmer_step(u.limbs(), v.limbs(), un, 0, false, m);
+         u.normalize();
+         v.normalize();
+         if(k)
+         {
+            gcdext_cofactor_update(x, y, m);
+            if(z)
+               gcdext_cofactor_update(*z, *w, m);
+            if(k & 1)
+               odd = !odd;
+            continue;
+         }
+      }
+      divide_unsigned_helper(&q, u, v, r);
+      u.swap(v);
+      v.swap(r);
+      gcdext_cofactor_step(x, y, q, t);
+      if(z)
+         gcdext_cofactor_step(*z, *w, q, t);
+      odd = !odd;
+   }
+   //
+   // Finish on double limbs, still collecting as many quotients as we can into each matrix, and dropping
+   // the top bit if necessary so that lehmer_matrix can add one to the values.  The new values fit in
+   // a double limb, so the wrapping arithmetic gets them right:
+   //
+   double_limb_type i = (u.size() == 1) ? *u.limbs() : u.limbs()[0] | (static_cast<double_limb_type>(u.limbs()[1]) << limb_bits);
+   double_limb_type j = (v.size() == 1) ? *v.limbs() : v.limbs()[0] | (static_cast<double_limb_type>(v.limbs()[1]) << limb_bits);
+   if(u.size() > 2)
+      j = 0;
+   while(j)
+   {
+      unsigned h = (i >> (2 * limb_bits - 1)) ? 1 : 0;
+      unsigned k = lehmer_matrix(i >> h, j >> h, 1, false, m);
+      if(k)
+      {
+         double_limb_type ni = static_cast<double_limb_type>(m[0]) * i - static_cast<double_limb_type>(m[1]) * j;
+         double_limb_type nj = static_cast<double_limb_type>(m[3]) * j - static_cast<double_limb_type>(m[2]) * i;
+         i = (k & 1) ? static_cast<double_limb_type>(0u - ni) : ni;
+         j = (k & 1) ? static_cast<double_limb_type>(0u - nj) : nj;
+         gcdext_cofactor_update(x, y, m);
+         if(z)
+            gcdext_cofactor_update(*z, *w, m);
+         if(k & 1)
+            odd = !odd;
+         continue;
+      }
+      double_limb_type qd = i / j;
+      double_limb_type rd = i - qd * j;
+      i = j;
+      j = rd;
+      if(qd >> limb_bits)
+      {
+         q = qd;
+         gcdext_cofactor_step(x, y, q, t);
+         if(z)
+            gcdext_cofactor_step(*z, *w, q, t);
+      }
+      else
+      {
+         gcdext_cofactor_step(x, y, static_cast<limb_type>(qd));
+         if(z)
+            gcdext_cofactor_step(*z, *w, static_cast<limb_type>(qd));
+      }
+      odd = !odd;
+   }
+   if(u.size() <= 2)
+   {
+      u = i;
+      v = static_cast<limb_type>(0u);
+   }
+   return odd;
+}
+template <class CppInt>
+bool gcdext_reduce(CppInt& u, CppInt& v, CppInt& x, CppInt& y, CppInt* z, CppInt* w)
+{
+   CppInt q, r, t;
+   return gcdext_reduce(u, v, x, y, z, w, q, r, t);
+}
+//
+// x = v^-1 mod m for 0 <= v < m, throws if there is no inverse.  Only the cofactors of v are needed, after
+// k steps 1 = (-1)^(k+1) |x| v (mod m).  The other arguments are temporaries, and v is destroyed, so that
+// callers which keep them from one call to the next need allocate nothing:
+//
+template <class CppInt>
+void inverse_mod_reduced(CppInt& x, CppInt& v, const CppInt& m, CppInt& u, CppInt& y, CppInt& q, CppInt& r, CppInt& t)
+{
+   using default_ops::eval_is_zero;
+
+   u = m;
+   unsigned n = u.size() + 2;
+   gcdext_pad(x, n);
+   gcdext_pad(y, n);
+   x = static_cast<limb_type>(0u);
+   y = static_cast<limb_type>(1u);
+   bool odd = gcdext_reduce(u, v, x, y, static_cast<CppInt*>(0), static_cast<CppInt*>(0), q, r, t);
+   if((u.size() != 1) || (*u.limbs() != 1))
+      BOOST_THROW_EXCEPTION(std::domain_error("The value has no inverse with respect to the modulus."));
+   if(!odd && !eval_is_zero(x))
+      eval_subtract(x, m, x);
+}
+
+} // namespace detail
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_gcdext(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& g, 
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& s, 
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& t, 
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a, 
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& b)
+{
+   using default_ops::eval_get_sign;
+   using default_ops::eval_is_zero;
+
+   typedef cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> int_type;
+
+   bool a_neg = eval_get_sign(a) < 0;
+   bool b_neg = eval_get_sign(b) < 0;
+   int_type u(a), v(b), su, sv, tu, tv;
+   if(a_neg)
+      u.negate();
+   if(b_neg)
+      v.negate();
+   unsigned n = (std::max)(u.size(), v.size()) + 2;
+   detail::gcdext_pad(su, n);
+   detail::gcdext_pad(sv, n);
+   detail::gcdext_pad(tu, n);
+   detail::gcdext_pad(tv, n);
+   su = static_cast<limb_type>(1u);
+   sv = static_cast<limb_type>(0u);
+   tu = static_cast<limb_type>(0u);
+   tv = static_cast<limb_type>(1u);
+   //
+   // If |a| < |b| then the first step of the Euclidean algorithm just swaps them:
+   //
+   bool odd = false;
+   if(u.compare(v) < 0)
+   {
+      u.swap(v);
+      su.swap(sv);
+      tu.swap(tv);
+      odd = true;
+   }
+   if(detail::gcdext_reduce(u, v, su, sv, &tu, &tv))
+      odd = !odd;
+   if(eval_is_zero(u))
+      su = static_cast<limb_type>(0u);  // a = b = 0
+   //
+   // Now gcd(a, b) = u = (-1)^k |su| |a| + (-1)^(k+1) |tu| |b| after k steps:
+   //
+   g.swap(u);
+   s.swap(su);
+   t.swap(tu);
+   if(odd != a_neg)
+      s.negate();
+   if(odd == b_neg)
+      t.negate();
+}
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_inverse_mod(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a, 
+      const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& m)
+{
+   using default_ops::eval_get_sign;
+
+   typedef cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> int_type;
+
+   if(eval_get_sign(m) <= 0)
+      BOOST_THROW_EXCEPTION(std::domain_error("The modulus must be positive."));
+   int_type u, v, x, y, q, r, t;
+   eval_modulus(v, a, m);
+   if(eval_get_sign(v) < 0)
+      eval_add(v, m);
+   detail::inverse_mod_reduced(x, v, m, u, y, q, r, t);
+   result.swap(x);
+}
+
 inline void conversion_overflow(const mpl::int_<checked>&)
 {
    BOOST_THROW_EXCEPTION(std::overflow_error("Overflow in conversion to narrower type"));
@@ -692,6 +1479,21 @@ inline typename enable_if_c<is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits
    return eval_msb_imp(a);
 }
 
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value, unsigned>::type
+   eval_popcount(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a)
+{
+   if(a.sign())
+   {
+      BOOST_THROW_EXCEPTION(std::range_error("Testing individual bits in negative values is not supported - results are undefined."));
+   }
+   typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::local_limb_type v = *a.limbs();
+   unsigned result = 0;
+   for(; v; v &= v - 1)
+      ++result;
+   return result;
+}
+
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
 inline std::size_t hash_value(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& val) BOOST_NOEXCEPT
 {
@@ -704,10 +1506,27 @@ inline std::size_t hash_value(const cpp_int_backend<MinBits1, MaxBits1, SignType
    return result;
 }
 
+} // namespace backends
+
+//
+// Division by a divisor, for dividing many values by the same single limb value:
+//
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator, expression_template_option ExpressionTemplates>
+inline void divide_qr(const number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>& x, const divisor& d,
+   number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>& q, number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>& r)
+{
+   backends::eval_qr(x.backend(), d, q.backend(), r.backend());
+}
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator, expression_template_option ExpressionTemplates>
+inline limb_type integer_modulus(const number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>& x, const divisor& d)
+{
+   return backends::eval_integer_modulus(x.backend(), d);
+}
+
 #ifdef BOOST_MSVC
 #pragma warning(pop)
 #endif
 
-}}} // namespaces
+}} // namespaces
 
 #endif
@@ -0,0 +1,321 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+//
+// Modular exponentiation for cpp_int_backend, using Montgomery multiplication:
+//
+#ifndef BOOST_MP_CPP_INT_MONTGOMERY_HPP
+#define BOOST_MP_CPP_INT_MONTGOMERY_HPP
+
+#include <boost/multiprecision/detail/bitscan.hpp> // find_msb
+
+#ifdef BOOST_MSVC
+#pragma warning(push)
+#pragma warning(disable:4127) // conditional expression is constant
+#endif
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+//
+// For an odd modulus n of k limbs, let R = 2^(k * limb_bits).  Values are held in "Montgomery form"
+// x' = xR mod n, and the product of two such values is reduced by computing x'y'/R mod n, which
+// needs only multiplications by the modulus and shifts, rather than the division that eval_modulus
+// does after every step of the generic eval_powm.  The exponent is scanned from the most significant
+// end in windows of up to 6 bits, each starting and ending with a 1 bit, so that we only need a table
+// of the odd powers of the base.
+//
+// The reduction is by long multiplication, so that for large moduli the generic algorithm, which
+// gets to use the subquadratic multiplication and division routines throughout, wins eventually.
+// Moduli of at least this many limbs use the generic code:
+//
+#ifndef BOOST_MP_MONTGOMERY_CUTOFF
+#define BOOST_MP_MONTGOMERY_CUTOFF 400
+#endif
+
+static const unsigned montgomery_cutoff = BOOST_MP_MONTGOMERY_CUTOFF;
+
+namespace detail{
+//
+// -1/n mod 2^limb_bits for odd n, by Newton iteration: n is its own inverse to 3 bits, and each
+// step doubles the number of bits which are correct:
+//
+inline limb_type montgomery_inverse(limb_type n) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(n & 1u);
+   limb_type x = n;
+   for(unsigned bits = 3; bits < sizeof(limb_type) * CHAR_BIT; bits *= 2)
+      x *= static_cast<limb_type>(2u - n * x);
+   return static_cast<limb_type>(0u - x);
+}
+//
+// r = t/R mod n, where t has 2k limbs and is less than nR.  t is overwritten, and r has k limbs
+// and may alias anything other than t:
+//
+inline void montgomery_reduce(limb_type* pr, limb_type* pt, const limb_type* pn, unsigned k, limb_type inv) BOOST_NOEXCEPT
+{
+   limb_type carry = 0;
+   for(unsigned i = 0; i < k; ++i)
+      carry += multiply_add_limbs(pt + i, 2 * k - i, pn, k, static_cast<limb_type>(pt[i] * inv));
+   //
+   // The sum is now less than 2nR, so at most one subtraction of n is needed:
+   //
+   if(carry || (compare_limbs(pt + k, k, pn, k) >= 0))
+      subtract_limbs(pr, pt + k, k, pn, k);
+   else
+      std::copy(pt + k, pt + 2 * k, pr);
+}
+//
+// Temporary storage needed by montgomery_multiply for a modulus of k limbs:
+//
+inline std::size_t montgomery_multiply_storage_size(unsigned k) BOOST_NOEXCEPT
+{
+   return 2 * static_cast<std::size_t>(k) + multiply_storage_size(k);
+}
+//
+// r = ab/R mod n, where a, b < n all have k limbs and r may alias a or b.  Passing the same pointer
+// for a and b gets the faster squaring:
+//
+inline void montgomery_multiply(limb_type* pr, const limb_type* pa, const limb_type* pb, const limb_type* pn, unsigned k, limb_type inv, limb_type* storage) BOOST_NOEXCEPT
+{
+   multiply_recursive(storage, pa, k, pb, k, storage + 2 * k);
+   montgomery_reduce(pr, storage, pn, k, inv);
+}
+//
+// Temporary storage needed by montgomery_convert for a value of as limbs and a modulus of k limbs:
+//
+inline std::size_t montgomery_convert_storage_size(unsigned as, unsigned k) BOOST_NOEXCEPT
+{
+   return 2 * static_cast<std::size_t>(as) + 2 * k + 2;
+}
+//
+// r = aR mod n, by long division of a shifted left k limbs:
+//
+inline void montgomery_convert(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pn, unsigned k, limb_type* storage) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   if(k == 1)
+   {
+      double_limb_type r = 0;
+      for(unsigned i = as; i-- > 0;)
+         r = ((r << limb_bits) | pa[i]) % pn[0];
+      pr[0] = static_cast<limb_type>((r << limb_bits) % pn[0]);
+      return;
+   }
+   //
+   // Normalise so that the divisor has its top bit set, the numerator gets an extra zero limb
+   // at the top so that the quotient fits in as + 1 limbs:
+   //
+   unsigned shift = limb_bits - 1 - boost::multiprecision::detail::find_msb(pn[k - 1]);
+   limb_type* pd = storage;
+   limb_type* pu = pd + k;
+   limb_type* pq = pu + as + k + 1;
+   std::copy(pn, pn + k, pd);
+   std::fill(pu, pu + k, static_cast<limb_type>(0u));
+   std::copy(pa, pa + as, pu + k);
+   pu[as + k] = 0;
+   if(shift)
+   {
+      left_shift_limbs(pd, k, shift);
+      left_shift_limbs(pu + k, as + 1, shift);
+   }
+   limb_type qh = divide_schoolbook(pq, pu, as + k + 1, pd, k);
+   BOOST_ASSERT(!qh);
+   (void)qh;
+   if(shift)
+      right_shift_limbs(pu, k, shift);
+   std::copy(pu, pu + k, pr);
+}
+//
+// Size of the window used for an exponent of the given number of bits: larger windows mean fewer
+// multiplications during the scan, but more to build the table, the breakpoints are the usual ones:
+//
+inline unsigned montgomery_window_size(std::size_t bits) BOOST_NOEXCEPT
+{
+   return bits > 671 ? 6 : bits > 239 ? 5 : bits > 79 ? 4 : bits > 23 ? 3 : 1;
+}
+static const unsigned montgomery_max_window_size = 6;
+//
+// Temporary storage needed by montgomery_powm for a modulus of k limbs and a window of w bits:
+//
+inline std::size_t montgomery_powm_storage_size(unsigned k, unsigned w) BOOST_NOEXCEPT
+{
+   return (static_cast<std::size_t>(1u) << (w - 1)) * k + montgomery_multiply_storage_size(k);
+}
+//
+// r = a^p in Montgomery form, where a < n is also in Montgomery form, p has ps limbs and is non-zero.
+// r has k limbs and may not alias a or p:
+//
+inline void montgomery_powm(limb_type* pr, const limb_type* pa, const limb_type* pp, unsigned ps, const limb_type* pn, unsigned k, limb_type inv, limb_type* storage) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   while(!pp[ps - 1])
+      --ps;
+   std::size_t bits = static_cast<std::size_t>(ps - 1) * limb_bits + boost::multiprecision::detail::find_msb(pp[ps - 1]) + 1;
+   unsigned w = montgomery_window_size(bits);
+   //
+   // Odd powers a, a^3, a^5 ... go in the table, using r to hold a^2 meanwhile:
+   //
+   limb_type* table = storage;
+   storage += static_cast<std::size_t>(k) << (w - 1);
+   std::copy(pa, pa + k, table);
+   if(w > 1)
+   {
+      montgomery_multiply(pr, pa, pa, pn, k, inv, storage);
+      for(unsigned i = 1; i < (1u << (w - 1)); ++i)
+         montgomery_multiply(table + i * k, table + (i - 1) * k, pr, pn, k, inv, storage);
+   }
+   bool first = true;
+   std::size_t i = bits;
+   while(i)
+   {
+      // Bit i - 1 is next:
+      --i;
+      if(!((pp[i / limb_bits] >> (i % limb_bits)) & 1u))
+      {
+         montgomery_multiply(pr, pr, pr, pn, k, inv, storage);
+         continue;
+      }
+      //
+      // The window is bits [j, i] with bit j set:
+      //
+      std::size_t j = i >= w - 1 ? i - (w - 1) : 0;
+      while(!((pp[j / limb_bits] >> (j % limb_bits)) & 1u))
+         ++j;
+      unsigned value = 0;
+      for(std::size_t b = i + 1; b-- > j;)
+      {
+         value = (value << 1) | static_cast<unsigned>((pp[b / limb_bits] >> (b % limb_bits)) & 1u);
+         if(!first)
+            montgomery_multiply(pr, pr, pr, pn, k, inv, storage);
+      }
+      if(first)
+      {
+         std::copy(table + (value >> 1) * k, table + (value >> 1) * k + k, pr);
+         first = false;
+      }
+      else
+         montgomery_multiply(pr, pr, table + (value >> 1) * k, pn, k, inv, storage);
+      i = j;
+   }
+}
+//
+// Storage needed by montgomery_powm_limbs, and the same again as a compile time constant for a
+// modulus of K limbs and all the operands no larger, where the table is always larger than what
+// the conversion needs:
+//
+inline std::size_t montgomery_powm_limbs_storage_size(unsigned as, unsigned k, std::size_t ps) BOOST_NOEXCEPT
+{
+   std::size_t bits = ps * sizeof(limb_type) * CHAR_BIT;
+   return 2 * static_cast<std::size_t>(k) + (std::max)(montgomery_convert_storage_size(as, k), montgomery_powm_storage_size(k, montgomery_window_size(bits)));
+}
+template <unsigned K>
+struct montgomery_powm_limbs_storage_size_c
+{
+   BOOST_STATIC_CONSTANT(unsigned, value = 2 * K + (1u << (montgomery_max_window_size - 1)) * K + 2 * K + multiply_storage_size_c<K>::value);
+};
+//
+// r = a^p mod n of k limbs, where n is odd and p is non-zero:
+//
+inline void montgomery_powm_limbs(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pp, unsigned ps, const limb_type* pn, unsigned k, limb_type* storage) BOOST_NOEXCEPT
+{
+   limb_type inv = montgomery_inverse(pn[0]);
+   limb_type* x = storage;
+   limb_type* y = x + k;
+   storage = y + k;
+   montgomery_convert(x, pa, as, pn, k, storage);
+   montgomery_powm(y, x, pp, ps, pn, k, inv, storage);
+   // Out of Montgomery form by a reduction of y on its own:
+   std::copy(y, y + k, storage);
+   std::fill(storage + k, storage + 2 * k, static_cast<limb_type>(0u));
+   montgomery_reduce(pr, storage, pn, k, inv);
+}
+
+} // namespace detail
+
+//
+// Temporary storage for the above, on the heap for types with an allocator, and on the stack for
+// fixed precision types:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline void montgomery_powm(limb_type* pr, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& p, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& c)
+{
+   detail::scoped_limb_storage<typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::allocator_type> storage(a.allocator(), detail::montgomery_powm_limbs_storage_size(a.size(), c.size(), p.size()));
+   detail::montgomery_powm_limbs(pr, a.limbs(), a.size(), p.limbs(), p.size(), c.limbs(), c.size(), storage.data());
+}
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1>
+inline void montgomery_powm(limb_type* pr, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>& a, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>& p, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>& c) BOOST_NOEXCEPT
+{
+   static const unsigned internal_limb_count = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>::internal_limb_count;
+   limb_type storage[detail::montgomery_powm_limbs_storage_size_c<internal_limb_count>::value];
+   BOOST_ASSERT(detail::montgomery_powm_limbs_storage_size(a.size(), c.size(), p.size()) <= sizeof(storage) / sizeof(storage[0]));
+   detail::montgomery_powm_limbs(pr, a.limbs(), a.size(), p.limbs(), p.size(), c.limbs(), c.size(), storage);
+}
+//
+// Whether to use the code above: fixed precision types keep everything on the stack, so we limit
+// those to moduli of at most 8192 bits, and they must be odd and not so large that the generic
+// version is faster.  The generic version also deals with the error cases:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline bool use_montgomery_powm(const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& p, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& c)
+{
+   static const bool fits = !is_void<Allocator1>::value || (cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::internal_limb_count * sizeof(limb_type) * CHAR_BIT <= 8192);
+   return fits && (c.limbs()[0] & 1u) && (c.size() < montgomery_cutoff) && !p.sign() && (p.size() > 1 || p.limbs()[0]);
+}
+//
+// Calculate (a^p)%c, the sign of the result follows that of a^p, exactly as for the generic version:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_powm(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& p, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& c)
+{
+   if(!use_montgomery_powm(p, c))
+   {
+      default_ops::eval_powm(result, a, p, c);
+      return;
+   }
+   bool negative = a.sign() && (p.limbs()[0] & 1u);
+   if((&result != &a) && (&result != &p) && (&result != &c))
+   {
+      result.resize(c.size(), c.size());
+      montgomery_powm(result.limbs(), a, p, c);
+      result.normalize();
+      result.sign(negative && !eval_is_zero(result));
+      return;
+   }
+   //
+   // result aliases one of the arguments, so the value is built up in a temporary:
+   //
+   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t;
+   t.resize(c.size(), c.size());
+   montgomery_powm(t.limbs(), a, p, c);
+   t.normalize();
+   t.sign(negative && !eval_is_zero(t));
+   result.swap(t);
+}
+//
+// Unsigned exponents of built in type are converted, since they're large enough for the windowed
+// exponentiation to pay off:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, class Integer>
+inline typename enable_if_c<is_unsigned<Integer>::value && !is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value>::type
+   eval_powm(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& a, Integer p, const cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& c)
+{
+   if(!(c.limbs()[0] & 1u) || (c.size() >= montgomery_cutoff))
+   {
+      default_ops::eval_powm(result, a, p, c);
+      return;
+   }
+   typedef typename boost::multiprecision::detail::canonical<Integer, cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::type ui_type;
+   cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t;
+   t = static_cast<ui_type>(p);
+   eval_powm(result, a, t, c);
+}
+
+}}} // namespaces
+
+#ifdef BOOST_MSVC
+#pragma warning(pop)
+#endif
+
+#endif
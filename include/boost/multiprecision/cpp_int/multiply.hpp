@@ -14,8 +14,8 @@ namespace boost{ namespace multiprecision{ namespace backends{
 #pragma warning(push)
 #pragma warning(disable:4127) // conditional expression is constant
 #endif
-   
-   template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
 inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
    eval_multiply(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
@@ -29,27 +29,13 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
    }
    if((void*)&a != (void*)&result)
       result.resize(a.size(), a.size());
-   double_limb_type carry = 0;
-   typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_pointer p = result.limbs();
-   typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_pointer pe = result.limbs() + result.size();
-   typename cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>::const_limb_pointer pa = a.limbs();
-   while(p != pe)
-   {
-      carry += static_cast<double_limb_type>(*pa) * static_cast<double_limb_type>(val);
-#ifdef __MSVC_RUNTIME_CHECKS
-      *p = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-      *p = static_cast<limb_type>(carry);
-#endif
-      carry >>= cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits;
-      ++p, ++pa;
-   }
+   limb_type carry = detail::multiply_limb_row(result.limbs(), a.limbs(), result.size(), val);
    if(carry)
    {
       unsigned i = result.size();
       result.resize(i + 1, i + 1);
       if(result.size() > i)
-         result.limbs()[i] = static_cast<limb_type>(carry);
+         result.limbs()[i] = carry;
    }
    result.sign(a.sign());
    if(!cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::variable)
@@ -71,18 +57,1285 @@ inline void resize_for_carry(cpp_int_backend<MinBits1, MaxBits1, SignType1, chec
       result.resize(required, required);
 }
 
+//
+// Multiplication of large values:
+//
+// Once both operands reach BOOST_MP_KARATSUBA_CUTOFF limbs we switch from long multiplication
+// to Karatsuba multiplication, which splits each value into 2 parts and forms the product
+// from 3 half sized multiplications rather than 4.  Larger values still use Toom-Cook
+// multiplication, which splits each value into 3 (or 4) parts and forms the product from 5 (or 7)
+// multiplications of one third (or one quarter) the size.  Finally for huge values in types
+// which can allocate memory we use a number theoretic transform (an FFT in modular arithmetic)
+// which takes O(N log N) time.  The cutoffs are expressed in limbs of the smaller operand, and the
+// best values depend on the platform: they may be changed by defining the macros below before
+// including this header.
+//
+#ifndef BOOST_MP_KARATSUBA_CUTOFF
+#define BOOST_MP_KARATSUBA_CUTOFF 40
+#endif
+#ifndef BOOST_MP_TOOM3_CUTOFF
+#define BOOST_MP_TOOM3_CUTOFF 120
+#endif
+#ifndef BOOST_MP_TOOM4_CUTOFF
+#define BOOST_MP_TOOM4_CUTOFF 400
+#endif
+#ifndef BOOST_MP_NTT_CUTOFF
+#define BOOST_MP_NTT_CUTOFF 1500
+#endif
+
+static const unsigned karatsuba_cutoff = BOOST_MP_KARATSUBA_CUTOFF;
+static const unsigned toom3_cutoff = BOOST_MP_TOOM3_CUTOFF;
+static const unsigned toom4_cutoff = BOOST_MP_TOOM4_CUTOFF;
+static const unsigned ntt_cutoff = BOOST_MP_NTT_CUTOFF;
+
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_KARATSUBA_CUTOFF >= 4, "BOOST_MP_KARATSUBA_CUTOFF is too small for the recursion to terminate.");
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_TOOM3_CUTOFF >= 16, "BOOST_MP_TOOM3_CUTOFF is too small for the recursion to terminate.");
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_TOOM4_CUTOFF >= 16, "BOOST_MP_TOOM4_CUTOFF is too small for the recursion to terminate.");
+
+namespace detail{
+
+//
+// The routines in this section operate on raw limb arrays, it's up to the caller
+// to make sure that the destination has room for the result.
+//
+// Compares a and b, either of which may have leading zero limbs:
+//
+inline int compare_limbs(const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   for(; as > bs; --as)
+      if(pa[as - 1])
+         return 1;
+   for(; bs > as; --bs)
+      if(pb[bs - 1])
+         return -1;
+   while(as)
+   {
+      --as;
+      if(pa[as] != pb[as])
+         return pa[as] > pb[as] ? 1 : -1;
+   }
+   return 0;
+}
+//
+// r = a + b, requires as >= bs, r has as limbs and may alias a or b, returns the carry:
+//
+inline limb_type add_limbs(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(as >= bs);
+   limb_type carry = add_limbs_n(pr, pa, pb, bs);
+   unsigned i = bs;
+   for(; carry && (i < as); ++i)
+   {
+      pr[i] = pa[i] + carry;
+      carry = pr[i] < carry;
+   }
+   if(pr != pa)
+      std::copy(pa + i, pa + as, pr + i);
+   return carry;
+}
+//
+// r = a - b, requires as >= bs, r has as limbs and may alias a or b, returns the borrow:
+//
+inline limb_type subtract_limbs(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(as >= bs);
+   limb_type borrow = subtract_limbs_n(pr, pa, pb, bs);
+   unsigned i = bs;
+   for(; borrow && (i < as); ++i)
+   {
+      borrow = pa[i] < borrow;
+      pr[i] = pa[i] - 1;
+   }
+   if(pr != pa)
+      std::copy(pa + i, pa + as, pr + i);
+   return borrow;
+}
+//
+// r = |a - b|, r has max(as, bs) limbs and may alias a or b, returns true if a < b:
+//
+inline bool abs_difference_limbs(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   unsigned rs = (std::max)(as, bs);
+   bool s = compare_limbs(pa, as, pb, bs) < 0;
+   if(s)
+   {
+      std::swap(pa, pb);
+      std::swap(as, bs);
+   }
+   // a >= b so any extra high limbs in b must be zero:
+   while(bs > as)
+      --bs;
+   subtract_limbs(pr, pa, as, pb, bs);
+   std::fill(pr + as, pr + rs, static_cast<limb_type>(0u));
+   return s;
+}
+//
+// r += x * m, requires rs >= xs, returns the carry out of r:
+//
+inline limb_type multiply_add_limbs(limb_type* pr, unsigned rs, const limb_type* px, unsigned xs, limb_type m) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(rs >= xs);
+   limb_type carry = multiply_add_limb_row(pr, px, xs, m);
+   for(unsigned i = xs; carry && (i < rs); ++i)
+   {
+      pr[i] += carry;
+      carry = pr[i] < carry;
+   }
+   return carry;
+}
+//
+// r -= x * m, requires rs >= xs, returns the borrow out of r:
+//
+inline limb_type multiply_subtract_limbs(limb_type* pr, unsigned rs, const limb_type* px, unsigned xs, limb_type m) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(rs >= xs);
+   double_limb_type carry = 0;
+   unsigned i = 0;
+   for(; i < xs; ++i)
+   {
+      carry += static_cast<double_limb_type>(px[i]) * static_cast<double_limb_type>(m);
+      limb_type l = static_cast<limb_type>(carry);
+      carry >>= sizeof(limb_type) * CHAR_BIT;
+      if(pr[i] < l)
+         ++carry;
+      pr[i] -= l;
+   }
+   for(; carry && (i < rs); ++i)
+   {
+      limb_type l = static_cast<limb_type>(carry);
+      carry >>= sizeof(limb_type) * CHAR_BIT;
+      if(pr[i] < l)
+         ++carry;
+      pr[i] -= l;
+   }
+   return static_cast<limb_type>(carry);
+}
+//
+// r /= d in place, where d is odd and known to divide r exactly.  Rather than dividing
+// we multiply by the inverse of d modulo 2^limb_bits, working up from the least significant limb:
+//
+inline void divide_exact_limbs(limb_type* pr, unsigned rs, limb_type d) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(d & 1u);
+   // Newton iteration for the inverse, d is its own inverse to 3 bits, and each step doubles that:
+   limb_type inv = d;
+   while(static_cast<limb_type>(d * inv) != 1u)
+      inv *= static_cast<limb_type>(2u - d * inv);
+   limb_type carry = 0;
+   for(unsigned i = 0; i < rs; ++i)
+   {
+      limb_type q = static_cast<limb_type>((pr[i] - carry) * inv);
+      carry = static_cast<limb_type>((static_cast<double_limb_type>(q) * d + carry) >> (sizeof(limb_type) * CHAR_BIT));
+      pr[i] = q;
+   }
+   BOOST_ASSERT(carry == 0);
+}
+//
+// r += x * B^offset where B is the limb base, r has rs limbs and the sum is known to fit,
+// but x may have leading zero limbs which extend beyond r:
+//
+inline void add_shifted_limbs(limb_type* pr, unsigned rs, unsigned offset, const limb_type* px, unsigned xs) BOOST_NOEXCEPT
+{
+   BOOST_ASSERT(offset <= rs);
+   while(offset + xs > rs)
+   {
+      --xs;
+      BOOST_ASSERT(px[xs] == 0);
+   }
+   limb_type carry = add_limbs(pr + offset, pr + offset, rs - offset, px, xs);
+   BOOST_ASSERT(!carry);
+   (void)carry;
+}
+//
+// r = a * b by long multiplication, r has as + bs limbs and may not alias a or b:
+//
+inline void multiply_schoolbook(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   std::memset(pr, 0, (as + bs) * sizeof(limb_type));
+   for(unsigned i = 0; i < as; ++i)
+      pr[i + bs] = multiply_add_limb_row(pr + i, pb, bs, pa[i]);
+}
+//
+// r = a * a, r has 2 * as limbs and may not alias a.  Each cross product a[i]a[j] with i < j
+// is formed only once, then the sum is doubled and the squares a[i]^2 added along the diagonal:
+//
+inline void square_schoolbook(limb_type* pr, const limb_type* pa, unsigned as) BOOST_NOEXCEPT
+{
+   if(as < 5)
+   {
+      // For very small values the extra passes over r cost more than the multiplications saved:
+      multiply_schoolbook(pr, pa, as, pa, as);
+      return;
+   }
+   std::memset(pr, 0, 2 * as * sizeof(limb_type));
+   for(unsigned i = 0; i + 1 < as; ++i)
+      pr[i + as] = multiply_add_limbs(pr + 2 * i + 1, as - i - 1, pa + i + 1, as - i - 1, pa[i]);
+   limb_type overflow = left_shift_limbs(pr, 2 * as, 1);
+   BOOST_ASSERT(!overflow);
+   (void)overflow;
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < as; ++i)
+   {
+      double_limb_type sq = static_cast<double_limb_type>(pa[i]) * static_cast<double_limb_type>(pa[i]);
+      carry += static_cast<double_limb_type>(pr[2 * i]) + static_cast<limb_type>(sq);
+#ifdef __MSVC_RUNTIME_CHECKS
+      pr[2 * i] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      pr[2 * i] = static_cast<limb_type>(carry);
+#endif
+      carry >>= sizeof(limb_type) * CHAR_BIT;
+      carry += static_cast<double_limb_type>(pr[2 * i + 1]) + (sq >> (sizeof(limb_type) * CHAR_BIT));
+#ifdef __MSVC_RUNTIME_CHECKS
+      pr[2 * i + 1] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
+#else
+      pr[2 * i + 1] = static_cast<limb_type>(carry);
+#endif
+      carry >>= sizeof(limb_type) * CHAR_BIT;
+   }
+   BOOST_ASSERT(!carry);
+}
+//
+// Upper bound on the temporary storage required by multiply_recursive when the larger
+// operand has n limbs: each level of recursion uses at most 4n + 34 limbs, and passes
+// operands of at most n / 2 + 1 limbs on to the next level:
+//
+inline std::size_t multiply_storage_size(unsigned n) BOOST_NOEXCEPT
+{
+   std::size_t result = 0;
+   while(n >= karatsuba_cutoff)
+   {
+      result += 4 * static_cast<std::size_t>(n) + 34;
+      n = n / 2 + 1;
+   }
+   return result;
+}
+//
+// Same again as a compile time constant, for fixed precision types which keep their temporaries on the stack:
+//
+template <unsigned N, bool recurse = (N >= BOOST_MP_KARATSUBA_CUTOFF)>
+struct multiply_storage_size_c
+{
+   BOOST_STATIC_CONSTANT(unsigned, value = 4 * N + 34 + multiply_storage_size_c<N / 2 + 1>::value);
+};
+template <unsigned N>
+struct multiply_storage_size_c<N, false>
+{
+   BOOST_STATIC_CONSTANT(unsigned, value = 0);
+};
+
+inline void multiply_recursive(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, limb_type* storage) BOOST_NOEXCEPT;
+
+//
+// Karatsuba multiplication, r = a * b where as >= bs > as / 2.  Each of the recursive
+// routines recognises squaring as pa == pb with as == bs, and then evaluates just the one operand
+// and passes on squares to the next level.
+//
+inline void multiply_karatsuba(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, limb_type* storage) BOOST_NOEXCEPT
+{
+   //
+   // Split both values at m limbs so that a = a1 * B^m + a0 and b = b1 * B^m + b0, then:
+   //
+   // a * b = a1b1 * B^2m + (a1b1 + a0b0 - (a1 - a0)(b1 - b0)) * B^m + a0b0
+   //
+   // Using the difference rather than the sum of the halves means the middle product
+   // doesn't grow an extra carry limb.
+   //
+   unsigned m = as / 2;
+   BOOST_ASSERT(bs > m);
+   bool square = (pa == pb) && (as == bs);
+   unsigned a1s = as - m;
+   unsigned b1s = bs - m;
+   //
+   // Low and high products go straight into the result:
+   //
+   multiply_recursive(pr, pa, m, pb, m, storage);
+   multiply_recursive(pr + 2 * m, pa + m, a1s, pb + m, b1s, storage);
+   //
+   // Middle product |a1 - a0| * |b1 - b0|:
+   //
+   unsigned da_size = a1s;
+   unsigned db_size = (std::max)(b1s, m);
+   limb_type* da = storage;
+   limb_type* db = da + da_size;
+   limb_type* prod = db + db_size;
+   unsigned prod_size = da_size + db_size;
+   bool negative = abs_difference_limbs(da, pa + m, a1s, pa, m);
+   if(square)
+      negative = false;
+   else
+      negative = negative != abs_difference_limbs(db, pb + m, b1s, pb, m);
+   multiply_recursive(prod, da, da_size, square ? da : db, db_size, prod + prod_size);
+   //
+   // mid = a1b1 + a0b0 -/+ prod:
+   //
+   // The sum of the cross products a1b0 + a0b1 may be one limb longer than a1, so
+   // mid needs room for that as well as for the sum of the outer products:
+   //
+   unsigned z2_size = as + bs - 2 * m;
+   unsigned sum_size = (std::max)(2 * m, z2_size);
+   unsigned mid_size = (std::max)(as, z2_size) + 1;
+   limb_type* mid = prod + prod_size;
+   if(z2_size >= 2 * m)
+      mid[sum_size] = add_limbs(mid, pr + 2 * m, z2_size, pr, 2 * m);
+   else
+      mid[sum_size] = add_limbs(mid, pr, 2 * m, pr + 2 * m, z2_size);
+   std::fill(mid + sum_size + 1, mid + mid_size, static_cast<limb_type>(0u));
+   BOOST_ASSERT(prod_size <= mid_size);
+   limb_type carry;
+   if(negative)
+      carry = add_limbs(mid, mid, mid_size, prod, prod_size);
+   else
+      carry = subtract_limbs(mid, mid, mid_size, prod, prod_size);
+   BOOST_ASSERT(!carry);
+   (void)carry;
+   //
+   // Add the middle term into the result:
+   //
+   add_shifted_limbs(pr, as + bs, m, mid, mid_size);
+}
+//
+// The Toom-Cook routines split each operand into pieces of k limbs, a(x) = a0 + a1x + a2x^2 + ...
+// with x = B^k, evaluate the resulting polynomials at a few small points, multiply the values
+// pointwise, and then recover the coefficients of the product polynomial c(x) = a(x)b(x) by
+// interpolation.  We evaluate at 0, infinity, +-1, +-2 and 1/2 (scaled to remain an integer),
+// and order the interpolation so that the only intermediate values which may be negative are
+// those at the negative points, after that everything is non-negative and the divisions are
+// all exact.
+//
+// Sets r = sum of x_i * m_i over the n pieces x_i of sizes s_i:
+//
+inline void evaluate_limbs(limb_type* pr, unsigned rs, const limb_type* const* px, const unsigned* xs, const limb_type* m, unsigned n) BOOST_NOEXCEPT
+{
+   std::fill(pr, pr + rs, static_cast<limb_type>(0u));
+   for(unsigned i = 0; i < n; ++i)
+   {
+      if(m[i])
+      {
+         limb_type carry = multiply_add_limbs(pr, rs, px[i], xs[i], m[i]);
+         BOOST_ASSERT(!carry);
+         (void)carry;
+      }
+   }
+}
+//
+// Toom-3 multiplication, r = a * b where as >= bs > as / 2.
+//
+inline void multiply_toom3(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, limb_type* storage) BOOST_NOEXCEPT
+{
+   unsigned k = (as + 2) / 3;
+   BOOST_ASSERT(as > 2 * k);
+   BOOST_ASSERT(bs > k);
+   bool square = (pa == pb) && (as == bs);
+   const limb_type* a[3] = { pa, pa + k, pa + 2 * k };
+   const limb_type* b[3] = { pb, pb + k, pb + 2 * k };
+   const unsigned a_size[3] = { k, k, as - 2 * k };
+   const unsigned b_size[3] = { k, (std::min)(bs - k, k), bs > 2 * k ? bs - 2 * k : 0 };
+   unsigned rs = as + bs;
+   //
+   // Values at the evaluation points have k + 1 limbs, and their products 2k + 2:
+   //
+   unsigned ks = k + 1;
+   unsigned ws = 2 * ks;
+   limb_type* w1 = storage;
+   limb_type* wm1 = w1 + ws;
+   limb_type* w2 = wm1 + ws;
+   limb_type* ea = w2 + ws;
+   limb_type* eb = ea + ks;
+   limb_type* ta = eb + ks;
+   limb_type* tb = ta + ks;
+   storage = tb + ks;
+
+   static const limb_type even[3] = { 1, 0, 1 };
+   static const limb_type two[3] = { 1, 2, 4 };
+   //
+   // Values at 1 and -1:
+   //
+   // When squaring, the values of b are those of a, and the products are squares:
+   const limb_type* sb = square ? ta : tb;
+   evaluate_limbs(ea, ks, a, a_size, even, 3);
+   std::copy(ea, ea + ks, ta);
+   multiply_add_limbs(ta, ks, a[1], a_size[1], 1);
+   if(!square)
+   {
+      evaluate_limbs(eb, ks, b, b_size, even, 3);
+      std::copy(eb, eb + ks, tb);
+      multiply_add_limbs(tb, ks, b[1], b_size[1], 1);
+   }
+   multiply_recursive(w1, ta, ks, sb, ks, storage);
+   bool wm1_negative = abs_difference_limbs(ta, ea, ks, a[1], a_size[1]);
+   if(square)
+      wm1_negative = false;
+   else
+      wm1_negative = wm1_negative != abs_difference_limbs(tb, eb, ks, b[1], b_size[1]);
+   multiply_recursive(wm1, ta, ks, sb, ks, storage);
+   //
+   // Value at 2:
+   //
+   evaluate_limbs(ta, ks, a, a_size, two, 3);
+   if(!square)
+      evaluate_limbs(tb, ks, b, b_size, two, 3);
+   multiply_recursive(w2, ta, ks, sb, ks, storage);
+   //
+   // Values at 0 and infinity are the lowest and highest coefficients of the result,
+   // so they go straight into place:
+   //
+   const limb_type* c0 = pr;
+   const limb_type* c4 = pr + 4 * k;
+   unsigned c4_size = b_size[2] ? rs - 4 * k : 0;
+   multiply_recursive(pr, a[0], k, b[0], k, storage);
+   std::fill(pr + 2 * k, pr + rs, static_cast<limb_type>(0u));
+   if(c4_size)
+      multiply_recursive(pr + 4 * k, a[2], a_size[2], b[2], b_size[2], storage);
+   //
+   // Interpolation, E1 = (w1 + wm1) / 2 = c0 + c2 + c4, O1 = w1 - E1 = c1 + c3:
+   //
+   if(wm1_negative)
+      subtract_limbs(wm1, w1, ws, wm1, ws);
+   else
+      add_limbs(wm1, w1, ws, wm1, ws);
+   right_shift_limbs(wm1, ws, 1);
+   subtract_limbs(w1, w1, ws, wm1, ws);
+   // c2 = E1 - c0 - c4:
+   subtract_limbs(wm1, wm1, ws, c0, 2 * k);
+   subtract_limbs(wm1, wm1, ws, c4, c4_size);
+   // (w2 - c0 - 4c2 - 16c4) / 2 = c1 + 4c3:
+   subtract_limbs(w2, w2, ws, c0, 2 * k);
+   multiply_subtract_limbs(w2, ws, wm1, ws, 4);
+   multiply_subtract_limbs(w2, ws, c4, c4_size, 16);
+   right_shift_limbs(w2, ws, 1);
+   // c3 = (c1 + 4c3 - O1) / 3:
+   subtract_limbs(w2, w2, ws, w1, ws);
+   divide_exact_limbs(w2, ws, 3);
+   // c1 = O1 - c3:
+   subtract_limbs(w1, w1, ws, w2, ws);
+   //
+   // Accumulate the middle coefficients into the result:
+   //
+   add_shifted_limbs(pr, rs, k, w1, ws);
+   add_shifted_limbs(pr, rs, 2 * k, wm1, ws);
+   add_shifted_limbs(pr, rs, 3 * k, w2, ws);
+}
+//
+// Toom-4 multiplication, r = a * b where as >= bs > as / 2.
+//
+inline void multiply_toom4(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, limb_type* storage) BOOST_NOEXCEPT
+{
+   unsigned k = (as + 3) / 4;
+   BOOST_ASSERT(as > 3 * k);
+   BOOST_ASSERT(bs > k);
+   bool square = (pa == pb) && (as == bs);
+   const limb_type* a[4] = { pa, pa + k, pa + 2 * k, pa + 3 * k };
+   const limb_type* b[4] = { pb, pb + k, pb + 2 * k, pb + 3 * k };
+   const unsigned a_size[4] = { k, k, k, as - 3 * k };
+   const unsigned b_size[4] = { k, (std::min)(bs - k, k), bs > 2 * k ? (std::min)(bs - 2 * k, k) : 0, bs > 3 * k ? bs - 3 * k : 0 };
+   unsigned rs = as + bs;
+   //
+   // Values at the evaluation points have k + 1 limbs, and their products 2k + 2:
+   //
+   unsigned ks = k + 1;
+   unsigned ws = 2 * ks;
+   limb_type* w1 = storage;
+   limb_type* wm1 = w1 + ws;
+   limb_type* w2 = wm1 + ws;
+   limb_type* wm2 = w2 + ws;
+   limb_type* wh = wm2 + ws;
+   limb_type* ea = wh + ws;
+   limb_type* oa = ea + ks;
+   limb_type* eb = oa + ks;
+   limb_type* ob = eb + ks;
+   limb_type* ta = ob + ks;
+   limb_type* tb = ta + ks;
+   storage = tb + ks;
+
+   static const limb_type even1[4] = { 1, 0, 1, 0 };
+   static const limb_type odd1[4] = { 0, 1, 0, 1 };
+   static const limb_type even2[4] = { 1, 0, 4, 0 };
+   static const limb_type odd2[4] = { 0, 2, 0, 8 };
+   static const limb_type half[4] = { 8, 4, 2, 1 };
+   //
+   // Values at 1 and -1:
+   //
+   // When squaring, the values of b are those of a, and the products are squares:
+   const limb_type* sb = square ? ta : tb;
+   evaluate_limbs(ea, ks, a, a_size, even1, 4);
+   evaluate_limbs(oa, ks, a, a_size, odd1, 4);
+   add_limbs(ta, ea, ks, oa, ks);
+   if(!square)
+   {
+      evaluate_limbs(eb, ks, b, b_size, even1, 4);
+      evaluate_limbs(ob, ks, b, b_size, odd1, 4);
+      add_limbs(tb, eb, ks, ob, ks);
+   }
+   multiply_recursive(w1, ta, ks, sb, ks, storage);
+   bool wm1_negative = abs_difference_limbs(ta, ea, ks, oa, ks);
+   if(square)
+      wm1_negative = false;
+   else
+      wm1_negative = wm1_negative != abs_difference_limbs(tb, eb, ks, ob, ks);
+   multiply_recursive(wm1, ta, ks, sb, ks, storage);
+   //
+   // Values at 2 and -2:
+   //
+   evaluate_limbs(ea, ks, a, a_size, even2, 4);
+   evaluate_limbs(oa, ks, a, a_size, odd2, 4);
+   add_limbs(ta, ea, ks, oa, ks);
+   if(!square)
+   {
+      evaluate_limbs(eb, ks, b, b_size, even2, 4);
+      evaluate_limbs(ob, ks, b, b_size, odd2, 4);
+      add_limbs(tb, eb, ks, ob, ks);
+   }
+   multiply_recursive(w2, ta, ks, sb, ks, storage);
+   bool wm2_negative = abs_difference_limbs(ta, ea, ks, oa, ks);
+   if(square)
+      wm2_negative = false;
+   else
+      wm2_negative = wm2_negative != abs_difference_limbs(tb, eb, ks, ob, ks);
+   multiply_recursive(wm2, ta, ks, sb, ks, storage);
+   //
+   // Value at 1/2, scaled by 2^3 so that it's an integer:
+   //
+   evaluate_limbs(ta, ks, a, a_size, half, 4);
+   if(!square)
+      evaluate_limbs(tb, ks, b, b_size, half, 4);
+   multiply_recursive(wh, ta, ks, sb, ks, storage);
+   //
+   // Values at 0 and infinity:
+   //
+   const limb_type* c0 = pr;
+   const limb_type* c6 = pr + 6 * k;
+   unsigned c6_size = b_size[3] ? rs - 6 * k : 0;
+   multiply_recursive(pr, a[0], k, b[0], k, storage);
+   std::fill(pr + 2 * k, pr + rs, static_cast<limb_type>(0u));
+   if(c6_size)
+      multiply_recursive(pr + 6 * k, a[3], a_size[3], b[3], b_size[3], storage);
+   //
+   // Interpolation, E1 = (w1 + wm1) / 2 = c0 + c2 + c4 + c6, O1 = w1 - E1 = c1 + c3 + c5:
+   //
+   if(wm1_negative)
+      subtract_limbs(wm1, w1, ws, wm1, ws);
+   else
+      add_limbs(wm1, w1, ws, wm1, ws);
+   right_shift_limbs(wm1, ws, 1);
+   subtract_limbs(w1, w1, ws, wm1, ws);
+   // E2 = (w2 + wm2) / 2 = c0 + 4c2 + 16c4 + 64c6, O2 = (w2 - E2) / 2 = c1 + 4c3 + 16c5:
+   if(wm2_negative)
+      subtract_limbs(wm2, w2, ws, wm2, ws);
+   else
+      add_limbs(wm2, w2, ws, wm2, ws);
+   right_shift_limbs(wm2, ws, 1);
+   subtract_limbs(w2, w2, ws, wm2, ws);
+   right_shift_limbs(w2, ws, 1);
+   // E1 - c0 - c6 = c2 + c4:
+   subtract_limbs(wm1, wm1, ws, c0, 2 * k);
+   subtract_limbs(wm1, wm1, ws, c6, c6_size);
+   // (E2 - c0 - 64c6) / 4 = c2 + 4c4:
+   subtract_limbs(wm2, wm2, ws, c0, 2 * k);
+   multiply_subtract_limbs(wm2, ws, c6, c6_size, 64);
+   right_shift_limbs(wm2, ws, 2);
+   // c4 = (c2 + 4c4 - (c2 + c4)) / 3:
+   subtract_limbs(wm2, wm2, ws, wm1, ws);
+   divide_exact_limbs(wm2, ws, 3);
+   // c2 = c2 + c4 - c4:
+   subtract_limbs(wm1, wm1, ws, wm2, ws);
+   // (wh - 64c0 - 16c2 - 4c4 - c6) / 2 = 16c1 + 4c3 + c5:
+   multiply_subtract_limbs(wh, ws, c0, 2 * k, 64);
+   multiply_subtract_limbs(wh, ws, wm1, ws, 16);
+   multiply_subtract_limbs(wh, ws, wm2, ws, 4);
+   subtract_limbs(wh, wh, ws, c6, c6_size);
+   right_shift_limbs(wh, ws, 1);
+   // (O2 - O1) / 3 = c3 + 5c5:
+   subtract_limbs(w2, w2, ws, w1, ws);
+   divide_exact_limbs(w2, ws, 3);
+   // (16 O1 - (16c1 + 4c3 + c5)) / 3 = 4c3 + 5c5:
+   left_shift_limbs(w1, ws, 4);
+   subtract_limbs(w1, w1, ws, wh, ws);
+   divide_exact_limbs(w1, ws, 3);
+   // c3 = (4c3 + 5c5 - (c3 + 5c5)) / 3:
+   subtract_limbs(w1, w1, ws, w2, ws);
+   divide_exact_limbs(w1, ws, 3);
+   // c5 = (c3 + 5c5 - c3) / 5:
+   subtract_limbs(w2, w2, ws, w1, ws);
+   divide_exact_limbs(w2, ws, 5);
+   // c1 = (16c1 + 4c3 + c5 - 4c3 - c5) / 16:
+   multiply_subtract_limbs(wh, ws, w1, ws, 4);
+   subtract_limbs(wh, wh, ws, w2, ws);
+   right_shift_limbs(wh, ws, 4);
+   //
+   // Accumulate the middle coefficients into the result:
+   //
+   add_shifted_limbs(pr, rs, k, wh, ws);
+   add_shifted_limbs(pr, rs, 2 * k, wm1, ws);
+   add_shifted_limbs(pr, rs, 3 * k, w1, ws);
+   add_shifted_limbs(pr, rs, 4 * k, wm2, ws);
+   add_shifted_limbs(pr, rs, 5 * k, w2, ws);
+}
+//
+// r = a * b, r has as + bs limbs and may not alias a or b, storage must have at least
+// multiply_storage_size(max(as, bs)) limbs.
+//
+inline void multiply_recursive(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, limb_type* storage) BOOST_NOEXCEPT
+{
+   if(as < bs)
+   {
+      std::swap(pa, pb);
+      std::swap(as, bs);
+   }
+   if(bs < karatsuba_cutoff)
+   {
+      if((pa == pb) && (as == bs))
+         square_schoolbook(pr, pa, as);
+      else
+         multiply_schoolbook(pr, pa, as, pb, bs);
+      return;
+   }
+   if(bs <= as / 2)
+   {
+      //
+      // Very unbalanced operands: split a into chunks of bs limbs and multiply each of
+      // those by b, accumulating the results:
+      //
+      multiply_recursive(pr, pa, bs, pb, bs, storage);
+      std::memset(pr + 2 * bs, 0, (as - bs) * sizeof(limb_type));
+      limb_type* t = storage;
+      storage += 2 * bs;
+      for(unsigned i = bs; i < as; i += bs)
+      {
+         unsigned cs = (std::min)(bs, as - i);
+         multiply_recursive(t, pa + i, cs, pb, bs, storage);
+         add_shifted_limbs(pr, as + bs, i, t, cs + bs);
+      }
+      return;
+   }
+   if(bs >= toom4_cutoff)
+      multiply_toom4(pr, pa, as, pb, bs, storage);
+   else if(bs >= toom3_cutoff)
+      multiply_toom3(pr, pa, as, pb, bs, storage);
+   else
+      multiply_karatsuba(pr, pa, as, pb, bs, storage);
+}
+//
+// Number theoretic transform multiplication:
+//
+// The product is computed as the convolution of the limbs of the two values, modulo each of
+// three primes of the form c * 2^k + 1 using a fast transform of length a power of 2, and then
+// the exact result is reconstructed by the Chinese remainder theorem.  The product of the primes
+// is large enough that the reconstruction is exact for any transform length the primes support.
+// Arithmetic modulo the primes is done in Montgomery form.
+//
+template <unsigned Bits, class Dummy = void>
+struct ntt_primes;
+
+template <class Dummy>
+struct ntt_primes<64, Dummy>
+{
+   static limb_type prime(unsigned i)
+   {
+      static const boost::uint64_t primes[] = { 4179340454199820289uLL /* 29 * 2^57 + 1 */, 2485986994308513793uLL /* 69 * 2^55 + 1 */, 2936346957045563393uLL /* 163 * 2^54 + 1 */ };
+      return static_cast<limb_type>(primes[i]);
+   }
+   static limb_type generator(unsigned i)
+   {
+      static const limb_type generators[] = { 3, 5, 3 };
+      return generators[i];
+   }
+   BOOST_STATIC_CONSTANT(unsigned, max_log2_size = 54);
+};
+
+template <class Dummy>
+struct ntt_primes<32, Dummy>
+{
+   static limb_type prime(unsigned i)
+   {
+      static const boost::uint32_t primes[] = { 754974721u /* 45 * 2^24 + 1 */, 880803841u /* 105 * 2^23 + 1 */, 998244353u /* 119 * 2^23 + 1 */ };
+      return static_cast<limb_type>(primes[i]);
+   }
+   static limb_type generator(unsigned i)
+   {
+      static const limb_type generators[] = { 11, 26, 3 };
+      return generators[i];
+   }
+   BOOST_STATIC_CONSTANT(unsigned, max_log2_size = 23);
+};
+
+typedef ntt_primes<sizeof(limb_type) * CHAR_BIT> ntt_prime_list;
+
+//
+// Arithmetic modulo a prime p < 2^(limb_bits - 1), multiplication is Montgomery multiplication
+// so that mul(a, b) = a * b * R^-1 mod p with R = 2^limb_bits:
+//
+class ntt_modulus
+{
+ public:
+   explicit ntt_modulus(limb_type prime) : m_p(prime)
+   {
+      limb_type inv = prime;
+      while(static_cast<limb_type>(prime * inv) != 1u)
+         inv *= static_cast<limb_type>(2u - prime * inv);
+      m_pinv = static_cast<limb_type>(0u - inv);
+      m_one = static_cast<limb_type>((~static_cast<limb_type>(0u) % prime + 1) % prime);
+      m_r2 = static_cast<limb_type>(static_cast<double_limb_type>(m_one) * m_one % prime);
+   }
+   limb_type p() const { return m_p; }
+   // R mod p, which is 1 in Montgomery form:
+   limb_type one() const { return m_one; }
+   limb_type add(limb_type a, limb_type b) const
+   {
+      limb_type r = a + b;
+      return r >= m_p ? static_cast<limb_type>(r - m_p) : r;
+   }
+   limb_type sub(limb_type a, limb_type b) const
+   {
+      return a >= b ? static_cast<limb_type>(a - b) : static_cast<limb_type>(a + m_p - b);
+   }
+   // Requires a * b < p * R, which holds when either is less than p:
+   limb_type mul(limb_type a, limb_type b) const
+   {
+      double_limb_type t = static_cast<double_limb_type>(a) * b;
+      limb_type m = static_cast<limb_type>(static_cast<limb_type>(t) * m_pinv);
+      t = (t + static_cast<double_limb_type>(m) * m_p) >> (sizeof(limb_type) * CHAR_BIT);
+      limb_type r = static_cast<limb_type>(t);
+      return r >= m_p ? static_cast<limb_type>(r - m_p) : r;
+   }
+   limb_type to_montgomery(limb_type a) const
+   {
+      return mul(a, m_r2);
+   }
+   // a in Montgomery form, as is the result:
+   limb_type pow(limb_type a, limb_type e) const
+   {
+      limb_type result = m_one;
+      while(e)
+      {
+         if(e & 1u)
+            result = mul(result, a);
+         a = mul(a, a);
+         e >>= 1;
+      }
+      return result;
+   }
+ private:
+   limb_type m_p, m_pinv, m_one, m_r2;
+};
+//
+// Forward transform by decimation in frequency, the output is in bit reversed order.
+// w holds the powers 0 .. n/2 - 1 of the n'th root of unity in Montgomery form:
+//
+inline void ntt_forward(limb_type* a, unsigned n, const limb_type* w, const ntt_modulus& m) BOOST_NOEXCEPT
+{
+   for(unsigned h = n / 2, stride = 1; h; h /= 2, stride *= 2)
+   {
+      for(unsigned s = 0; s < n; s += 2 * h)
+      {
+         for(unsigned j = 0; j < h; ++j)
+         {
+            limb_type x = a[s + j];
+            limb_type y = a[s + j + h];
+            a[s + j] = m.add(x, y);
+            a[s + j + h] = m.mul(m.sub(x, y), w[j * stride]);
+         }
+      }
+   }
+}
+//
+// Inverse transform by decimation in time, taking input in bit reversed order, and producing
+// n times the inverse.  The inverse roots come from the same table as w^-k = -w^(n/2 - k):
+//
+inline void ntt_inverse(limb_type* a, unsigned n, const limb_type* w, const ntt_modulus& m) BOOST_NOEXCEPT
+{
+   for(unsigned h = 1, stride = n / 2; h < n; h *= 2, stride /= 2)
+   {
+      for(unsigned s = 0; s < n; s += 2 * h)
+      {
+         limb_type x = a[s];
+         limb_type y = a[s + h];
+         a[s] = m.add(x, y);
+         a[s + h] = m.sub(x, y);
+         for(unsigned j = 1; j < h; ++j)
+         {
+            x = a[s + j];
+            y = m.mul(a[s + j + h], static_cast<limb_type>(m.p() - w[n / 2 - j * stride]));
+            a[s + j] = m.add(x, y);
+            a[s + j + h] = m.sub(x, y);
+         }
+      }
+   }
+}
+//
+// Sets r to the convolution of a and b modulo the i'th prime, r and t both have n limbs, w n/2.
+// When squaring, pass pb == pa and the second transform is skipped:
+//
+inline void ntt_convolve(limb_type* r, limb_type* t, limb_type* w, unsigned n, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, unsigned i) BOOST_NOEXCEPT
+{
+   ntt_modulus m(ntt_prime_list::prime(i));
+   limb_type root = m.pow(m.to_montgomery(ntt_prime_list::generator(i)), (m.p() - 1) / n);
+   w[0] = m.one();
+   for(unsigned j = 1; j < n / 2; ++j)
+      w[j] = m.mul(w[j - 1], root);
+   //
+   // The input is converted to Montgomery form, which also reduces it modulo p:
+   //
+   for(unsigned j = 0; j < as; ++j)
+      r[j] = m.to_montgomery(pa[j]);
+   std::fill(r + as, r + n, static_cast<limb_type>(0u));
+   ntt_forward(r, n, w, m);
+   if((pa == pb) && (as == bs))
+   {
+      for(unsigned j = 0; j < n; ++j)
+         r[j] = m.mul(r[j], r[j]);
+   }
+   else
+   {
+      for(unsigned j = 0; j < bs; ++j)
+         t[j] = m.to_montgomery(pb[j]);
+      std::fill(t + bs, t + n, static_cast<limb_type>(0u));
+      ntt_forward(t, n, w, m);
+      for(unsigned j = 0; j < n; ++j)
+         r[j] = m.mul(r[j], t[j]);
+   }
+   ntt_inverse(r, n, w, m);
+   //
+   // Divide by n, and at the same time convert out of Montgomery form:
+   // n^-1 mod p is p - (p - 1) / n.
+   //
+   limb_type n_inv = m.p() - (m.p() - 1) / n;
+   for(unsigned j = 0; j < n; ++j)
+      r[j] = m.mul(r[j], n_inv);
+}
+//
+// Transform length for a product of rs limbs, or zero if the primes can't support a transform that long:
+//
+inline unsigned ntt_size(unsigned rs) BOOST_NOEXCEPT
+{
+   unsigned n = 1;
+   for(unsigned log2_n = 0; n < rs; ++log2_n)
+   {
+      if(log2_n >= ntt_prime_list::max_log2_size)
+         return 0;
+      n *= 2;
+   }
+   return n;
+}
+inline std::size_t ntt_storage_size(unsigned rs) BOOST_NOEXCEPT
+{
+   return 4 * static_cast<std::size_t>(ntt_size(rs)) + ntt_size(rs) / 2;
+}
+//
+// r = a * b, r has as + bs limbs and may not alias a or b, storage must have at least
+// ntt_storage_size(as + bs) limbs, and ntt_size(as + bs) must be non-zero.
+//
+inline void multiply_ntt(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, limb_type* storage) BOOST_NOEXCEPT
+{
+   unsigned rs = as + bs;
+   unsigned n = ntt_size(rs);
+   BOOST_ASSERT(n);
+   limb_type* r1 = storage;
+   limb_type* r2 = r1 + n;
+   limb_type* r3 = r2 + n;
+   limb_type* t = r3 + n;
+   limb_type* w = t + n;
+   ntt_convolve(r1, t, w, n, pa, as, pb, bs, 0);
+   ntt_convolve(r2, t, w, n, pa, as, pb, bs, 1);
+   ntt_convolve(r3, t, w, n, pa, as, pb, bs, 2);
+   //
+   // Garner's algorithm recovers each coefficient x of the convolution from its residues as
+   // x = v1 + v2 p1 + v3 p1 p2, where v1, v2 and v3 are each less than the corresponding prime.
+   // The primes are all within a factor of 2 of each other, so a single subtraction reduces
+   // a residue modulo one prime to a residue modulo another.
+   //
+   ntt_modulus m2(ntt_prime_list::prime(1)), m3(ntt_prime_list::prime(2));
+   limb_type p1 = ntt_prime_list::prime(0);
+   limb_type p2 = m2.p();
+   limb_type p3 = m3.p();
+   limb_type p1_mod_p2 = p1 >= p2 ? static_cast<limb_type>(p1 - p2) : p1;
+   limb_type p1_mod_p3 = p1 >= p3 ? static_cast<limb_type>(p1 - p3) : p1;
+   limb_type p2_mod_p3 = p2 >= p3 ? static_cast<limb_type>(p2 - p3) : p2;
+   // Inverses by Fermat's little theorem, all in Montgomery form:
+   limb_type inv_p1_mod_p2 = m2.pow(m2.to_montgomery(p1_mod_p2), p2 - 2);
+   limb_type p1_mont_p3 = m3.to_montgomery(p1_mod_p3);
+   limb_type inv_p1p2_mod_p3 = m3.pow(m3.mul(p1_mont_p3, m3.to_montgomery(p2_mod_p3)), p3 - 2);
+   double_limb_type p1p2 = static_cast<double_limb_type>(p1) * p2;
+   limb_type p1p2_low = static_cast<limb_type>(p1p2);
+   limb_type p1p2_high = static_cast<limb_type>(p1p2 >> (sizeof(limb_type) * CHAR_BIT));
+
+   double_limb_type carry = 0;
+   for(unsigned i = 0; i < rs; ++i)
+   {
+      limb_type v1 = r1[i];
+      limb_type v2 = m2.mul(m2.sub(r2[i], v1 >= p2 ? static_cast<limb_type>(v1 - p2) : v1), inv_p1_mod_p2);
+      limb_type u = m3.sub(r3[i], v1 >= p3 ? static_cast<limb_type>(v1 - p3) : v1);
+      u = m3.sub(u, m3.mul(v2, p1_mont_p3));
+      limb_type v3 = m3.mul(u, inv_p1p2_mod_p3);
+      //
+      // x = t0 + t1 + t2 * B:
+      //
+      double_limb_type t0 = static_cast<double_limb_type>(v2) * p1 + v1;
+      double_limb_type t1 = static_cast<double_limb_type>(v3) * p1p2_low;
+      double_limb_type t2 = static_cast<double_limb_type>(v3) * p1p2_high;
+      double_limb_type s = static_cast<double_limb_type>(static_cast<limb_type>(t0)) + static_cast<limb_type>(t1) + static_cast<limb_type>(carry);
+      pr[i] = static_cast<limb_type>(s);
+      carry = (s >> (sizeof(limb_type) * CHAR_BIT)) + (t0 >> (sizeof(limb_type) * CHAR_BIT)) + (t1 >> (sizeof(limb_type) * CHAR_BIT)) + (carry >> (sizeof(limb_type) * CHAR_BIT)) + t2;
+   }
+   BOOST_ASSERT(carry == 0);
+}
+//
+// Multiplication of raw limbs by whichever of the routines above suits the operand sizes, for
+// use by other algorithms built on top of multiplication.  The requirements are those of
+// multiply_recursive, except that storage must have multiply_limbs_storage_size(max(as, bs)) limbs:
+//
+inline std::size_t multiply_limbs_storage_size(unsigned n) BOOST_NOEXCEPT
+{
+   std::size_t result = multiply_storage_size(n);
+   if((n >= ntt_cutoff) && ntt_size(2 * n))
+      result = (std::max)(result, ntt_storage_size(2 * n));
+   return result;
+}
+inline void multiply_limbs(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs, limb_type* storage) BOOST_NOEXCEPT
+{
+   if(((std::min)(as, bs) >= ntt_cutoff) && ntt_size(as + bs))
+      multiply_ntt(pr, pa, as, pb, bs, storage);
+   else
+      multiply_recursive(pr, pa, as, pb, bs, storage);
+}
+//
+// When the result aliases one of the operands (pa or pb point to pr), copies that operand to
+// dest and points at the copy instead, so the routines above can write the product to pr:
+//
+inline void copy_aliased_operand(const limb_type* pr, const limb_type*& pa, unsigned as, const limb_type*& pb, unsigned bs, limb_type* dest) BOOST_NOEXCEPT
+{
+   if(pa == pr)
+   {
+      bool square = pb == pa;
+      pa = std::copy(pa, pa + as, dest) - as;
+      if(square)
+         pb = pa;
+   }
+   else if(pb == pr)
+      pb = std::copy(pb, pb + bs, dest) - bs;
+}
+//
+// Temporary storage for the recursive routines above, from the workspace bound to the current
+// thread if there is one with room, and otherwise allocated with a copy of the result's allocator.
+// When allocate is false nothing is allocated, and data() is null unless the workspace had room:
+//
+template <class Allocator>
+class scoped_limb_storage
+{
+ public:
+   scoped_limb_storage(const Allocator& a, std::size_t n, bool allocate = true) : m_alloc(a), m_size(n), m_workspace(current_workspace()), m_scratch(0), m_data(), m_allocated(false)
+   {
+      if(m_workspace && (n <= (std::numeric_limits<std::size_t>::max)() / sizeof(limb_type)))
+         m_scratch = static_cast<limb_type*>(m_workspace->allocate(n * sizeof(limb_type)));
+      if(!m_scratch && allocate)
+      {
+         m_data = m_alloc.allocate(n);
+         m_allocated = true;
+      }
+   }
+   ~scoped_limb_storage()
+   {
+      if(m_scratch)
+         m_workspace->deallocate(m_scratch, m_size * sizeof(limb_type));
+      else if(m_allocated)
+         m_alloc.deallocate(m_data, m_size);
+   }
+   limb_type* data() { return m_scratch ? m_scratch : m_allocated ? &*m_data : 0; }
+ private:
+   scoped_limb_storage(const scoped_limb_storage&);
+   scoped_limb_storage& operator=(const scoped_limb_storage&);
+
+#ifdef BOOST_NO_CXX11_ALLOCATOR
+   typedef typename Allocator::pointer pointer;
+#else
+   typedef typename std::allocator_traits<Allocator>::pointer pointer;
+#endif
+   Allocator m_alloc;
+   std::size_t m_size;
+   workspace* m_workspace;
+   limb_type* m_scratch;
+   pointer m_data;
+   bool m_allocated;
+};
+//
+// The type of arbitrary precision working values in the routines which need them for a CppInt:
+// their memory comes from the workspace, and otherwise from CppInt's allocator, so that values
+// using a pooled or instrumented allocator don't allocate behind its back.  Fixed precision types
+// have no allocator, and use std::allocator:
+//
+template <class CppInt>
+struct workspace_int;
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+struct workspace_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >
+{
+   typedef cpp_int_backend<0, 0, signed_magnitude, unchecked, boost::multiprecision::detail::workspace_allocator<limb_type, typename rebind<limb_type, Allocator1>::type> > type;
+};
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1>
+struct workspace_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void> >
+{
+   typedef cpp_int_backend<0, 0, signed_magnitude, unchecked, boost::multiprecision::detail::workspace_allocator<limb_type> > type;
+};
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class T, class Allocator1>
+struct workspace_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, boost::multiprecision::detail::workspace_allocator<T, Allocator1> > >
+{
+   // Working values of working values don't wrap the allocator again:
+   typedef cpp_int_backend<0, 0, signed_magnitude, unchecked, boost::multiprecision::detail::workspace_allocator<limb_type, typename rebind<limb_type, Allocator1>::type> > type;
+};
+//
+// The type of working copies of CppInt: for types which allocate, the workspace_int above, and
+// otherwise CppInt itself, which keeps everything on the stack:
+//
+template <class CppInt>
+struct scratch_int
+{
+   typedef typename workspace_int<CppInt>::type type;
+};
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1>
+struct scratch_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void> >
+{
+   typedef cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void> type;
+};
+
+} // namespace detail
+
+//
+// Sets result = a * b where result has already been resized to as + bs limbs.  When multiplying
+// in place, pa or pb (or both when squaring) point to result's own limbs, and that operand is
+// first copied to the end of the temporary storage:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1>
+inline void multiply_recursive(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs)
+{
+   BOOST_ASSERT(result.size() == as + bs);
+   typedef detail::scoped_limb_storage<typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::allocator_type> storage_type;
+   const limb_type* pr = result.limbs();
+   unsigned aliased = pa == pr ? as : pb == pr ? bs : 0;
+   if(((std::min)(as, bs) >= ntt_cutoff) && detail::ntt_size(as + bs))
+   {
+      //
+      // All the temporaries for the transforms are allocated up front, and reused for each prime:
+      //
+      std::size_t n = detail::ntt_storage_size(as + bs);
+      storage_type storage(result.allocator(), n + aliased);
+      detail::copy_aliased_operand(pr, pa, as, pb, bs, storage.data() + n);
+      detail::multiply_ntt(result.limbs(), pa, as, pb, bs, storage.data());
+   }
+   else
+   {
+      std::size_t n = detail::multiply_storage_size((std::max)(as, bs));
+      storage_type storage(result.allocator(), n + aliased);
+      detail::copy_aliased_operand(pr, pa, as, pb, bs, storage.data() + n);
+      detail::multiply_recursive(result.limbs(), pa, as, pb, bs, storage.data());
+   }
+}
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1>
+inline void multiply_recursive(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>& result, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   //
+   // Fixed precision types don't allocate, the operand sizes are bounded so we can
+   // put the temporaries on the stack.  The storage is several times the size of the
+   // type though, so as for Montgomery multiplication we limit that to types of at most
+   // 8192 bits, and larger ones fall back on long multiplication, which needs none:
+   //
+   BOOST_ASSERT(result.size() == as + bs);
+   static const unsigned internal_limb_count = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, void>::internal_limb_count;
+   static const bool on_stack = internal_limb_count * sizeof(limb_type) * CHAR_BIT <= 8192;
+   limb_type storage[on_stack ? detail::multiply_storage_size_c<internal_limb_count>::value + 1 : 1];
+   BOOST_ASSERT(!on_stack || (detail::multiply_storage_size((std::max)(as, bs)) < sizeof(storage) / sizeof(storage[0])));
+   //
+   // Neither operand is longer than the result.  gcc can't see that for itself and would otherwise
+   // warn about overflowing the buffer below, so the bound is spelled out, it changes nothing:
+   //
+   BOOST_ASSERT((as <= internal_limb_count) && (bs <= internal_limb_count));
+   as = (std::min)(as, internal_limb_count);
+   bs = (std::min)(bs, internal_limb_count);
+   limb_type operand[internal_limb_count];
+   detail::copy_aliased_operand(result.limbs(), pa, as, pb, bs, operand);
+   if(on_stack)
+      detail::multiply_recursive(result.limbs(), pa, as, pb, bs, storage);
+   else if((pa == pb) && (as == bs))
+      detail::square_schoolbook(result.limbs(), pa, as);
+   else
+      detail::multiply_schoolbook(result.limbs(), pa, as, pb, bs);
+}
+
+//
+// Sets result = a * a when the square may be too large for result, which is bounded to at most
+// 8192 bits (as for the temporaries of fixed precision multiplication).  The square is formed in
+// full on the stack, and then truncated to fit, or raises an overflow error when checked.  This is
+// the case that pow and powm reach after a few squarings.  Returns false, having done nothing,
+// for larger types and when a has more limbs than result can hold:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
+inline bool square_truncated(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a)
+{
+   static const unsigned limb_bits = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits;
+   static const unsigned max_bits = max_precision<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value;
+   static const bool on_stack = max_bits <= 8192;
+   static const unsigned max_limbs = on_stack ? max_bits / limb_bits + ((max_bits % limb_bits) ? 1 : 0) : 1;
+   unsigned as = a.size();
+   if(!on_stack || (as > max_limbs))
+      return false;
+   limb_type square[2 * max_limbs];
+   limb_type storage[detail::multiply_storage_size_c<max_limbs>::value + 1];
+   if(as < karatsuba_cutoff)
+      detail::square_schoolbook(square, a.limbs(), as);
+   else
+      detail::multiply_recursive(square, a.limbs(), as, a.limbs(), as, storage);
+   unsigned n = 2 * as;
+   while((n > 1) && !square[n - 1])
+      --n;
+   result.resize(n, n);  // May throw if checking is enabled
+   std::copy(square, square + result.size(), result.limbs());
+   result.normalize();
+   result.sign(false);
+   return true;
+}
+
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
+inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type
+   eval_square(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
+{
+   //
+   // Squaring needs only about half the limb multiplications of a general product, and when
+   // result and a are the same object, a is squared without first being copied into a new value:
+   //
+   unsigned as = a.size();
+   if(as == 1)
+   {
+      limb_type l = *a.limbs();
+      result = static_cast<double_limb_type>(l) * static_cast<double_limb_type>(l);
+      return;
+   }
+   static const unsigned limb_bits = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits;
+   static const unsigned max_limbs = max_precision<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value / limb_bits
+      + ((max_precision<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value % limb_bits) ? 1 : 0);
+   if(2 * as > max_limbs)
+   {
+      //
+      // The square may not fit in a fixed precision result, for types small enough it's formed in
+      // full on the stack and then truncated, and otherwise the general case takes care of that:
+      //
+      if(!square_truncated(result, a))
+      {
+         cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t(a);
+         eval_multiply(result, a, t);
+      }
+      return;
+   }
+   bool in_place = (void*)&result == (void*)&a;
+   if(as < karatsuba_cutoff)
+   {
+      limb_type operand[karatsuba_cutoff];
+      const limb_type* pa = a.limbs();
+      if(in_place)
+         pa = std::copy(pa, pa + as, operand) - as;
+      result.resize(2 * as, 2 * as);
+      detail::square_schoolbook(result.limbs(), pa, as);
+   }
+   else
+   {
+      result.resize(2 * as, 2 * as);
+      const limb_type* pa = in_place ? result.limbs() : a.limbs();
+      multiply_recursive(result, pa, as, pa, as);
+   }
+   result.normalize();
+   result.sign(false);
+}
+
+//
+// Sets result *= b, where b is a different object, without first copying result.  Long multiplication
+// moves the limbs of result up to the top of the product, and then row i of the product reaches
+// no further than limb i of the original value, which has just been read.  Larger values go through
+// multiply_recursive, which copies result into the temporary storage it allocates anyway.  Returns
+// false when the product may not fit in the result, as the caller then needs the original value to
+// truncate or raise an overflow error:
+//
+template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
+inline bool multiply_in_place(
+      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
+      const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& b)
+{
+   static const unsigned limb_bits = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits;
+   static const unsigned max_limbs = max_precision<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value / limb_bits
+      + ((max_precision<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value % limb_bits) ? 1 : 0);
+   unsigned as = result.size();
+   unsigned bs = b.size();
+   if(as + bs > max_limbs)
+      return false;
+   bool s = result.sign() != b.sign();
+   result.resize(as + bs, as + bs);
+   typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_pointer pr = result.limbs();
+   typename cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>::const_limb_pointer pb = b.limbs();
+   if((as >= karatsuba_cutoff) && (bs >= karatsuba_cutoff))
+      multiply_recursive(result, pr, as, pb, bs);
+   else
+   {
+      std::memmove(pr + bs, pr, as * sizeof(limb_type));
+      pr[bs] = detail::multiply_limb_row(pr, pb, bs, pr[bs]);
+      for(unsigned i = 1; i < as; ++i)
+         pr[i + bs] = detail::multiply_add_limb_row(pr + i, pb, bs, pr[i + bs]);
+   }
+   result.normalize();
+   result.sign(s);
+   return true;
+}
+
+//
+// Fixed precision types which are small enough multiply with the loops unrolled, only forming
+// the products which land inside the type, see unrolled_kernels.hpp.  That's a fixed
+// n * (n + 1) / 2 limb multiplications whatever the arguments, and it only pays for itself
+// against the as * bs of long multiplication when that's at least half as many, so short
+// arguments go the general route instead.  Returns false when nothing was done:
+//
+template <class CppInt1, class CppInt2, class CppInt3>
+inline bool multiply_unrolled(CppInt1&, const CppInt2&, const CppInt3&) BOOST_NOEXCEPT
+{
+   return false;
+}
+template <unsigned Bits, cpp_integer_type SignType>
+inline typename enable_if_c<is_unrolled_cpp_int<cpp_int_backend<Bits, Bits, SignType, unchecked, void> >::value, bool>::type
+   multiply_unrolled(
+      cpp_int_backend<Bits, Bits, SignType, unchecked, void>& result,
+      const cpp_int_backend<Bits, Bits, SignType, unchecked, void>& a,
+      const cpp_int_backend<Bits, Bits, SignType, unchecked, void>& b) BOOST_NOEXCEPT
+{
+   static const unsigned n = cpp_int_backend<Bits, Bits, SignType, unchecked, void>::internal_limb_count;
+   unsigned as = a.size();
+   unsigned bs = b.size();
+   if(4 * as * bs <= n * (n + 1))
+      return false;
+   bool s = a.sign() != b.sign();
+   detail::unrolled_multiply_truncated<n>(result.limbs(), a.limbs(), as, b.limbs(), bs);
+   result.resize(as + bs, as + bs);
+   result.normalize();
+   result.sign(s);
+   return true;
+}
+
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2, unsigned MinBits3, unsigned MaxBits3, cpp_integer_type SignType3, cpp_int_check_type Checked3, class Allocator3>
-inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
+inline BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3> >::value >::type
    eval_multiply(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a, 
       const cpp_int_backend<MinBits3, MaxBits3, SignType3, Checked3, Allocator3>& b) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
 {
-   // Very simple long multiplication, only usable for small numbers of limb_type's
-   // but that's the typical use case for this type anyway:
+   // Long multiplication for small numbers of limb_type's, which is the typical use case
+   // for this type, with larger values handed off to the recursive routines above:
    //
    // Special cases first:
    //
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   if(BOOST_MP_IS_CONST_EVALUATED)
+   {
+      detail::constexpr_multiply(result, a, b);
+      return;
+   }
+#endif
    unsigned as = a.size();
    unsigned bs = b.size();
    typename cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>::const_limb_pointer pa = a.limbs();
@@ -110,64 +1363,56 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
       result.sign(s);
       return;
    }
+   if(multiply_unrolled(result, a, b))
+      return;
 
+   if((void*)&a == (void*)&b)
+   {
+      eval_square(result, a);
+      return;
+   }
    if((void*)&result == (void*)&a)
    {
-      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t(a);
-      eval_multiply(result, t, b);
+      if(!multiply_in_place(result, b))
+      {
+         cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t(a);
+         eval_multiply(result, t, b);
+      }
       return;
    }
    if((void*)&result == (void*)&b)
    {
-      cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t(b);
-      eval_multiply(result, a, t);
+      if(!multiply_in_place(result, a))
+      {
+         cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> t(b);
+         eval_multiply(result, a, t);
+      }
       return;
    }
 
    result.resize(as + bs, as + bs - 1);
    typename cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_pointer pr = result.limbs();
 
-   static const double_limb_type limb_max = ~static_cast<limb_type>(0u);
-   static const double_limb_type double_limb_max = ~static_cast<double_limb_type>(0u);
-   BOOST_STATIC_ASSERT(double_limb_max - 2 * limb_max >= limb_max * limb_max);
+   if((as >= karatsuba_cutoff) && (bs >= karatsuba_cutoff) && (result.size() == as + bs))
+   {
+      multiply_recursive(result, pa, as, pb, bs);
+      result.normalize();
+      result.sign(a.sign() != b.sign());
+      return;
+   }
 
-   double_limb_type carry = 0;
    std::memset(pr, 0, result.size() * sizeof(limb_type));
    for(unsigned i = 0; i < as; ++i)
    {
       unsigned inner_limit = cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::variable ? bs : (std::min)(result.size() - i, bs);
-      unsigned j;
-      for(j = 0; j < inner_limit; ++j)
-      {
-         BOOST_ASSERT(i+j < result.size());
-#if (!defined(__GLIBCXX__) && !defined(__GLIBCPP__)) || !BOOST_WORKAROUND(BOOST_GCC_VERSION, <= 50100)
-         BOOST_ASSERT(!std::numeric_limits<double_limb_type>::is_specialized 
-            || ((std::numeric_limits<double_limb_type>::max)() - carry 
-                  > 
-                static_cast<double_limb_type>(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::max_limb_value) * static_cast<double_limb_type>(cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::max_limb_value)));
-#endif
-         carry += static_cast<double_limb_type>(pa[i]) * static_cast<double_limb_type>(pb[j]);
-         BOOST_ASSERT(!std::numeric_limits<double_limb_type>::is_specialized || ((std::numeric_limits<double_limb_type>::max)() - carry >= pr[i+j]));
-         carry += pr[i + j];
-#ifdef __MSVC_RUNTIME_CHECKS
-         pr[i + j] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-         pr[i + j] = static_cast<limb_type>(carry);
-#endif
-         carry >>= cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::limb_bits;
-         BOOST_ASSERT(carry <= (cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>::max_limb_value));
-      }
+      BOOST_ASSERT(i + inner_limit <= result.size());
+      limb_type carry = detail::multiply_add_limb_row(pr + i, pb, inner_limit, pa[i]);
       if(carry)
       {
-         resize_for_carry(result, i + j + 1);  // May throw if checking is enabled
-         if(i + j < result.size())
-#ifdef __MSVC_RUNTIME_CHECKS
-            pr[i + j] = static_cast<limb_type>(carry & ~static_cast<limb_type>(0));
-#else
-            pr[i + j] = static_cast<limb_type>(carry);
-#endif
+         resize_for_carry(result, i + inner_limit + 1);  // May throw if checking is enabled
+         if(i + inner_limit < result.size())
+            pr[i + inner_limit] = carry;
       }
-      carry = 0;
    }
    result.normalize();
    //
@@ -177,7 +1422,7 @@ inline typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBit
 }
 
 template <unsigned MinBits1, unsigned MaxBits1, cpp_integer_type SignType1, cpp_int_check_type Checked1, class Allocator1, unsigned MinBits2, unsigned MaxBits2, cpp_integer_type SignType2, cpp_int_check_type Checked2, class Allocator2>
-BOOST_MP_FORCEINLINE typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
+BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR typename enable_if_c<!is_trivial_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value && !is_trivial_cpp_int<cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2> >::value >::type 
    eval_multiply(
       cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1>& result, 
       const cpp_int_backend<MinBits2, MaxBits2, SignType2, Checked2, Allocator2>& a) BOOST_MP_NOEXCEPT_IF((is_non_throwing_cpp_int<cpp_int_backend<MinBits1, MaxBits1, SignType1, Checked1, Allocator1> >::value))
@@ -0,0 +1,217 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_MP_CPP_INT_POOLED_ALLOCATOR_HPP
+#define BOOST_MP_CPP_INT_POOLED_ALLOCATOR_HPP
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/detail/bitscan.hpp>
+#include <boost/integer/static_log2.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+
+//
+// Blocks larger than this many bytes bypass the pool and go straight to operator new,
+// this must be a power of two:
+//
+#ifndef BOOST_MP_POOLED_ALLOCATOR_MAX_BLOCK_SIZE
+#define BOOST_MP_POOLED_ALLOCATOR_MAX_BLOCK_SIZE 65536
+#endif
+//
+// The number of free blocks each thread may hold on to in each size class, the rest are
+// returned to operator delete:
+//
+#ifndef BOOST_MP_POOLED_ALLOCATOR_MAX_FREE_BLOCKS
+#define BOOST_MP_POOLED_ALLOCATOR_MAX_FREE_BLOCKS 64
+#endif
+
+namespace boost{ namespace multiprecision{
+
+namespace detail{
+
+//
+// Memory is handed out in power of two size classes, from min_block_size up to
+// BOOST_MP_POOLED_ALLOCATOR_MAX_BLOCK_SIZE bytes.  Each thread has a free list per size
+// class, so the fast path is a push or pop on a thread local list and needs no locking.
+// A block freed on a different thread from the one that allocated it simply migrates
+// to the free lists of that thread.
+//
+struct block_pool
+{
+   static const std::size_t min_block_size = 32;
+   static const std::size_t max_block_size = BOOST_MP_POOLED_ALLOCATOR_MAX_BLOCK_SIZE;
+   static const unsigned    max_free_blocks = BOOST_MP_POOLED_ALLOCATOR_MAX_FREE_BLOCKS;
+   static const unsigned    size_classes = boost::static_log2<max_block_size / min_block_size>::value + 1;
+
+   BOOST_STATIC_ASSERT_MSG((max_block_size >= min_block_size) && !(max_block_size & (max_block_size - 1)), "BOOST_MP_POOLED_ALLOCATOR_MAX_BLOCK_SIZE must be a power of two and at least 32.");
+
+   struct free_block
+   {
+      free_block* next;
+   };
+
+   block_pool() BOOST_NOEXCEPT
+   {
+      for(unsigned i = 0; i < size_classes; ++i)
+      {
+         m_free[i] = 0;
+         m_count[i] = 0;
+      }
+   }
+   ~block_pool()
+   {
+      for(unsigned i = 0; i < size_classes; ++i)
+      {
+         while(m_free[i])
+         {
+            free_block* p = m_free[i];
+            m_free[i] = p->next;
+            ::operator delete(p);
+         }
+      }
+   }
+   static unsigned size_class(std::size_t bytes) BOOST_NOEXCEPT
+   {
+      return bytes <= min_block_size ? 0 : find_msb(bytes - 1) + 1 - boost::static_log2<min_block_size>::value;
+   }
+   static std::size_t block_size(unsigned c) BOOST_NOEXCEPT
+   {
+      return min_block_size << c;
+   }
+   void* allocate(unsigned c)
+   {
+      if(free_block* p = m_free[c])
+      {
+         m_free[c] = p->next;
+         --m_count[c];
+         return p;
+      }
+      return ::operator new(block_size(c));
+   }
+   void deallocate(void* p, unsigned c) BOOST_NOEXCEPT
+   {
+      if(m_count[c] < max_free_blocks)
+      {
+         free_block* b = static_cast<free_block*>(p);
+         b->next = m_free[c];
+         m_free[c] = b;
+         ++m_count[c];
+      }
+      else
+         ::operator delete(p);
+   }
+   unsigned free_blocks(unsigned c)const BOOST_NOEXCEPT
+   {
+      return m_count[c];
+   }
+
+private:
+   block_pool(const block_pool&);
+   block_pool& operator=(const block_pool&);
+
+   free_block* m_free[size_classes];
+   unsigned    m_count[size_classes];
+};
+
+//
+// The pool of the current thread is reached through a trivially destructible pointer, which is
+// cleared when the pool is destroyed at thread exit: any blocks freed after that point (for example
+// by thread local or static objects destroyed later) go straight back to operator delete.
+//
+inline block_pool*& current_block_pool() BOOST_NOEXCEPT
+{
+   static thread_local block_pool* p = 0;
+   return p;
+}
+
+struct block_pool_owner
+{
+   block_pool pool;
+   block_pool_owner() BOOST_NOEXCEPT { current_block_pool() = &pool; }
+   ~block_pool_owner() { current_block_pool() = 0; }
+};
+
+inline block_pool* thread_block_pool()
+{
+   block_pool* p = current_block_pool();
+   if(!p)
+   {
+      // Constructed at most once per thread, after destruction p stays null:
+      static thread_local block_pool_owner owner;
+      p = current_block_pool();
+   }
+   return p;
+}
+
+} // namespace detail
+
+//
+// A stateless allocator for use as the Allocator parameter of cpp_int_backend (or anything else
+// which allocates arrays of trivial types), which recycles memory through the per-thread pool above:
+//
+template <class T>
+class pooled_allocator
+{
+public:
+   typedef T           value_type;
+   typedef std::size_t size_type;
+
+   template <class U>
+   struct rebind
+   {
+      typedef pooled_allocator<U> other;
+   };
+
+   pooled_allocator() BOOST_NOEXCEPT {}
+   template <class U>
+   pooled_allocator(const pooled_allocator<U>&) BOOST_NOEXCEPT {}
+
+   T* allocate(std::size_t n)
+   {
+      if(n > (std::numeric_limits<std::size_t>::max)() / sizeof(T))
+         BOOST_THROW_EXCEPTION(std::bad_alloc());
+      std::size_t bytes = n * sizeof(T);
+      if(bytes > detail::block_pool::max_block_size)
+         return static_cast<T*>(::operator new(bytes));
+      unsigned c = detail::block_pool::size_class(bytes);
+      detail::block_pool* pool = detail::thread_block_pool();
+      return static_cast<T*>(pool ? pool->allocate(c) : ::operator new(detail::block_pool::block_size(c)));
+   }
+   void deallocate(T* p, std::size_t n) BOOST_NOEXCEPT
+   {
+      std::size_t bytes = n * sizeof(T);
+      detail::block_pool* pool = bytes > detail::block_pool::max_block_size ? 0 : detail::current_block_pool();
+      if(pool)
+         pool->deallocate(p, detail::block_pool::size_class(bytes));
+      else
+         ::operator delete(p);
+   }
+};
+
+template <class T, class U>
+inline bool operator==(const pooled_allocator<T>&, const pooled_allocator<U>&) BOOST_NOEXCEPT
+{
+   return true;
+}
+template <class T, class U>
+inline bool operator!=(const pooled_allocator<T>&, const pooled_allocator<U>&) BOOST_NOEXCEPT
+{
+   return false;
+}
+
+// Arbitrary precision types which recycle their memory through a per-thread pool:
+typedef number<cpp_int_backend<0, 0, signed_magnitude, unchecked, pooled_allocator<limb_type> > >   pooled_cpp_int;
+typedef rational_adaptor<cpp_int_backend<0, 0, signed_magnitude, unchecked, pooled_allocator<limb_type> > > pooled_cpp_rational_backend;
+typedef number<pooled_cpp_rational_backend>                                                       pooled_cpp_rational;
+
+}} // namespaces
+
+#endif // BOOST_MP_USING_THREAD_LOCAL
+
+#endif
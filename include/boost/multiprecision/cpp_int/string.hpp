@@ -0,0 +1,316 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+//
+// Conversion of cpp_int_backend to and from strings:
+//
+#ifndef BOOST_MP_CPP_INT_STRING_HPP
+#define BOOST_MP_CPP_INT_STRING_HPP
+
+#include <vector>
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+//
+// Converting to decimal one block of digits_per_block_10 digits at a time takes one pass over the
+// value per block, so is quadratic in the number of digits.  Above BOOST_MP_DC_STRING_CUTOFF limbs we
+// instead divide by 10^(digits_per_block_10 * 2^k), for k chosen so that the quotient and remainder
+// are about the same size, and convert both halves recursively.  The powers of ten are computed once,
+// by repeated squaring, and shared by the whole recursion, and since the divisions go through
+// the recursive division routines the conversion costs a small multiple of a multiplication:
+//
+#ifndef BOOST_MP_DC_STRING_CUTOFF
+#define BOOST_MP_DC_STRING_CUTOFF 40
+#endif
+
+static const unsigned dc_string_cutoff = BOOST_MP_DC_STRING_CUTOFF;
+
+BOOST_STATIC_ASSERT_MSG(BOOST_MP_DC_STRING_CUTOFF >= 2, "BOOST_MP_DC_STRING_CUTOFF is too small for the recursion to terminate.");
+
+namespace detail{
+//
+// Writes the least significant width decimal digits of the n limb value p to the width characters
+// ending at last, zero padded.  p is destroyed:
+//
+inline void decimal_digits_basecase(limb_type* p, unsigned n, char* last, std::size_t width) BOOST_NOEXCEPT
+{
+   const divisor d(max_block_10);
+   while(n && !p[n - 1])
+      --n;
+   while(width)
+   {
+      //
+      // Divide by max_block_10 in place, and output the remainder:
+      //
+      limb_type r = n ? divide_limbs_by_limb(p, n, p, n, d) : 0;
+      while(n && !p[n - 1])
+         --n;
+      for(unsigned i = 0; (i < digits_per_block_10) && width; ++i, --width)
+      {
+         *--last = static_cast<char>('0' + r % 10);
+         r /= 10;
+      }
+   }
+}
+//
+// Writes the decimal digits of x < powers[k]^2 to the digits_per_block_10 * 2^(k+1) characters ending
+// at last, zero padded.  x is destroyed:
+//
+template <class Int, class Alloc>
+void decimal_digits(Int& x, const std::vector<Int, Alloc>& powers, unsigned k, char* last)
+{
+   std::size_t width = static_cast<std::size_t>(digits_per_block_10) << (k + 1);
+   if(!k || (x.size() < dc_string_cutoff))
+   {
+      decimal_digits_basecase(x.limbs(), x.size(), last, width);
+      return;
+   }
+   Int q, r;
+   divide_unsigned_helper(&q, x, powers[k], r);
+   decimal_digits(r, powers, k - 1, last);
+   decimal_digits(q, powers, k - 1, last - width / 2);
+}
+//
+// Sets result to the decimal digits of |x|, possibly with leading zeros.  The working copies of x
+// and the powers of ten all come from the workspace if one is bound, and otherwise from the
+// allocator of x:
+//
+template <class CppInt>
+void decimal_string(std::string& result, const CppInt& x)
+{
+   typedef typename workspace_int<CppInt>::type int_type;
+   if(x.size() < dc_string_cutoff)
+   {
+      // Room for the digits of a value of x.size() limbs, since log10(2) < 1/3:
+      std::size_t width = static_cast<std::size_t>(x.size()) * (sizeof(limb_type) * CHAR_BIT) / 3 + 1;
+      typename scratch_int<CppInt>::type t(x);
+      result.assign(width, '0');
+      decimal_digits_basecase(t.limbs(), t.size(), &result[0] + width, width);
+      return;
+   }
+   int_type t(x), sq;
+   t.sign(false);
+   std::vector<int_type, typename rebind<int_type, typename int_type::allocator_type>::type> powers(1);
+   powers[0] = max_block_10;
+   while(true)
+   {
+      eval_multiply(sq, powers.back(), powers.back());
+      if(sq.compare(t) > 0)
+         break;
+      powers.push_back(sq);
+   }
+   std::size_t width = static_cast<std::size_t>(digits_per_block_10) << powers.size();
+   result.assign(width, '0');
+   decimal_digits(t, powers, static_cast<unsigned>(powers.size() - 1), &result[0] + width);
+}
+
+//
+// Parsing is the reverse: the decimal digits are split into a low part of digits_per_block_10 * 2^k
+// digits and a high part of no more digits than that, each half is converted recursively, and
+// the result is high * 10^(digits_per_block_10 * 2^k) + low.  Hex and octal digits are just packed
+// into the limbs directly:
+//
+template <class CppInt>
+void decimal_from_digits_basecase(CppInt& result, const char* s, std::size_t n)
+{
+   using default_ops::eval_multiply;
+   using default_ops::eval_add;
+   result = static_cast<limb_type>(0u);
+   while(n)
+   {
+      unsigned len = static_cast<unsigned>((std::min)(n, static_cast<std::size_t>(digits_per_block_10)));
+      limb_type block = 0;
+      for(unsigned i = 0; i < len; ++i, ++s)
+      {
+         if((*s < '0') || (*s > '9'))
+            BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected character encountered in input."));
+         block *= 10;
+         block += static_cast<limb_type>(*s - '0');
+      }
+      eval_multiply(result, block_multiplier(len - 1));
+      eval_add(result, block);
+      n -= len;
+   }
+}
+//
+// Sets result to the value of the n <= digits_per_block_10 * 2^(k+1) decimal digits at s:
+//
+template <class Int, class Alloc>
+void decimal_from_digits(Int& result, const char* s, std::size_t n, const std::vector<Int, Alloc>& powers, unsigned k)
+{
+   if(n <= static_cast<std::size_t>(digits_per_block_10) * dc_string_cutoff)
+   {
+      decimal_from_digits_basecase(result, s, n);
+      return;
+   }
+   while(k && (static_cast<std::size_t>(digits_per_block_10) << k) >= n)
+      --k;
+   std::size_t low_digits = static_cast<std::size_t>(digits_per_block_10) << k;
+   Int high, low;
+   decimal_from_digits(high, s, n - low_digits, powers, k);
+   decimal_from_digits(low, s + n - low_digits, low_digits, powers, k);
+   eval_multiply(result, high, powers[k]);
+   eval_add(result, low);
+}
+//
+// Sets result to the value of the decimal digit string s.  The value is built up in a working copy,
+// from the workspace if one is bound and otherwise from the allocator of result, so result is left
+// unchanged if s is invalid:
+//
+template <class CppInt>
+void assign_decimal_string(CppInt& result, const char* s)
+{
+   typedef typename workspace_int<CppInt>::type int_type;
+   std::size_t n = std::strlen(s);
+   if(n <= static_cast<std::size_t>(digits_per_block_10) * dc_string_cutoff)
+   {
+      typename scratch_int<CppInt>::type t;
+      decimal_from_digits_basecase(t, s, n);
+      result = t;
+      return;
+   }
+   std::vector<int_type, typename rebind<int_type, typename int_type::allocator_type>::type> powers(1);
+   powers[0] = max_block_10;
+   while((static_cast<std::size_t>(digits_per_block_10) << powers.size()) < n)
+   {
+      powers.push_back(int_type());
+      eval_multiply(powers.back(), powers[powers.size() - 2], powers[powers.size() - 2]);
+   }
+   int_type t;
+   decimal_from_digits(t, s, n, powers, static_cast<unsigned>(powers.size() - 1));
+   result = t;
+}
+//
+// Sets result to the value of the hex (digit_bits == 4) or octal (digit_bits == 3) digit string s,
+// filling each limb in a register starting from the least significant digit:
+//
+inline limb_type power_of_two_digit_value(char c, unsigned digit_bits)
+{
+   limb_type val;
+   if((c >= '0') && (c <= '9'))
+      val = c - '0';
+   else if((c >= 'a') && (c <= 'f'))
+      val = 10 + c - 'a';
+   else if((c >= 'A') && (c <= 'F'))
+      val = 10 + c - 'A';
+   else
+      val = 16;
+   if(val >> digit_bits)
+      BOOST_THROW_EXCEPTION(std::runtime_error("Unexpected content found while parsing character string."));
+   return val;
+}
+
+template <class CppInt>
+void assign_power_of_two_string(CppInt& result, const char* s, unsigned digit_bits)
+{
+   while(*s == '0')
+      ++s;
+   std::size_t n = std::strlen(s);
+   if(!n)
+   {
+      result = static_cast<limb_type>(0u);
+      return;
+   }
+   // Only as many limbs as the value needs, checked types throw if that's too many:
+   std::size_t bits = (n - 1) * digit_bits + boost::multiprecision::detail::find_msb(power_of_two_digit_value(*s, digit_bits)) + 1;
+   std::size_t newsize = (bits + bits_per_limb - 1) / bits_per_limb;
+   result.resize(static_cast<unsigned>(newsize), static_cast<unsigned>(newsize));
+   typename CppInt::limb_pointer p = result.limbs();
+   unsigned size = result.size();
+   unsigned limb = 0, shift = 0;
+   limb_type acc = 0;
+   for(const char* i = s + n; i != s;)
+   {
+      // Digits beyond the end of a fixed precision type are dropped, but still validated:
+      limb_type val = power_of_two_digit_value(*--i, digit_bits);
+      acc |= val << shift;
+      shift += digit_bits;
+      if(shift >= bits_per_limb)
+      {
+         if(limb < size)
+            p[limb] = acc;
+         ++limb;
+         shift -= bits_per_limb;
+         acc = shift ? val >> (digit_bits - shift) : 0;
+      }
+   }
+   if(limb < size)
+      p[limb++] = acc;
+   while(limb < size)
+      p[limb++] = 0;
+   result.normalize();
+}
+
+//
+// Hex and octal output unpacks digit_bits at a time from a register holding the current limb, starting
+// from the least significant digit, so the whole conversion is a single pass over the limbs:
+//
+template <class CppInt>
+void power_of_two_string(std::string& result, const CppInt& x, unsigned digit_bits)
+{
+   typename CppInt::const_limb_pointer p = x.limbs();
+   unsigned n = x.size();
+   std::size_t bits = static_cast<std::size_t>(n - 1) * bits_per_limb + (p[n - 1] ? boost::multiprecision::detail::find_msb(p[n - 1]) + 1 : 1);
+   std::size_t digits = (bits + digit_bits - 1) / digit_bits;
+   limb_type mask = (static_cast<limb_type>(1u) << digit_bits) - 1;
+   result.assign(digits, '0');
+   std::string::iterator pos = result.end();
+   limb_type acc = 0;
+   unsigned avail = 0, limb = 0;
+   for(std::size_t i = 0; i < digits; ++i)
+   {
+      limb_type val;
+      if(avail >= digit_bits)
+      {
+         val = acc & mask;
+         acc >>= digit_bits;
+         avail -= digit_bits;
+      }
+      else
+      {
+         // Take the low bits of the digit from what's left of this limb, and the rest from the next one:
+         limb_type next = limb < n ? p[limb] : 0;
+         ++limb;
+         val = (acc | (next << avail)) & mask;
+         acc = next >> (digit_bits - avail);
+         avail += bits_per_limb - digit_bits;
+      }
+      *--pos = "0123456789ABCDEF"[val];
+   }
+}
+//
+// Replaces x by its two's complement in the precision of the type, so that negative values of types with
+// modulo arithmetic can be output in hex or octal.  Other types have no natural width to complement in:
+//
+template <class CppInt>
+void twos_complement(CppInt& x, const mpl::true_&)
+{
+   static const unsigned max_bits = max_precision<CppInt>::value;
+   static const unsigned max_limbs = max_bits / bits_per_limb + ((max_bits % bits_per_limb) ? 1 : 0);
+   unsigned n = x.size();
+   x.resize(max_limbs, max_limbs);
+   typename CppInt::limb_pointer p = x.limbs();
+   std::fill(p + n, p + max_limbs, static_cast<limb_type>(0u));
+   limb_type carry = 1;
+   for(unsigned i = 0; i < max_limbs; ++i)
+   {
+      p[i] = ~p[i] + carry;
+      carry = carry && !p[i];
+   }
+   if(max_bits % bits_per_limb)
+      p[max_limbs - 1] &= (static_cast<limb_type>(1u) << (max_bits % bits_per_limb)) - 1;
+   x.sign(false);
+   x.normalize();
+}
+template <class CppInt>
+void twos_complement(CppInt&, const mpl::false_&)
+{
+   BOOST_THROW_EXCEPTION(std::runtime_error("Base 8 or 16 printing of negative numbers is not supported."));
+}
+
+} // namespace detail
+
+}}} // namespaces
+
+#endif
@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+//
+// Arithmetic on fixed precision cpp_int's with the loops over the limbs unrolled at compile time:
+//
+#ifndef BOOST_MP_CPP_INT_UNROLLED_KERNELS_HPP
+#define BOOST_MP_CPP_INT_UNROLLED_KERNELS_HPP
+
+#include <boost/multiprecision/cpp_int/intel_intrinsics.hpp>
+
+namespace boost{ namespace multiprecision{ namespace backends{
+
+//
+// Unchecked fixed precision types of up to BOOST_MP_MAX_UNROLLED_LIMBS limbs (so uint256_t, uint512_t
+// and uint1024_t with 64-bit limbs) add, subtract and multiply over all of their limbs with straight
+// line code: the operands are zero extended to the full width, the carries run off the top, and the
+// truncation to the precision of the type comes for free.  There's then no need to find out which
+// operand is longer, or to compare magnitudes before subtracting, or to resize as carries propagate.
+// Larger types would only trade code size for fewer loop counters, so use the generic routines:
+//
+#ifndef BOOST_MP_MAX_UNROLLED_LIMBS
+#define BOOST_MP_MAX_UNROLLED_LIMBS 16
+#endif
+
+static const unsigned max_unrolled_limbs = BOOST_MP_MAX_UNROLLED_LIMBS;
+
+template <class CppInt>
+struct is_unrolled_cpp_int : public mpl::false_ {};
+
+template <unsigned Bits, cpp_integer_type SignType>
+struct is_unrolled_cpp_int<cpp_int_backend<Bits, Bits, SignType, unchecked, void> >
+   : public mpl::bool_<!is_trivial_cpp_int<cpp_int_backend<Bits, Bits, SignType, unchecked, void> >::value
+      && (Bits <= max_unrolled_limbs * sizeof(limb_type) * CHAR_BIT)> {};
+
+namespace detail{
+
+//
+// Each of these handles limb I of N, and then hands on to limb I + 1, the specializations
+// for I == N end the recursion:
+//
+template <unsigned I, unsigned N, bool done = (I >= N)>
+struct unrolled_limbs
+{
+   //
+   // Copies the first size limbs of p to r, and zeros the rest:
+   //
+   static BOOST_MP_FORCEINLINE void load(limb_type* pr, const limb_type* p, unsigned size) BOOST_NOEXCEPT
+   {
+      pr[I] = I < size ? p[I] : 0;
+      unrolled_limbs<I + 1, N>::load(pr, p, size);
+   }
+#ifdef BOOST_MP_HAS_INTEL_INTRINSICS
+   static BOOST_MP_FORCEINLINE unsigned char add(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned char carry) BOOST_NOEXCEPT
+   {
+      carry = multiprecision::detail::addcarry_limb(carry, pa[I], pb[I], pr + I);
+      return unrolled_limbs<I + 1, N>::add(pr, pa, pb, carry);
+   }
+   static BOOST_MP_FORCEINLINE unsigned char subtract(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned char borrow) BOOST_NOEXCEPT
+   {
+      borrow = multiprecision::detail::subborrow_limb(borrow, pa[I], pb[I], pr + I);
+      return unrolled_limbs<I + 1, N>::subtract(pr, pa, pb, borrow);
+   }
+   static BOOST_MP_FORCEINLINE void negate(limb_type* pr, unsigned char borrow) BOOST_NOEXCEPT
+   {
+      borrow = multiprecision::detail::subborrow_limb(borrow, 0, pr[I], pr + I);
+      unrolled_limbs<I + 1, N>::negate(pr, borrow);
+   }
+#else
+   static BOOST_MP_FORCEINLINE unsigned char add(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned char carry) BOOST_NOEXCEPT
+   {
+      double_limb_type t = static_cast<double_limb_type>(pa[I]) + static_cast<double_limb_type>(pb[I]) + carry;
+      pr[I] = static_cast<limb_type>(t);
+      return unrolled_limbs<I + 1, N>::add(pr, pa, pb, static_cast<unsigned char>(t >> (sizeof(limb_type) * CHAR_BIT)));
+   }
+   static BOOST_MP_FORCEINLINE unsigned char subtract(limb_type* pr, const limb_type* pa, const limb_type* pb, unsigned char borrow) BOOST_NOEXCEPT
+   {
+      double_limb_type t = static_cast<double_limb_type>(pa[I]) - static_cast<double_limb_type>(pb[I]) - borrow;
+      pr[I] = static_cast<limb_type>(t);
+      return unrolled_limbs<I + 1, N>::subtract(pr, pa, pb, static_cast<unsigned char>((t >> (sizeof(limb_type) * CHAR_BIT)) & 1u));
+   }
+   static BOOST_MP_FORCEINLINE void negate(limb_type* pr, unsigned char borrow) BOOST_NOEXCEPT
+   {
+      double_limb_type t = static_cast<double_limb_type>(0u) - static_cast<double_limb_type>(pr[I]) - borrow;
+      pr[I] = static_cast<limb_type>(t);
+      unrolled_limbs<I + 1, N>::negate(pr, static_cast<unsigned char>((t >> (sizeof(limb_type) * CHAR_BIT)) & 1u));
+   }
+#endif
+};
+
+template <unsigned I, unsigned N>
+struct unrolled_limbs<I, N, true>
+{
+   static BOOST_MP_FORCEINLINE void load(limb_type*, const limb_type*, unsigned) BOOST_NOEXCEPT {}
+   static BOOST_MP_FORCEINLINE unsigned char add(limb_type*, const limb_type*, const limb_type*, unsigned char carry) BOOST_NOEXCEPT { return carry; }
+   static BOOST_MP_FORCEINLINE unsigned char subtract(limb_type*, const limb_type*, const limb_type*, unsigned char borrow) BOOST_NOEXCEPT { return borrow; }
+   static BOOST_MP_FORCEINLINE void negate(limb_type*, unsigned char) BOOST_NOEXCEPT {}
+};
+
+//
+// Row I of the long multiplication r = a * b mod 2^(N * bits_per_limb), adds a[I] * b[J] for
+// I + J < N into r[I + J].  The first row sets r rather than adding to it, and the last product of
+// each row only needs its low half:
+//
+template <unsigned I, unsigned J, unsigned N, int state = (I + J + 1 < N ? 0 : I + J + 1 == N ? 1 : 2)>
+struct unrolled_multiply_row
+{
+   static BOOST_MP_FORCEINLINE void apply(limb_type* pr, const limb_type* pa, const limb_type* pb, double_limb_type carry) BOOST_NOEXCEPT
+   {
+      carry += static_cast<double_limb_type>(pa[I]) * static_cast<double_limb_type>(pb[J]);
+      if(I)
+         carry += pr[I + J];
+      pr[I + J] = static_cast<limb_type>(carry);
+      unrolled_multiply_row<I, J + 1, N>::apply(pr, pa, pb, carry >> (sizeof(limb_type) * CHAR_BIT));
+   }
+};
+template <unsigned I, unsigned J, unsigned N>
+struct unrolled_multiply_row<I, J, N, 1>
+{
+   static BOOST_MP_FORCEINLINE void apply(limb_type* pr, const limb_type* pa, const limb_type* pb, double_limb_type carry) BOOST_NOEXCEPT
+   {
+      limb_type r = static_cast<limb_type>(pa[I] * pb[J] + static_cast<limb_type>(carry));
+      pr[I + J] = I ? static_cast<limb_type>(pr[I + J] + r) : r;
+   }
+};
+
+template <unsigned I, unsigned N, bool done = (I >= N)>
+struct unrolled_multiply
+{
+   static BOOST_MP_FORCEINLINE void apply(limb_type* pr, const limb_type* pa, const limb_type* pb) BOOST_NOEXCEPT
+   {
+      unrolled_multiply_row<I, 0, N>::apply(pr, pa, pb, 0);
+      unrolled_multiply<I + 1, N>::apply(pr, pa, pb);
+   }
+};
+template <unsigned I, unsigned N>
+struct unrolled_multiply<I, N, true>
+{
+   static BOOST_MP_FORCEINLINE void apply(limb_type*, const limb_type*, const limb_type*) BOOST_NOEXCEPT {}
+};
+
+//
+// The front ends, all of which zero extend the operands to N limbs.  r may alias a or b, the
+// carry or borrow out of the top limb is returned where there is one:
+//
+template <unsigned N>
+BOOST_MP_FORCEINLINE bool unrolled_add(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   limb_type a[N], b[N];
+   unrolled_limbs<0, N>::load(a, pa, as);
+   unrolled_limbs<0, N>::load(b, pb, bs);
+   return unrolled_limbs<0, N>::add(pr, a, b, 0);
+}
+template <unsigned N>
+BOOST_MP_FORCEINLINE bool unrolled_subtract(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   limb_type a[N], b[N];
+   unrolled_limbs<0, N>::load(a, pa, as);
+   unrolled_limbs<0, N>::load(b, pb, bs);
+   return unrolled_limbs<0, N>::subtract(pr, a, b, 0);
+}
+template <unsigned N>
+BOOST_MP_FORCEINLINE void unrolled_negate(limb_type* pr) BOOST_NOEXCEPT
+{
+   unrolled_limbs<0, N>::negate(pr, 0);
+}
+template <unsigned N>
+BOOST_MP_FORCEINLINE void unrolled_multiply_truncated(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   limb_type a[N], b[N];
+   unrolled_limbs<0, N>::load(a, pa, as);
+   unrolled_limbs<0, N>::load(b, pb, bs);
+   unrolled_multiply<0, N>::apply(pr, a, b);
+}
+
+#ifdef BOOST_HAS_INT128
+//
+// With 64-bit limbs, a 256-bit truncated product is best treated as a 2x2 product of __int128 halves:
+// only the low * low product needs all of its 256 bits, so that's the one built from widening
+// limb multiplies, while the cross products are wanted modulo 2^128 and are left to the compiler's
+// native __int128 multiply.  The high * high product drops off the top altogether:
+//
+template <>
+BOOST_MP_FORCEINLINE void unrolled_multiply_truncated<4>(limb_type* pr, const limb_type* pa, unsigned as, const limb_type* pb, unsigned bs) BOOST_NOEXCEPT
+{
+   static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+   limb_type a[4], b[4];
+   unrolled_limbs<0, 4>::load(a, pa, as);
+   unrolled_limbs<0, 4>::load(b, pb, bs);
+   double_limb_type p00 = static_cast<double_limb_type>(a[0]) * b[0];
+   double_limb_type p01 = static_cast<double_limb_type>(a[0]) * b[1];
+   double_limb_type p10 = static_cast<double_limb_type>(a[1]) * b[0];
+   double_limb_type p11 = static_cast<double_limb_type>(a[1]) * b[1];
+   double_limb_type mid = (p00 >> limb_bits) + static_cast<limb_type>(p01) + static_cast<limb_type>(p10);
+   double_limb_type a_lo = a[0] | (static_cast<double_limb_type>(a[1]) << limb_bits);
+   double_limb_type a_hi = a[2] | (static_cast<double_limb_type>(a[3]) << limb_bits);
+   double_limb_type b_lo = b[0] | (static_cast<double_limb_type>(b[1]) << limb_bits);
+   double_limb_type b_hi = b[2] | (static_cast<double_limb_type>(b[3]) << limb_bits);
+   double_limb_type hi = p11 + (p01 >> limb_bits) + (p10 >> limb_bits) + (mid >> limb_bits) + a_lo * b_hi + a_hi * b_lo;
+   pr[0] = static_cast<limb_type>(p00);
+   pr[1] = static_cast<limb_type>(mid);
+   pr[2] = static_cast<limb_type>(hi);
+   pr[3] = static_cast<limb_type>(hi >> limb_bits);
+}
+#endif
+
+} // namespace detail
+
+}}} // namespaces
+
+#endif
@@ -0,0 +1,278 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_MP_CPP_INT_WORKSPACE_HPP
+#define BOOST_MP_CPP_INT_WORKSPACE_HPP
+
+#include <boost/multiprecision/detail/number_base.hpp>
+#include <boost/multiprecision/cpp_int/cpp_int_config.hpp>
+#include <boost/multiprecision/detail/rebind.hpp>
+#include <boost/throw_exception.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+
+namespace boost{ namespace multiprecision{
+
+namespace detail{
+
+union workspace_max_align
+{
+   long double      ld;
+   double_limb_type dl;
+   void*            p;
+   void           (*pf)();
+};
+
+} // namespace detail
+
+//
+// Scratch memory for the temporaries of the heavy cpp_int operations: the recursive multiplication
+// and division routines, gcd, powm and conversion to and from decimal strings.  While a workspace
+// is bound to the current thread (see workspace_binding below) those temporaries are carved out of
+// a single block owned by the workspace, rather than allocated one by one.
+//
+// The block is used as a stack: each allocation goes on top and is followed by a footer holding
+// its size, and freeing the top allocation pops it along with any allocations beneath it which
+// have already been freed.  Temporaries never outlive the operation which creates them, so the
+// stack is empty again whenever a top level operation returns.  A request which doesn't fit is
+// passed on to the usual allocator instead, but the workspace remembers the largest amount of
+// memory it was asked for, and the next time a request finds the stack empty the block is
+// replaced by one large enough for that: so after the first few iterations of a loop the block
+// is big enough for everything, and the loop makes no allocations at all.
+//
+class workspace
+{
+public:
+   static const std::size_t alignment = sizeof(detail::workspace_max_align);
+
+   explicit workspace(std::size_t bytes = 0) : m_data(0), m_capacity(0), m_top(0), m_peak(0)
+   {
+      reserve(bytes);
+   }
+   ~workspace()
+   {
+      BOOST_ASSERT(!m_top);
+      ::operator delete(m_data);
+   }
+   //
+   // Makes the block at least bytes long, immediately if nothing is allocated from it, otherwise
+   // once everything has been freed:
+   //
+   void reserve(std::size_t bytes)
+   {
+      if(bytes > m_peak)
+         m_peak = bytes;
+      if(!m_top && (m_peak > m_capacity))
+         reallocate(m_peak);
+   }
+   std::size_t capacity()const BOOST_NOEXCEPT { return m_capacity; }
+   std::size_t used()const BOOST_NOEXCEPT { return m_top; }
+   //
+   // Low level interface, returns a pointer aligned for any type, or null if the request can't be
+   // satisfied from the block:
+   //
+   void* allocate(std::size_t bytes)
+   {
+      if(bytes > (std::numeric_limits<std::size_t>::max)() / 2)
+         return 0;
+      std::size_t size = allocation_size(bytes);
+      if(m_top + size > m_peak)
+         m_peak = m_top + size;
+      if(m_peak > m_capacity)
+      {
+         if(m_top)
+            return 0;
+         // The stack is empty, so this is the time to grow, by at least half as much again:
+         reallocate((std::max)(m_peak, m_capacity + m_capacity / 2));
+      }
+      void* p = m_data + m_top;
+      m_top += size;
+      footer(m_top) = size;
+      return p;
+   }
+   void deallocate(void* p, std::size_t bytes) BOOST_NOEXCEPT
+   {
+      BOOST_ASSERT(owns(p));
+      std::size_t end = static_cast<std::size_t>(static_cast<char*>(p) - m_data) + allocation_size(bytes);
+      BOOST_ASSERT((end <= m_top) && !(footer(end) & 1u));
+      // Mark as free by setting the low bit of the size, which is otherwise a multiple of the alignment:
+      footer(end) |= 1u;
+      while(m_top && (footer(m_top) & 1u))
+         m_top -= footer(m_top) & ~static_cast<std::size_t>(1u);
+   }
+   bool owns(const void* p)const BOOST_NOEXCEPT
+   {
+      return m_data && (static_cast<const char*>(p) >= m_data) && (static_cast<const char*>(p) < m_data + m_capacity);
+   }
+
+private:
+   workspace(const workspace&);
+   workspace& operator=(const workspace&);
+
+   static std::size_t allocation_size(std::size_t bytes) BOOST_NOEXCEPT
+   {
+      return (bytes + alignment - 1) / alignment * alignment + alignment;
+   }
+   std::size_t& footer(std::size_t end)const BOOST_NOEXCEPT
+   {
+      return *static_cast<std::size_t*>(static_cast<void*>(m_data + end - alignment));
+   }
+   void reallocate(std::size_t bytes)
+   {
+      BOOST_ASSERT(!m_top);
+      bytes = (bytes + alignment - 1) / alignment * alignment;
+      char* p = static_cast<char*>(::operator new(bytes));
+      ::operator delete(m_data);
+      m_data = p;
+      m_capacity = bytes;
+   }
+
+   char*       m_data;
+   std::size_t m_capacity;
+   std::size_t m_top;
+   std::size_t m_peak;
+};
+
+//
+// Binds a workspace to the current thread for the lifetime of the binding, bindings may nest and
+// the previous workspace is restored on destruction.  A workspace must outlive its bindings, and
+// may only be bound to one thread at a time.  Without thread_local support bindings have no effect:
+//
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+
+namespace detail{
+
+inline workspace*& current_workspace_ref() BOOST_NOEXCEPT
+{
+   static thread_local workspace* p = 0;
+   return p;
+}
+
+} // namespace detail
+
+inline workspace* current_workspace() BOOST_NOEXCEPT
+{
+   return detail::current_workspace_ref();
+}
+
+class workspace_binding
+{
+public:
+   explicit workspace_binding(workspace& w) BOOST_NOEXCEPT : m_previous(detail::current_workspace_ref())
+   {
+      detail::current_workspace_ref() = &w;
+   }
+   ~workspace_binding()
+   {
+      detail::current_workspace_ref() = m_previous;
+   }
+
+private:
+   workspace_binding(const workspace_binding&);
+   workspace_binding& operator=(const workspace_binding&);
+
+   workspace* m_previous;
+};
+
+#else
+
+inline workspace* current_workspace() BOOST_NOEXCEPT
+{
+   return 0;
+}
+
+class workspace_binding
+{
+public:
+   explicit workspace_binding(workspace&) BOOST_NOEXCEPT {}
+
+private:
+   workspace_binding(const workspace_binding&);
+   workspace_binding& operator=(const workspace_binding&);
+};
+
+#endif
+
+namespace detail{
+
+//
+// The allocator for temporaries inside the library: memory comes from the workspace bound to the
+// current thread if there is one and it has room, and otherwise from Allocator, which is the
+// allocator of the value the temporaries are working on.  Since the binding can't change during
+// an operation, memory from the workspace goes back to it.  Values using this allocator must not
+// outlive the operation which created them:
+//
+template <class T, class Allocator = std::allocator<T> >
+class workspace_allocator : public Allocator
+{
+public:
+   typedef T           value_type;
+   typedef std::size_t size_type;
+
+   template <class U>
+   struct rebind
+   {
+      typedef workspace_allocator<U, typename backends::detail::rebind<U, Allocator>::type> other;
+   };
+
+#ifdef BOOST_NO_CXX11_ALLOCATOR
+   typedef T*             pointer;
+   typedef const T*       const_pointer;
+   typedef T&             reference;
+   typedef const T&       const_reference;
+   typedef std::ptrdiff_t difference_type;
+
+   void construct(pointer p, const T& val) { ::new(static_cast<void*>(p)) T(val); }
+   void destroy(pointer p) { p->~T(); }
+   size_type max_size()const BOOST_NOEXCEPT { return (std::numeric_limits<std::size_t>::max)() / sizeof(T); }
+#endif
+
+   workspace_allocator() {}
+   workspace_allocator(const Allocator& a) : Allocator(a) {}
+   template <class U, class Allocator2>
+   workspace_allocator(const workspace_allocator<U, Allocator2>& a) : Allocator(a.base()) {}
+
+   T* allocate(std::size_t n)
+   {
+      if(n > (std::numeric_limits<std::size_t>::max)() / sizeof(T))
+         BOOST_THROW_EXCEPTION(std::bad_alloc());
+      if(workspace* w = current_workspace())
+      {
+         if(void* p = w->allocate(n * sizeof(T)))
+            return static_cast<T*>(p);
+      }
+      return Allocator::allocate(n);
+   }
+   void deallocate(T* p, std::size_t n)
+   {
+      workspace* w = current_workspace();
+      if(w && w->owns(p))
+         w->deallocate(p, n * sizeof(T));
+      else
+         Allocator::deallocate(p, n);
+   }
+
+   const Allocator& base()const BOOST_NOEXCEPT { return *this; }
+};
+
+template <class T, class Allocator, class U, class Allocator2>
+inline bool operator==(const workspace_allocator<T, Allocator>& a, const workspace_allocator<U, Allocator2>& b)
+{
+   return a.base() == b.base();
+}
+template <class T, class Allocator, class U, class Allocator2>
+inline bool operator!=(const workspace_allocator<T, Allocator>& a, const workspace_allocator<U, Allocator2>& b)
+{
+   return !(a == b);
+}
+
+} // namespace detail
+
+}} // namespaces
+
+#endif
@@ -422,6 +422,14 @@ inline void eval_multiply(T& t, const U& u, const V& v)
 {
    eval_multiply_default(t, u, v);
 }
+//
+// Squaring, backends which can do better than a general multiplication overload this:
+//
+template <class T, class U>
+inline void eval_square(T& result, const U& a)
+{
+   eval_multiply(result, a, a);
+}
 
 template <class T>
 inline void eval_multiply_add(T& t, const T& u, const T& v, const T& x)
@@ -621,10 +629,10 @@ inline void eval_modulus(T& t, const U& u, const V& v)
 }
 
 template <class T, class U, class V>
-void eval_bitwise_and(T& t, const U& u, const V& v);
+BOOST_CXX14_CONSTEXPR void eval_bitwise_and(T& t, const U& u, const V& v);
 
 template <class T>
-inline void eval_bitwise_and_default(T& t, const T& u, const T& v)
+inline BOOST_CXX14_CONSTEXPR void eval_bitwise_and_default(T& t, const T& u, const T& v)
 {
    if(&t == &v)
    {
@@ -665,16 +673,16 @@ inline typename disable_if_c<is_same<T, U>::value || is_same<T, V>::value>::type
    eval_bitwise_and(t, v);
 }
 template <class T, class U, class V>
-inline void eval_bitwise_and(T& t, const U& u, const V& v)
+inline BOOST_CXX14_CONSTEXPR void eval_bitwise_and(T& t, const U& u, const V& v)
 {
    eval_bitwise_and_default(t, u, v);
 }
 
 template <class T, class U, class V>
-void eval_bitwise_or(T& t, const U& u, const V& v);
+BOOST_CXX14_CONSTEXPR void eval_bitwise_or(T& t, const U& u, const V& v);
 
 template <class T>
-inline void eval_bitwise_or_default(T& t, const T& u, const T& v)
+inline BOOST_CXX14_CONSTEXPR void eval_bitwise_or_default(T& t, const T& u, const T& v)
 {
    if(&t == &v)
    {
@@ -722,16 +730,16 @@ inline void eval_bitwise_or_default(T& t, const U& u, const V& v)
    }
 }
 template <class T, class U, class V>
-inline void eval_bitwise_or(T& t, const U& u, const V& v)
+inline BOOST_CXX14_CONSTEXPR void eval_bitwise_or(T& t, const U& u, const V& v)
 {
    eval_bitwise_or_default(t, u, v);
 }
 
 template <class T, class U, class V>
-void eval_bitwise_xor(T& t, const U& u, const V& v);
+BOOST_CXX14_CONSTEXPR void eval_bitwise_xor(T& t, const U& u, const V& v);
 
 template <class T>
-inline void eval_bitwise_xor_default(T& t, const T& u, const T& v)
+inline BOOST_CXX14_CONSTEXPR void eval_bitwise_xor_default(T& t, const T& u, const T& v)
 {
    if(&t == &v)
    {
@@ -779,7 +787,7 @@ inline void eval_bitwise_xor_default(T& t, const U& u, const V& v)
    }
 }
 template <class T, class U, class V>
-inline void eval_bitwise_xor(T& t, const U& u, const V& v)
+inline BOOST_CXX14_CONSTEXPR void eval_bitwise_xor(T& t, const U& u, const V& v)
 {
    eval_bitwise_xor_default(t, u, v);
 }
@@ -1204,11 +1212,11 @@ inline void eval_remainder(T& result, const U& a, const V& b)
 }
 
 template <class B>
-bool eval_gt(const B& a, const B& b);
+BOOST_CXX14_CONSTEXPR bool eval_gt(const B& a, const B& b);
 template <class T, class U>
 bool eval_gt(const T& a, const U& b);
 template <class B>
-bool eval_lt(const B& a, const B& b);
+BOOST_CXX14_CONSTEXPR bool eval_lt(const B& a, const B& b);
 template <class T, class U>
 bool eval_lt(const T& a, const U& b);
 
@@ -1485,6 +1493,26 @@ inline bool eval_bit_test(const T& val, unsigned index)
    return !eval_is_zero(t);
 }
 
+template <class T>
+inline unsigned eval_popcount(const T& val)
+{
+   int c = eval_get_sign(val);
+   if(c == 0)
+      return 0;
+   if(c < 0)
+   {
+      BOOST_THROW_EXCEPTION(std::range_error("Testing individual bits in negative values is not supported - results are undefined."));
+   }
+   unsigned result = 0;
+   unsigned m = eval_msb(val);
+   for(unsigned i = 0; i <= m; ++i)
+   {
+      if(eval_bit_test(val, i))
+         ++result;
+   }
+   return result;
+}
+
 template <class T>
 inline void eval_bit_set(T& val, unsigned index)
 {
@@ -124,6 +124,97 @@ inline void eval_lcm(B& result, const B& a, const B& b)
    if(eval_get_sign(result) < 0)
       result.negate();
 }
+//
+// Extended Euclidean algorithm on |a| and |b|, sets g = gcd(a, b) and s and t such that a*s + b*t = g:
+//
+template <class B>
+void eval_gcdext(B& g, B& s, B& t, const B& a, const B& b)
+{
+   typedef typename mpl::front<typename B::unsigned_types>::type ui_type;
+   using default_ops::eval_get_sign;
+   using default_ops::eval_is_zero;
+   using default_ops::eval_multiply;
+   using default_ops::eval_subtract;
+
+   bool a_neg = eval_get_sign(a) < 0;
+   bool b_neg = eval_get_sign(b) < 0;
+   B u(a), v(b), su, sv, tu, tv, q, r;
+   if(a_neg)
+      u.negate();
+   if(b_neg)
+      v.negate();
+   su = ui_type(1u);
+   sv = ui_type(0u);
+   tu = ui_type(0u);
+   tv = ui_type(1u);
+   while(!eval_is_zero(v))
+   {
+      eval_qr(u, v, q, r);
+      u.swap(v);
+      v.swap(r);
+      eval_multiply(r, q, sv);
+      eval_subtract(su, r);
+      su.swap(sv);
+      eval_multiply(r, q, tv);
+      eval_subtract(tu, r);
+      tu.swap(tv);
+   }
+   if(eval_is_zero(u))
+      su = ui_type(0u);  // a = b = 0
+   if(a_neg)
+      su.negate();
+   if(b_neg)
+      tu.negate();
+   g.swap(u);
+   s.swap(su);
+   t.swap(tu);
+}
+//
+// The inverse of a modulo m, by the extended Euclidean algorithm.  As for the built in types, we keep the
+// magnitudes of the cofactors of a, which alternate in sign, and the parity of the number of steps.  The
+// magnitudes never exceed m, so nothing overflows in fixed width and unsigned types:
+//
+template <class B>
+void eval_inverse_mod(B& result, const B& a, const B& m)
+{
+   typedef typename mpl::front<typename B::unsigned_types>::type ui_type;
+   using default_ops::eval_get_sign;
+   using default_ops::eval_is_zero;
+   using default_ops::eval_eq;
+   using default_ops::eval_multiply;
+   using default_ops::eval_modulus;
+
+   if(eval_get_sign(m) <= 0)
+      BOOST_THROW_EXCEPTION(std::domain_error("The modulus must be positive."));
+   B u(m), v, x, y, q, r;
+   eval_modulus(v, a, m);
+   if(eval_get_sign(v) < 0)
+      eval_add(v, m);
+   x = ui_type(0u);
+   y = ui_type(1u);
+   bool odd = false;
+   while(!eval_is_zero(v))
+   {
+      eval_qr(u, v, q, r);
+      u.swap(v);
+      v.swap(r);
+      // x, y = y, x + q * y:
+      eval_multiply(r, q, y);
+      eval_add(r, x);
+      x.swap(y);
+      y.swap(r);
+      odd = !odd;
+   }
+   if(!eval_eq(u, ui_type(1u)))
+      BOOST_THROW_EXCEPTION(std::domain_error("The value has no inverse with respect to the modulus."));
+   //
+   // After k steps 1 = (-1)^(k+1) |x| a (mod m):
+   //
+   if(odd || eval_is_zero(x))
+      result.swap(x);
+   else
+      eval_subtract(result, m, x);
+}
 
 }
 
@@ -212,6 +303,24 @@ inline typename enable_if_c<number_category<typename multiprecision::detail::exp
    return eval_msb(n.backend());
 }
 
+template <class Backend, expression_template_option ExpressionTemplates>
+inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, unsigned>::type 
+   popcount(const number<Backend, ExpressionTemplates>& x)
+{
+   using default_ops::eval_popcount;
+   return eval_popcount(x.backend());
+}
+
+template <class tag, class A1, class A2, class A3, class A4>
+inline typename enable_if_c<number_category<typename multiprecision::detail::expression<tag, A1, A2, A3, A4>::result_type>::value == number_kind_integer, unsigned>::type 
+   popcount(const multiprecision::detail::expression<tag, A1, A2, A3, A4>& x)
+{
+   typedef typename multiprecision::detail::expression<tag, A1, A2, A3, A4>::result_type number_type;
+   number_type n(x);
+   using default_ops::eval_popcount;
+   return eval_popcount(n.backend());
+}
+
 template <class Backend, expression_template_option ExpressionTemplates>
 inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, bool>::type 
    bit_test(const number<Backend, ExpressionTemplates>& x, unsigned index)
@@ -257,6 +366,27 @@ inline typename enable_if_c<number_category<Backend>::value == number_kind_integ
    return x;
 }
 
+template <class Backend, expression_template_option ExpressionTemplates>
+inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, number<Backend, ExpressionTemplates> >::type 
+   gcdext(const number<Backend, ExpressionTemplates>& a, const number<Backend, ExpressionTemplates>& b, number<Backend, ExpressionTemplates>& s, number<Backend, ExpressionTemplates>& t)
+{
+   BOOST_STATIC_ASSERT_MSG(is_signed_number<Backend>::value, "gcdext requires a signed integer type.");
+   using default_ops::eval_gcdext;
+   number<Backend, ExpressionTemplates> g;
+   eval_gcdext(g.backend(), s.backend(), t.backend(), a.backend(), b.backend());
+   return g;
+}
+
+template <class Backend, expression_template_option ExpressionTemplates>
+inline typename enable_if_c<number_category<Backend>::value == number_kind_integer, number<Backend, ExpressionTemplates> >::type 
+   inverse_mod(const number<Backend, ExpressionTemplates>& a, const number<Backend, ExpressionTemplates>& m)
+{
+   using default_ops::eval_inverse_mod;
+   number<Backend, ExpressionTemplates> result;
+   eval_inverse_mod(result.backend(), a.backend(), m.backend());
+   return result;
+}
+
 namespace default_ops{
 
 //
@@ -292,6 +422,7 @@ void eval_powm(Backend& result, const Backend& a, const Backend& p, const Backen
    using default_ops::eval_bit_test;
    using default_ops::eval_get_sign;
    using default_ops::eval_multiply;
+   using default_ops::eval_square;
    using default_ops::eval_modulus;
    using default_ops::eval_right_shift;
 
@@ -310,7 +441,7 @@ void eval_powm(Backend& result, const Backend& a, const Backend& p, const Backen
          eval_multiply(t, x, y);
          eval_modulus(x, t, c);
       }
-      eval_multiply(t, y, y);
+      eval_square(t, y);
       eval_modulus(y, t, c);
       eval_right_shift(b, ui_type(1));
    }
@@ -329,6 +460,7 @@ void eval_powm(Backend& result, const Backend& a, const Backend& p, Integer c)
    using default_ops::eval_bit_test;
    using default_ops::eval_get_sign;
    using default_ops::eval_multiply;
+   using default_ops::eval_square;
    using default_ops::eval_modulus;
    using default_ops::eval_right_shift;
 
@@ -349,7 +481,7 @@ void eval_powm(Backend& result, const Backend& a, const Backend& p, Integer c)
          eval_multiply(t, x, y);
          eval_modulus(x, t, static_cast<i1_type>(c));
       }
-      eval_multiply(t, y, y);
+      eval_square(t, y);
       eval_modulus(y, t, static_cast<i1_type>(c));
       eval_right_shift(b, ui_type(1));
    }
@@ -366,6 +498,7 @@ typename enable_if<is_unsigned<Integer> >::type eval_powm(Backend& result, const
    using default_ops::eval_bit_test;
    using default_ops::eval_get_sign;
    using default_ops::eval_multiply;
+   using default_ops::eval_square;
    using default_ops::eval_modulus;
    using default_ops::eval_right_shift;
 
@@ -379,7 +512,7 @@ typename enable_if<is_unsigned<Integer> >::type eval_powm(Backend& result, const
          eval_multiply(t, x, y);
          eval_modulus(x, t, c);
       }
-      eval_multiply(t, y, y);
+      eval_square(t, y);
       eval_modulus(y, t, c);
       b >>= 1;
    }
@@ -408,6 +541,7 @@ typename enable_if<is_unsigned<Integer1> >::type eval_powm(Backend& result, cons
    using default_ops::eval_bit_test;
    using default_ops::eval_get_sign;
    using default_ops::eval_multiply;
+   using default_ops::eval_square;
    using default_ops::eval_modulus;
    using default_ops::eval_right_shift;
 
@@ -421,7 +555,7 @@ typename enable_if<is_unsigned<Integer1> >::type eval_powm(Backend& result, cons
          eval_multiply(t, x, y);
          eval_modulus(x, t, static_cast<i1_type>(c));
       }
-      eval_multiply(t, y, y);
+      eval_square(t, y);
       eval_modulus(y, t, static_cast<i1_type>(c));
       b >>= 1;
    }
@@ -47,6 +47,24 @@
 #  define BOOST_MP_THREAD_LOCAL
 #endif
 
+//
+// Detect whether we are being evaluated in a constant expression.  Code which has to be usable
+// at compile time can then take a simple constexpr path there, and leave the runtime code as it is.
+// BOOST_MP_IS_CONST_EVALUATED is only defined when we can tell:
+//
+#if !defined(BOOST_NO_CXX14_CONSTEXPR) && !defined(BOOST_MP_NO_CONSTEXPR_DETECTION)
+#  include <type_traits>
+#  if defined(__cpp_lib_is_constant_evaluated)
+#     define BOOST_MP_IS_CONST_EVALUATED std::is_constant_evaluated()
+#  elif defined(BOOST_GCC) && (BOOST_GCC >= 90000)
+#     define BOOST_MP_IS_CONST_EVALUATED __builtin_is_constant_evaluated()
+#  elif defined(__has_builtin)
+#     if __has_builtin(__builtin_is_constant_evaluated)
+#        define BOOST_MP_IS_CONST_EVALUATED __builtin_is_constant_evaluated()
+#     endif
+#  endif
+#endif
+
 #ifdef BOOST_MSVC
 #  pragma warning(push)
 #  pragma warning(disable:6326)
@@ -1506,7 +1524,7 @@ void format_float_string(S& str, boost::intmax_t my_exp, boost::intmax_t digits,
 }
 
 template <class V>
-void check_shift_range(V val, const mpl::true_&, const mpl::true_&)
+BOOST_CXX14_CONSTEXPR void check_shift_range(V val, const mpl::true_&, const mpl::true_&)
 {
    if(val > (std::numeric_limits<std::size_t>::max)())
       BOOST_THROW_EXCEPTION(std::out_of_range("Can not shift by a value greater than std::numeric_limits<std::size_t>::max()."));
@@ -1514,19 +1532,19 @@ void check_shift_range(V val, const mpl::true_&, const mpl::true_&)
       BOOST_THROW_EXCEPTION(std::out_of_range("Can not shift by a negative value."));
 }
 template <class V>
-void check_shift_range(V val, const mpl::false_&, const mpl::true_&)
+BOOST_CXX14_CONSTEXPR void check_shift_range(V val, const mpl::false_&, const mpl::true_&)
 {
    if(val < 0)
       BOOST_THROW_EXCEPTION(std::out_of_range("Can not shift by a negative value."));
 }
 template <class V>
-void check_shift_range(V val, const mpl::true_&, const mpl::false_&)
+BOOST_CXX14_CONSTEXPR void check_shift_range(V val, const mpl::true_&, const mpl::false_&)
 {
    if(val > (std::numeric_limits<std::size_t>::max)())
       BOOST_THROW_EXCEPTION(std::out_of_range("Can not shift by a value greater than std::numeric_limits<std::size_t>::max()."));
 }
 template <class V>
-void check_shift_range(V, const mpl::false_&, const mpl::false_&) BOOST_NOEXCEPT{}
+BOOST_CXX14_CONSTEXPR void check_shift_range(V, const mpl::false_&, const mpl::false_&) BOOST_NOEXCEPT{}
 
 template <class T>
 const T& evaluate_if_expression(const T& val) { return val; }
@@ -22,7 +22,7 @@ namespace default_ops{
 // under strange and hard to reproduce circumstances.
 //
 template <class B>
-inline bool eval_eq(const B& a, const B& b)
+inline BOOST_CXX14_CONSTEXPR bool eval_eq(const B& a, const B& b)
 {
    return a.compare(b) == 0;
 }
@@ -46,7 +46,7 @@ inline bool eval_eq(const T& a, const U& b)
 }
 
 template <class B>
-inline bool eval_lt(const B& a, const B& b)
+inline BOOST_CXX14_CONSTEXPR bool eval_lt(const B& a, const B& b)
 {
    return a.compare(b) < 0;
 }
@@ -70,7 +70,7 @@ inline bool eval_lt(const T& a, const U& b)
 }
 
 template <class B>
-inline bool eval_gt(const B& a, const B& b)
+inline BOOST_CXX14_CONSTEXPR bool eval_gt(const B& a, const B& b)
 {
    return a.compare(b) > 0;
 }
@@ -150,7 +150,7 @@ inline BOOST_CONSTEXPR bool is_unordered_comparison(const T& a, const U& b)
 }
 
 template <class Backend, expression_template_option ExpressionTemplates, class Backend2, expression_template_option ExpressionTemplates2>
-inline bool operator == (const number<Backend, ExpressionTemplates>& a, const number<Backend2, ExpressionTemplates2>& b)
+inline BOOST_CXX14_CONSTEXPR bool operator == (const number<Backend, ExpressionTemplates>& a, const number<Backend2, ExpressionTemplates2>& b)
 {
    using default_ops::eval_eq;
    if(detail::is_unordered_comparison(a, b)) return false;
@@ -204,7 +204,7 @@ inline typename enable_if<is_same<typename detail::expression<Tag, A1, A2, A3, A
 }
 
 template <class Backend, expression_template_option ExpressionTemplates, class Backend2, expression_template_option ExpressionTemplates2>
-inline bool operator != (const number<Backend, ExpressionTemplates>& a, const number<Backend2, ExpressionTemplates2>& b)
+inline BOOST_CXX14_CONSTEXPR bool operator != (const number<Backend, ExpressionTemplates>& a, const number<Backend2, ExpressionTemplates2>& b)
 {
    using default_ops::eval_eq;
    if(detail::is_unordered_comparison(a, b)) return true;
@@ -258,7 +258,7 @@ inline typename enable_if<is_same<typename detail::expression<Tag, A1, A2, A3, A
 }
 
 template <class Backend, expression_template_option ExpressionTemplates, class Backend2, expression_template_option ExpressionTemplates2>
-inline typename boost::enable_if_c<(number_category<Backend>::value != number_kind_complex) && (number_category<Backend2>::value != number_kind_complex), bool>::type
+inline BOOST_CXX14_CONSTEXPR typename boost::enable_if_c<(number_category<Backend>::value != number_kind_complex) && (number_category<Backend2>::value != number_kind_complex), bool>::type
    operator < (const number<Backend, ExpressionTemplates>& a, const number<Backend2, ExpressionTemplates2>& b)
 {
    using default_ops::eval_lt;
@@ -313,7 +313,7 @@ inline typename enable_if_c<is_same<typename detail::expression<Tag, A1, A2, A3,
 }
 
 template <class Backend, expression_template_option ExpressionTemplates, class Backend2, expression_template_option ExpressionTemplates2>
-inline typename boost::enable_if_c<(number_category<Backend>::value != number_kind_complex) && (number_category<Backend2>::value != number_kind_complex), bool>::type
+inline BOOST_CXX14_CONSTEXPR typename boost::enable_if_c<(number_category<Backend>::value != number_kind_complex) && (number_category<Backend2>::value != number_kind_complex), bool>::type
    operator > (const number<Backend, ExpressionTemplates>& a, const number<Backend2, ExpressionTemplates2>& b)
 {
    using default_ops::eval_gt;
@@ -368,7 +368,7 @@ inline typename enable_if_c<is_same<typename detail::expression<Tag, A1, A2, A3,
 }
 
 template <class Backend, expression_template_option ExpressionTemplates, class Backend2, expression_template_option ExpressionTemplates2>
-inline typename boost::enable_if_c<(number_category<Backend>::value != number_kind_complex) && (number_category<Backend2>::value != number_kind_complex), bool>::type
+inline BOOST_CXX14_CONSTEXPR typename boost::enable_if_c<(number_category<Backend>::value != number_kind_complex) && (number_category<Backend2>::value != number_kind_complex), bool>::type
    operator <= (const number<Backend, ExpressionTemplates>& a, const number<Backend2, ExpressionTemplates2>& b)
 {
    using default_ops::eval_gt;
@@ -425,7 +425,7 @@ inline typename enable_if_c<is_same<typename detail::expression<Tag, A1, A2, A3,
 }
 
 template <class Backend, expression_template_option ExpressionTemplates, class Backend2, expression_template_option ExpressionTemplates2>
-inline typename boost::enable_if_c<(number_category<Backend>::value != number_kind_complex) && (number_category<Backend2>::value != number_kind_complex), bool>::type
+inline BOOST_CXX14_CONSTEXPR typename boost::enable_if_c<(number_category<Backend>::value != number_kind_complex) && (number_category<Backend2>::value != number_kind_complex), bool>::type
    operator >= (const number<Backend, ExpressionTemplates>& a, const number<Backend2, ExpressionTemplates2>& b)
 {
    using default_ops::eval_lt;
@@ -1706,6 +1706,20 @@ inline typename enable_if_c<is_signed<I>::value && ((sizeof(I) <= sizeof(long)))
    mpz_lcm_ui(result.data(), a.data(), boost::multiprecision::detail::unsigned_abs(b));
 }
 
+inline void eval_gcdext(gmp_int& g, gmp_int& s, gmp_int& t, const gmp_int& a, const gmp_int& b)
+{
+   mpz_gcdext(g.data(), s.data(), t.data(), a.data(), b.data());
+}
+inline void eval_inverse_mod(gmp_int& result, const gmp_int& a, const gmp_int& m)
+{
+   if(mpz_sgn(m.data()) <= 0)
+      BOOST_THROW_EXCEPTION(std::domain_error("The modulus must be positive."));
+   if(mpz_cmp_ui(m.data(), 1) == 0)
+      mpz_set_ui(result.data(), 0);
+   else if(!mpz_invert(result.data(), a.data(), m.data()))
+      BOOST_THROW_EXCEPTION(std::domain_error("The value has no inverse with respect to the modulus."));
+}
+
 inline void eval_integer_sqrt(gmp_int& s, gmp_int& r, const gmp_int& x)
 {
    mpz_sqrtrem(s.data(), r.data(), x.data());
@@ -1739,6 +1753,15 @@ inline unsigned eval_msb(const gmp_int& val)
    return static_cast<unsigned>(mpz_sizeinbase(val.data(), 2) - 1);
 }
 
+inline unsigned eval_popcount(const gmp_int& val)
+{
+   if(eval_get_sign(val) < 0)
+   {
+      BOOST_THROW_EXCEPTION(std::range_error("Testing individual bits in negative values is not supported - results are undefined."));
+   }
+   return static_cast<unsigned>(mpz_popcount(val.data()));
+}
+
 inline bool eval_bit_test(const gmp_int& val, unsigned index)
 {
    return mpz_tstbit(val.data(), index) ? true : false;
@@ -112,6 +112,74 @@ inline typename enable_if_c<is_integral<I1>::value && is_signed<I2>::value && is
    return powm(a, static_cast<typename make_unsigned<I2>::type>(b), c);
 }
 
+template <class Integer>
+typename enable_if_c<is_integral<Integer>::value && is_signed<Integer>::value, Integer>::type
+   gcdext(const Integer& a, const Integer& b, Integer& s, Integer& t)
+{
+   //
+   // Extended Euclidean algorithm on the magnitudes of a and b, the cofactors alternate
+   // in sign so we keep their magnitudes and the parity of the number of steps:
+   //
+   typedef typename make_unsigned<Integer>::type ui_type;
+   ui_type u = a < 0 ? static_cast<ui_type>(static_cast<ui_type>(0u) - static_cast<ui_type>(a)) : static_cast<ui_type>(a);
+   ui_type v = b < 0 ? static_cast<ui_type>(static_cast<ui_type>(0u) - static_cast<ui_type>(b)) : static_cast<ui_type>(b);
+   ui_type su(1), sv(0), tu(0), tv(1);
+   bool odd = false;
+   while(v)
+   {
+      ui_type q = static_cast<ui_type>(u / v);
+      ui_type r = static_cast<ui_type>(u - q * v);
+      ui_type x = static_cast<ui_type>(su + q * sv);
+      ui_type y = static_cast<ui_type>(tu + q * tv);
+      u = v;
+      v = r;
+      su = sv;
+      sv = x;
+      tu = tv;
+      tv = y;
+      odd = !odd;
+   }
+   if(!u)
+      su = 0;  // a = b = 0
+   s = (odd != (a < 0)) ? static_cast<Integer>(-static_cast<Integer>(su)) : static_cast<Integer>(su);
+   t = (odd == (b < 0)) ? static_cast<Integer>(-static_cast<Integer>(tu)) : static_cast<Integer>(tu);
+   return static_cast<Integer>(u);
+}
+
+template <class Integer>
+typename enable_if_c<is_integral<Integer>::value, Integer>::type inverse_mod(const Integer& a, const Integer& m)
+{
+   typedef typename make_unsigned<Integer>::type ui_type;
+   if(!(m > 0))
+   {
+      BOOST_THROW_EXCEPTION(std::domain_error("The modulus must be positive."));
+   }
+   Integer r = a % m;
+   ui_type u = static_cast<ui_type>(m);
+   ui_type v = r < 0 ? static_cast<ui_type>(static_cast<ui_type>(r) + u) : static_cast<ui_type>(r);
+   //
+   // As above, but we only need the cofactors of a, and 1 = (-1)^(k+1) |x| a (mod m) after k steps:
+   //
+   ui_type x(0), y(1);
+   bool odd = false;
+   while(v)
+   {
+      ui_type q = static_cast<ui_type>(u / v);
+      ui_type t = static_cast<ui_type>(u - q * v);
+      ui_type z = static_cast<ui_type>(x + q * y);
+      u = v;
+      v = t;
+      x = y;
+      y = z;
+      odd = !odd;
+   }
+   if(u != 1)
+   {
+      BOOST_THROW_EXCEPTION(std::domain_error("The value has no inverse with respect to the modulus."));
+   }
+   return static_cast<Integer>(odd || !x ? x : static_cast<ui_type>(static_cast<ui_type>(m) - x));
+}
+
 template <class Integer>
 typename enable_if_c<is_integral<Integer>::value, unsigned>::type lsb(const Integer& val)
 {
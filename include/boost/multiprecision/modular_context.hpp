@@ -0,0 +1,356 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+#ifndef BOOST_MP_MODULAR_CONTEXT_HPP
+#define BOOST_MP_MODULAR_CONTEXT_HPP
+
+#include <boost/multiprecision/integer.hpp>
+#include <vector>
+
+namespace boost{
+namespace multiprecision{
+
+namespace detail{
+
+//
+// Integer types for which modular_context can use Montgomery multiplication:
+//
+template <class Integer>
+struct is_montgomery_capable : public mpl::false_ {};
+
+template <unsigned MinBits, unsigned MaxBits, cpp_integer_type SignType, cpp_int_check_type Checked, class Allocator, expression_template_option ExpressionTemplates>
+struct is_montgomery_capable<number<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates> >
+   : public mpl::bool_<!backends::is_trivial_cpp_int<cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator> >::value> {};
+
+//
+// A type which can hold the product of two values less than the modulus, as for powm:
+//
+template <class Integer>
+struct modular_product_type
+{
+   typedef typename mpl::eval_if_c<is_integral<Integer>::value, double_integer<Integer>, mpl::identity<Integer> >::type type;
+};
+template <class Backend, expression_template_option ExpressionTemplates>
+struct modular_product_type<number<Backend, ExpressionTemplates> >
+{
+   typedef number<typename default_ops::double_precision_type<Backend>::type, ExpressionTemplates> type;
+};
+
+}
+
+//
+// Arithmetic modulo a fixed modulus m > 0, for code which performs many operations with
+// the same modulus.  All results are in the range [0, m).  The generic version works for
+// any integer type, and reuses its temporaries between calls:
+//
+template <class Integer, bool Montgomery = detail::is_montgomery_capable<Integer>::value>
+class modular_context
+{
+   typedef typename detail::modular_product_type<Integer>::type product_type;
+ public:
+   typedef Integer value_type;
+
+   explicit modular_context(const value_type& m) : m_modulus(m), m_wide_modulus(m)
+   {
+      if(m_modulus <= 0)
+         BOOST_THROW_EXCEPTION(std::domain_error("The modulus must be positive."));
+   }
+   const value_type& modulus()const BOOST_NOEXCEPT { return m_modulus; }
+
+   void mulmod(value_type& result, const value_type& a, const value_type& b)
+   {
+      m_product = a;
+      m_t = b;
+      m_product *= m_t;
+      reduce(result, m_product);
+   }
+   value_type mulmod(const value_type& a, const value_type& b)
+   {
+      value_type result;
+      mulmod(result, a, b);
+      return result;
+   }
+   void sqrmod(value_type& result, const value_type& a)
+   {
+      m_product = a;
+      m_product *= m_product;
+      reduce(result, m_product);
+   }
+   value_type sqrmod(const value_type& a)
+   {
+      value_type result;
+      sqrmod(result, a);
+      return result;
+   }
+   void powm(value_type& result, const value_type& a, const value_type& p)
+   {
+      if(p < 0)
+         BOOST_THROW_EXCEPTION(std::runtime_error("powm requires a positive exponent."));
+      reduce(m_base, a);
+      result = boost::multiprecision::powm(m_base, p, m_modulus);
+   }
+   value_type powm(const value_type& a, const value_type& p)
+   {
+      value_type result;
+      powm(result, a, p);
+      return result;
+   }
+   //
+   // The inverse of a, throws if a and m are not coprime:
+   //
+   void inverse(value_type& result, const value_type& a)
+   {
+      result = inverse_mod(a, m_modulus);
+   }
+   value_type inverse(const value_type& a)
+   {
+      value_type result;
+      inverse(result, a);
+      return result;
+   }
+
+ protected:
+   void reduce(product_type& x)
+   {
+      if((x < 0) || (x >= m_wide_modulus))
+      {
+         x %= m_wide_modulus;
+         if(x < 0)
+            x += m_wide_modulus;
+      }
+   }
+   template <class T>
+   void reduce(value_type& result, const T& x)
+   {
+      if((x >= 0) && (x < m_modulus))
+         result = static_cast<value_type>(x);
+      else
+      {
+         m_product = x;
+         reduce(m_product);
+         result = static_cast<value_type>(m_product);
+      }
+   }
+
+ private:
+   value_type m_modulus, m_base;
+   product_type m_wide_modulus, m_product, m_t;
+};
+
+//
+// For cpp_int the work is done on raw limbs in a block of temporary storage allocated up
+// front, so that nothing is allocated per call.  The products in mulmod and sqrmod are
+// reduced by Barrett's method (see cpp_int/barrett.hpp) with the reciprocal of the modulus
+// precomputed, or for a single limb modulus, or one too large for that to pay, by division
+// with the modulus precomputed in normalised form.  When the modulus is odd, powm keeps its
+// values in Montgomery form (see cpp_int/montgomery.hpp), with R^2 mod m precomputed for
+// getting the base into that form.  inverse runs the extended Euclidean algorithm on values
+// kept from one call to the next, with room for anything less than the modulus:
+//
+template <class Integer>
+class modular_context<Integer, true> : public modular_context<Integer, false>
+{
+   typedef modular_context<Integer, false> base_type;
+   typedef typename Integer::backend_type backend_type;
+ public:
+   typedef Integer value_type;
+
+   explicit modular_context(const value_type& m) : base_type(m), m_montgomery(false), m_inverse(0), m_shift(0), m_limb_divisor(m.backend().size() == 1 ? m.backend().limbs()[0] : 1u)
+   {
+      using namespace boost::multiprecision::backends::detail;
+      static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+      const backend_type& n = m.backend();
+      unsigned k = n.size();
+      std::size_t storage = (std::max)(multiply_limbs_storage_size(k), divide_limbs_storage_size(k));
+      bool barrett = (k > 1) && (k < backends::barrett_cutoff);
+      if(barrett)
+         storage = (std::max)(storage, (std::max)(barrett_reciprocal_storage_size(k), barrett_reduce_storage_size(k)));
+      m_montgomery = (n.limbs()[0] & 1u) && (k < backends::montgomery_cutoff);
+      if(m_montgomery)
+      {
+         m_inverse = montgomery_inverse(n.limbs()[0]);
+         storage = (std::max)(storage, (std::max)(montgomery_convert_storage_size(k, k), montgomery_powm_storage_size(k, montgomery_max_window_size)));
+      }
+      m_storage.resize(5 * static_cast<std::size_t>(k) + 3 + storage);
+      m_divisor.assign(n.limbs(), n.limbs() + k);
+      m_shift = limb_bits - 1 - boost::multiprecision::detail::find_msb(n.limbs()[k - 1]);
+      if(m_shift)
+         left_shift_limbs(&m_divisor[0], k, m_shift);
+      if(barrett)
+      {
+         m_reciprocal.resize(k + 1);
+         barrett_reciprocal(&m_reciprocal[0], n.limbs(), k, workspace());
+      }
+      if(m_montgomery)
+      {
+         //
+         // R mod m and then R^2 mod m:
+         //
+         static const limb_type one = 1;
+         m_r2.resize(k);
+         montgomery_convert(x(), &one, 1, n.limbs(), k, workspace());
+         montgomery_convert(&m_r2[0], x(), k, n.limbs(), k, workspace());
+      }
+      value_type* gcd_values[] = { &m_u, &m_v, &m_x, &m_y, &m_q, &m_r, &m_t };
+      for(unsigned i = 0; i < sizeof(gcd_values) / sizeof(gcd_values[0]); ++i)
+         boost::multiprecision::reserve(*gcd_values[i], (k + 4) * limb_bits);
+   }
+
+   void mulmod(value_type& result, const value_type& a, const value_type& b)
+   {
+      load(x(), a);
+      load(y(), b);
+      backends::detail::multiply_limbs(t(), x(), size(), y(), size(), workspace());
+      reduce_product();
+      store(result, t());
+   }
+   value_type mulmod(const value_type& a, const value_type& b)
+   {
+      value_type result;
+      mulmod(result, a, b);
+      return result;
+   }
+   void sqrmod(value_type& result, const value_type& a)
+   {
+      load(x(), a);
+      backends::detail::multiply_limbs(t(), x(), size(), x(), size(), workspace());
+      reduce_product();
+      store(result, t());
+   }
+   value_type sqrmod(const value_type& a)
+   {
+      value_type result;
+      sqrmod(result, a);
+      return result;
+   }
+   void powm(value_type& result, const value_type& a, const value_type& p)
+   {
+      if(p <= 0)
+         return base_type::powm(result, a, p);
+      using namespace boost::multiprecision::backends::detail;
+      unsigned k = size();
+      if(!m_montgomery)
+      {
+         if((k > 1) && m_reciprocal.empty())
+            return base_type::powm(result, a, p);
+         //
+         // Left to right binary exponentiation, with the products reduced as in mulmod:
+         //
+         load(y(), a);
+         std::copy(y(), y() + k, x());
+         for(unsigned i = msb(p); i-- > 0;)
+         {
+            multiply_limbs(t(), x(), k, x(), k, workspace());
+            reduce_product();
+            if(bit_test(p, i))
+            {
+               std::copy(t(), t() + k, x());
+               multiply_limbs(t(), x(), k, y(), k, workspace());
+               reduce_product();
+            }
+            std::copy(t(), t() + k, x());
+         }
+         store(result, x());
+         return;
+      }
+      //
+      // aR^2/R is a in Montgomery form, and a reduction on its own gets the result out again:
+      //
+      load(x(), a);
+      montgomery_multiply(x(), x(), &m_r2[0], modulus_limbs(), k, m_inverse, workspace());
+      montgomery_powm(y(), x(), p.backend().limbs(), p.backend().size(), modulus_limbs(), k, m_inverse, workspace());
+      std::copy(y(), y() + k, t());
+      std::fill(t() + k, t() + 2 * k, static_cast<limb_type>(0u));
+      montgomery_reduce(x(), t(), modulus_limbs(), k, m_inverse);
+      store(result, x());
+   }
+   value_type powm(const value_type& a, const value_type& p)
+   {
+      value_type result;
+      powm(result, a, p);
+      return result;
+   }
+   void inverse(value_type& result, const value_type& a)
+   {
+      load(x(), a);
+      store(m_v, x());
+      backends::detail::inverse_mod_reduced(m_x.backend(), m_v.backend(), this->modulus().backend(), m_u.backend(), m_y.backend(), m_q.backend(), m_r.backend(), m_t.backend());
+      result = m_x;
+   }
+   value_type inverse(const value_type& a)
+   {
+      value_type result;
+      inverse(result, a);
+      return result;
+   }
+
+ private:
+   unsigned size()const { return this->modulus().backend().size(); }
+   const limb_type* modulus_limbs()const { return this->modulus().backend().limbs(); }
+   limb_type* x() { return &m_storage[0]; }
+   limb_type* y() { return &m_storage[0] + size(); }
+   limb_type* t() { return &m_storage[0] + 2 * size(); }
+   limb_type* q() { return &m_storage[0] + 4 * size() + 1; }
+   limb_type* workspace() { return &m_storage[0] + 5 * size() + 3; }
+   //
+   // Reduces the 2k limb product in t() modulo m, leaving the result in the low k limbs:
+   //
+   void reduce_product()
+   {
+      using namespace boost::multiprecision::backends::detail;
+      unsigned k = size();
+      limb_type* pt = t();
+      if(k == 1)
+      {
+         pt[0] = divide_limbs_by_limb(0, 0, pt, 2, m_limb_divisor);
+         return;
+      }
+      if(!m_reciprocal.empty())
+      {
+         barrett_reduce(q(), pt, 2 * k, modulus_limbs(), k, &m_reciprocal[0], workspace());
+         std::copy(q(), q() + k, pt);
+         return;
+      }
+      pt[2 * k] = 0;
+      if(m_shift)
+         left_shift_limbs(pt, 2 * k + 1, m_shift);
+      divide_limbs(q(), pt, 2 * k + 1, &m_divisor[0], k, workspace());
+      if(m_shift)
+         right_shift_limbs(pt, k, m_shift);
+   }
+   //
+   // Copies a into k limbs, reducing it first if it's out of range:
+   //
+   void load(limb_type* pr, const value_type& a)
+   {
+      const backend_type* pa = &a.backend();
+      if(pa->sign() || (a >= this->modulus()))
+      {
+         this->reduce(m_reduced, a);
+         pa = &m_reduced.backend();
+      }
+      std::copy(pa->limbs(), pa->limbs() + pa->size(), pr);
+      std::fill(pr + pa->size(), pr + size(), static_cast<limb_type>(0u));
+   }
+   void store(value_type& result, const limb_type* pa)
+   {
+      backend_type& r = result.backend();
+      r.resize(size(), size());
+      std::copy(pa, pa + size(), r.limbs());
+      r.normalize();
+      r.sign(false);
+   }
+
+   bool m_montgomery;
+   limb_type m_inverse;
+   unsigned m_shift;
+   divisor m_limb_divisor;
+   std::vector<limb_type> m_divisor, m_reciprocal, m_r2, m_storage;
+   value_type m_reduced, m_u, m_v, m_x, m_y, m_q, m_r, m_t;
+};
+
+}} // namespaces
+
+#endif
@@ -258,7 +258,7 @@ public:
       return *this;
    }
 
-   BOOST_MP_FORCEINLINE number& operator=(const number& e)
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR number& operator=(const number& e)
       BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<Backend&>() = std::declval<Backend const&>()))
    {
       m_backend = e.m_backend;
@@ -339,7 +339,7 @@ public:
    BOOST_MP_FORCEINLINE BOOST_CONSTEXPR number(number&& r)
       BOOST_MP_NOEXCEPT_IF(noexcept(Backend(std::declval<Backend>())))
       : m_backend(static_cast<Backend&&>(r.m_backend)){}
-   BOOST_MP_FORCEINLINE number& operator=(number&& r) BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<Backend&>() = std::declval<Backend>()))
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR number& operator=(number&& r) BOOST_MP_NOEXCEPT_IF(noexcept(std::declval<Backend&>() = std::declval<Backend>()))
    {
       m_backend = static_cast<Backend&&>(r.m_backend);
       return *this;
@@ -950,12 +950,12 @@ public:
    // Direct access to the underlying backend:
    //
 #if !(defined(BOOST_NO_CXX11_RVALUE_REFERENCES) || defined(BOOST_NO_CXX11_REF_QUALIFIERS) || BOOST_WORKAROUND(BOOST_GCC, < 50000))
-   BOOST_MP_FORCEINLINE Backend&              backend()& BOOST_NOEXCEPT               { return m_backend; }
-   BOOST_MP_FORCEINLINE BOOST_CONSTEXPR const Backend& backend()const& BOOST_NOEXCEPT { return m_backend; }
-   BOOST_MP_FORCEINLINE Backend&&             backend()&& BOOST_NOEXCEPT              { return static_cast<Backend&&>(m_backend); }
-   BOOST_MP_FORCEINLINE Backend const&&       backend()const&& BOOST_NOEXCEPT         { return static_cast<Backend const&&>(m_backend); }
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR Backend& backend()&       BOOST_NOEXCEPT { return m_backend; }
+   BOOST_MP_FORCEINLINE BOOST_CONSTEXPR const Backend& backend()const&  BOOST_NOEXCEPT { return m_backend; }
+   BOOST_MP_FORCEINLINE Backend&&                      backend()&&      BOOST_NOEXCEPT { return static_cast<Backend&&>(m_backend); }
+   BOOST_MP_FORCEINLINE Backend const&&                backend()const&& BOOST_NOEXCEPT { return static_cast<Backend const&&>(m_backend); }
 #else
-   BOOST_MP_FORCEINLINE Backend&              backend() BOOST_NOEXCEPT { return m_backend; }
+   BOOST_MP_FORCEINLINE BOOST_CXX14_CONSTEXPR Backend& backend()      BOOST_NOEXCEPT { return m_backend; }
    BOOST_MP_FORCEINLINE BOOST_CONSTEXPR const Backend& backend()const BOOST_NOEXCEPT { return m_backend; }
 #endif
    //
@@ -52,7 +52,10 @@
 #endif
 #if defined(TEST_CPP_INT) || defined(TEST_CPP_INT_RATIONAL)
 #include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/cpp_int/pooled_allocator.hpp>
+#include <boost/multiprecision/cpp_int/counting_allocator.hpp>
 #endif
+#include <boost/multiprecision/modular_context.hpp>
 
 #include <boost/chrono.hpp>
 #include <vector>
@@ -91,10 +94,10 @@ unsigned bits_wanted; // for integer types
 template <class T, int Type>
 struct tester
 {
-   tester()
+   tester(unsigned count = 500)
    {
-      a.assign(500, 0);
-      for(int i = 0; i < 500; ++i)
+      a.assign(count, 0);
+      for(unsigned i = 0; i < count; ++i)
       {
          b.push_back(generate_random());
          c.push_back(generate_random());
@@ -141,10 +144,10 @@ struct tester
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
-   double test_multiply()
+   double test_multiply(unsigned reps = 1000)
    {
       stopwatch<boost::chrono::high_resolution_clock> w;
-      for(unsigned i = 0; i < 1000; ++i)
+      for(unsigned i = 0; i < reps; ++i)
       {
          for(unsigned k = 0; k < b.size(); ++k)
             a[k] = b[k] * c[k];
@@ -212,6 +215,36 @@ struct tester
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
+   //
+   // Division of a value twice the width of the divisor, so that the quotient
+   // is as large as the divisor, which is the case the recursive division targets:
+   //
+   double test_divide_wide(unsigned reps)
+   {
+      std::vector<T> n(b.size());
+      for(unsigned k = 0; k < b.size(); ++k)
+         n[k] = b[k] * c[k] + small[k];
+      stopwatch<boost::chrono::high_resolution_clock> w;
+      for(unsigned i = 0; i < reps; ++i)
+      {
+         for(unsigned k = 0; k < b.size(); ++k)
+            a[k] = n[k] / c[k];
+      }
+      return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+   }
+   double test_mod_wide(unsigned reps)
+   {
+      std::vector<T> n(b.size());
+      for(unsigned k = 0; k < b.size(); ++k)
+         n[k] = b[k] * c[k] + small[k];
+      stopwatch<boost::chrono::high_resolution_clock> w;
+      for(unsigned i = 0; i < reps; ++i)
+      {
+         for(unsigned k = 0; k < b.size(); ++k)
+            a[k] = n[k] % c[k];
+      }
+      return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+   }
    double test_mod_int()
    {
       stopwatch<boost::chrono::high_resolution_clock> w;
@@ -222,10 +255,10 @@ struct tester
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
-   double test_or()
+   double test_or(unsigned reps = 1000)
    {
       stopwatch<boost::chrono::high_resolution_clock> w;
-      for(unsigned i = 0; i < 1000; ++i)
+      for(unsigned i = 0; i < reps; ++i)
       {
          for(unsigned i = 0; i < b.size(); ++i)
             a[i] = b[i] | c[i];
@@ -242,10 +275,10 @@ struct tester
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
-   double test_and()
+   double test_and(unsigned reps = 1000)
    {
       stopwatch<boost::chrono::high_resolution_clock> w;
-      for(unsigned i = 0; i < 1000; ++i)
+      for(unsigned i = 0; i < reps; ++i)
       {
          for(unsigned i = 0; i < b.size(); ++i)
             a[i] = b[i] & c[i];
@@ -262,10 +295,10 @@ struct tester
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
-   double test_xor()
+   double test_xor(unsigned reps = 1000)
    {
       stopwatch<boost::chrono::high_resolution_clock> w;
-      for(unsigned i = 0; i < 1000; ++i)
+      for(unsigned i = 0; i < reps; ++i)
       {
          for(unsigned i = 0; i < b.size(); ++i)
             a[i] = b[i] ^ c[i];
@@ -282,51 +315,95 @@ struct tester
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
-   double test_complement()
+   double test_complement(unsigned reps = 1000)
    {
       stopwatch<boost::chrono::high_resolution_clock> w;
-      for(unsigned i = 0; i < 1000; ++i)
+      for(unsigned i = 0; i < reps; ++i)
       {
          for(unsigned i = 0; i < b.size(); ++i)
             a[i] = ~b[i];
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
-   double test_left_shift()
+   double test_left_shift(unsigned reps = 1000)
    {
       int max_shift = std::numeric_limits<T>::is_bounded ? std::numeric_limits<T>::digits : bits_wanted;
       int shift = 0;
       stopwatch<boost::chrono::high_resolution_clock> w;
-      for(unsigned i = 0; i < 1000; ++i)
+      for(unsigned i = 0; i < reps; ++i)
       {
          for(unsigned i = 0; i < b.size(); ++i)
             a[i] = b[i] << (shift++ % max_shift);
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
-   double test_right_shift()
+   double test_right_shift(unsigned reps = 1000)
    {
       int max_shift = 2 + std::numeric_limits<T>::is_bounded ? std::numeric_limits<T>::digits : bits_wanted;
       int shift  = 0;
       stopwatch<boost::chrono::high_resolution_clock> w;
-      for(unsigned i = 0; i < 1000; ++i)
+      for(unsigned i = 0; i < reps; ++i)
       {
          for(unsigned i = 0; i < b.size(); ++i)
             a[i] = b[i] >> (shift++) % max_shift;
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
-   double test_gcd()
+   double test_popcount(unsigned reps)
+   {
+      using boost::multiprecision::popcount;
+      unsigned total = 0;
+      stopwatch<boost::chrono::high_resolution_clock> w;
+      for(unsigned i = 0; i < reps; ++i)
+      {
+         for(unsigned i = 0; i < b.size(); ++i)
+            total += popcount(b[i] < 0 ? T(-b[i]) : b[i]);
+      }
+      double result = boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+      // Make sure the counts are used:
+      if(total == 1)
+         std::cout << total;
+      return result;
+   }
+   double test_gcd(unsigned reps = 1000)
    {
       using boost::integer::gcd;
       stopwatch<boost::chrono::high_resolution_clock> w;
-      for(unsigned i = 0; i < 1000; ++i)
+      for(unsigned i = 0; i < reps; ++i)
       {
          for(unsigned i = 0; i < b.size(); ++i)
             a[i] = gcd(b[i], c[i]);
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
+   double test_to_str(unsigned reps)
+   {
+      std::size_t len = 0;
+      stopwatch<boost::chrono::high_resolution_clock> w;
+      for(unsigned i = 0; i < reps; ++i)
+      {
+         for(unsigned i = 0; i < b.size(); ++i)
+            len += b[i].str().size();
+      }
+      double result = boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+      // Make sure the conversions aren't optimised away:
+      if(!len)
+         std::cout << len;
+      return result;
+   }
+   double test_from_str(unsigned reps)
+   {
+      std::vector<std::string> s;
+      for(unsigned i = 0; i < b.size(); ++i)
+         s.push_back(b[i].str());
+      stopwatch<boost::chrono::high_resolution_clock> w;
+      for(unsigned i = 0; i < reps; ++i)
+      {
+         for(unsigned i = 0; i < b.size(); ++i)
+            a[i] = T(s[i]);
+      }
+      return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+   }
    double test_powm()
    {
       stopwatch<boost::chrono::high_resolution_clock> w;
@@ -337,6 +414,56 @@ struct tester
       }
       return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
    }
+   //
+   // Repeated operations with the same odd modulus, with the free functions and then with
+   // a modular_context, the operands are reduced beforehand:
+   //
+   double test_powm_fixed_modulus(unsigned reps, bool use_context)
+   {
+      T m = c[0] | 1;
+      boost::multiprecision::modular_context<T> ctx(m);
+      std::vector<T> x(b.size()), y(b.size());
+      for(unsigned k = 0; k < b.size(); ++k)
+      {
+         x[k] = b[k] % m;
+         y[k] = c[k] % m;
+      }
+      stopwatch<boost::chrono::high_resolution_clock> w;
+      for(unsigned i = 0; i < reps; ++i)
+      {
+         for(unsigned k = 0; k < b.size(); ++k)
+         {
+            if(use_context)
+               ctx.powm(a[k], x[k], y[k]);
+            else
+               a[k] = powm(x[k], y[k], m);
+         }
+      }
+      return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+   }
+   double test_mulmod_fixed_modulus(unsigned reps, bool use_context)
+   {
+      T m = c[0] | 1;
+      boost::multiprecision::modular_context<T> ctx(m);
+      std::vector<T> x(b.size()), y(b.size());
+      for(unsigned k = 0; k < b.size(); ++k)
+      {
+         x[k] = b[k] % m;
+         y[k] = c[k] % m;
+      }
+      stopwatch<boost::chrono::high_resolution_clock> w;
+      for(unsigned i = 0; i < reps; ++i)
+      {
+         for(unsigned k = 0; k < b.size(); ++k)
+         {
+            if(use_context)
+               ctx.mulmod(a[k], x[k], y[k]);
+            else
+               a[k] = x[k] * y[k] % m;
+         }
+      }
+      return boost::chrono::duration_cast<boost::chrono::duration<double> >(w.elapsed()).count();
+   }
    double test_construct()
    {
       std::allocator<T> a;
@@ -703,6 +830,145 @@ void test(const char* type, unsigned precision)
    report_result(cat, type, "/=(unsigned long long)", precision, t.template test_inplace_divide_hetero<unsigned long long>());
 }
 
+//
+// Multiplication only, at sizes either side of the Karatsuba and Toom-Cook cutoffs and
+// upwards: the other operations are too slow at these sizes for a full test run, and we
+// use fewer values as generating them is expensive too.  To see where the crossover
+// between algorithms lies, compare against builds with BOOST_MP_KARATSUBA_CUTOFF,
+// BOOST_MP_TOOM3_CUTOFF or BOOST_MP_TOOM4_CUTOFF defined to some large value.
+//
+template <class Number>
+void test_large_multiply(const char* type)
+{
+   static const unsigned precisions[] = { 1536, 2560, 4096, 6144, 8192, 12288, 16384, 25600, 32768, 65536, 131072, 262144, 524288 };
+   for(unsigned i = 0; i < sizeof(precisions) / sizeof(precisions[0]); ++i)
+   {
+      bits_wanted = precisions[i];
+      tester<Number, boost::multiprecision::number_kind_integer> t(10);
+      unsigned reps = (std::max)(1u, 16u * 65536u / precisions[i]);
+      t.test_multiply(1);
+      report_result("integer", type, "*(large)", precisions[i], t.test_multiply(reps));
+   }
+}
+
+//
+// Division and remainder of a 2N-bit value by an N-bit one, at sizes either side of the
+// Burnikel-Ziegler cutoff and upwards.  Compare against a build with
+// BOOST_MP_BURNIKEL_ZIEGLER_CUTOFF defined to some large value to see the crossover.
+//
+template <class Number>
+void test_large_divide(const char* type)
+{
+   static const unsigned precisions[] = { 1024, 2048, 4096, 8192, 16384, 32768, 65536, 131072 };
+   for(unsigned i = 0; i < sizeof(precisions) / sizeof(precisions[0]); ++i)
+   {
+      bits_wanted = precisions[i];
+      tester<Number, boost::multiprecision::number_kind_integer> t(10);
+      unsigned reps = (std::max)(1u, 16u * 65536u / precisions[i]);
+      t.test_divide_wide(1);
+      report_result("integer", type, "/(large)", precisions[i], t.test_divide_wide(reps));
+      report_result("integer", type, "%(large)", precisions[i], t.test_mod_wide(reps));
+   }
+}
+
+//
+// GCD's of large values, through Lehmer's algorithm and then the half-GCD.  Compare against
+// a build with BOOST_MP_HGCD_CUTOFF defined to some large value to see the crossover.
+//
+template <class Number>
+void test_large_gcd(const char* type)
+{
+   static const unsigned precisions[] = { 2048, 4096, 8192, 16384, 32768, 65536, 131072, 262144 };
+   for(unsigned i = 0; i < sizeof(precisions) / sizeof(precisions[0]); ++i)
+   {
+      bits_wanted = precisions[i];
+      tester<Number, boost::multiprecision::number_kind_integer> t(10);
+      unsigned reps = (std::max)(1u, 16u * 65536u / precisions[i] / (precisions[i] / 1024));
+      report_result("integer", type, "gcd(large)", precisions[i], t.test_gcd(reps));
+   }
+}
+
+//
+// Bitwise operations on values large enough to be used as bit vectors:
+//
+template <class Number>
+void test_large_bitwise(const char* type)
+{
+   static const unsigned precisions[] = { 4096, 16384, 65536, 262144 };
+   for(unsigned i = 0; i < sizeof(precisions) / sizeof(precisions[0]); ++i)
+   {
+      bits_wanted = precisions[i];
+      tester<Number, boost::multiprecision::number_kind_integer> t(10);
+      unsigned reps = (std::max)(1u, 64u * 65536u / precisions[i]);
+      t.test_or(1);
+      report_result("integer", type, "|(large)", precisions[i], t.test_or(reps));
+      report_result("integer", type, "&(large)", precisions[i], t.test_and(reps));
+      report_result("integer", type, "^(large)", precisions[i], t.test_xor(reps));
+      report_result("integer", type, "<<(large)", precisions[i], t.test_left_shift(reps));
+      report_result("integer", type, ">>(large)", precisions[i], t.test_right_shift(reps));
+      report_result("integer", type, "popcount(large)", precisions[i], t.test_popcount(reps));
+   }
+}
+
+//
+// Conversion of values of 10^3 to 10^6 decimal digits to and from strings:
+//
+template <class Number>
+void test_large_str(const char* type)
+{
+   static const unsigned precisions[] = { 3322, 33220, 332193, 3321929 };
+   for(unsigned i = 0; i < sizeof(precisions) / sizeof(precisions[0]); ++i)
+   {
+      bits_wanted = precisions[i];
+      tester<Number, boost::multiprecision::number_kind_integer> t(1);
+      unsigned reps = (std::max)(1u, 1000000u / precisions[i]);
+      report_result("integer", type, "str(large)", precisions[i], t.test_to_str(reps));
+      report_result("integer", type, "parse(large)", precisions[i], t.test_from_str(reps));
+   }
+}
+
+//
+// Modular arithmetic with the same modulus throughout, with and without a modular_context:
+//
+template <class Number>
+void test_modular_context(const char* type)
+{
+   static const unsigned precisions[] = { 256, 512, 1024, 2048, 4096 };
+   for(unsigned i = 0; i < sizeof(precisions) / sizeof(precisions[0]); ++i)
+   {
+      bits_wanted = precisions[i];
+      tester<Number, boost::multiprecision::number_kind_integer> t(50);
+      unsigned reps = (std::max)(1u, 2u * 65536u / (precisions[i] * precisions[i] / 256));
+      report_result("integer", type, "powm(fixed modulus)", precisions[i], t.test_powm_fixed_modulus(reps, false));
+      report_result("integer", type, "powm(modular_context)", precisions[i], t.test_powm_fixed_modulus(reps, true));
+      report_result("integer", type, "mulmod(fixed modulus)", precisions[i], t.test_mulmod_fixed_modulus(1000 * reps, false));
+      report_result("integer", type, "mulmod(modular_context)", precisions[i], t.test_mulmod_fixed_modulus(1000 * reps, true));
+   }
+}
+
+#ifdef TEST_CPP_INT
+//
+// Arbitrary precision cpp_int's with differing amounts of inline storage (the MinBits template
+// parameter): values which fit in MinBits bits never touch the allocator.  Alongside the usual
+// timings we report the size of each type, and the number of allocations made by a test run as
+// recorded by counting_allocator.
+//
+template <unsigned MinBits>
+void test_inline_capacity(const char* type)
+{
+   typedef boost::multiprecision::number<boost::multiprecision::cpp_int_backend<MinBits, 0, boost::multiprecision::signed_magnitude, boost::multiprecision::unchecked, boost::multiprecision::counting_allocator<boost::multiprecision::limb_type> > > number_type;
+   static const unsigned precisions[] = { 128, 256, 512, 1024 };
+   for(unsigned i = 0; i < sizeof(precisions) / sizeof(precisions[0]); ++i)
+   {
+      boost::multiprecision::reset_thread_allocation_statistics();
+      test<number_type>(type, precisions[i]);
+      const boost::multiprecision::allocation_statistics& stats = boost::multiprecision::thread_allocation_statistics();
+      std::cout << std::left << std::setw(15) << type << std::setw(10) << precisions[i] << "sizeof = " << sizeof(number_type)
+         << ", allocations = " << stats.allocations << ", bytes allocated = " << stats.bytes_allocated << std::endl;
+   }
+}
+#endif
+
 void quickbook_results()
 {
    //
@@ -790,6 +1056,12 @@ int main()
    test<boost::multiprecision::mpz_int>("gmp_int", 256);
    test<boost::multiprecision::mpz_int>("gmp_int", 512);
    test<boost::multiprecision::mpz_int>("gmp_int", 1024);
+   test_large_multiply<boost::multiprecision::mpz_int>("gmp_int");
+   test_large_divide<boost::multiprecision::mpz_int>("gmp_int");
+   test_large_gcd<boost::multiprecision::mpz_int>("gmp_int");
+   test_large_bitwise<boost::multiprecision::mpz_int>("gmp_int");
+   test_large_str<boost::multiprecision::mpz_int>("gmp_int");
+   test_modular_context<boost::multiprecision::mpz_int>("gmp_int");
 #endif
 #ifdef TEST_CPP_INT
    //test<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<64, 64, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>, boost::multiprecision::et_off> >("cpp_int(unsigned, fixed)", 64);
@@ -798,11 +1070,30 @@ int main()
    test<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<256, 256, boost::multiprecision::signed_magnitude, boost::multiprecision::unchecked, void>, boost::multiprecision::et_off> >("cpp_int(fixed)", 256);
    test<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 512, boost::multiprecision::signed_magnitude, boost::multiprecision::unchecked, void>, boost::multiprecision::et_off> >("cpp_int(fixed)", 512);
    test<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<1024, 1024, boost::multiprecision::signed_magnitude, boost::multiprecision::unchecked, void>, boost::multiprecision::et_off> >("cpp_int(fixed)", 1024);
+   test<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<256, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>, boost::multiprecision::et_off> >("cpp_int(unsigned, fixed)", 256);
+   test<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 512, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>, boost::multiprecision::et_off> >("cpp_int(unsigned, fixed)", 512);
+   test<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<1024, 1024, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>, boost::multiprecision::et_off> >("cpp_int(unsigned, fixed)", 1024);
 
    test<boost::multiprecision::cpp_int>("cpp_int", 128);
    test<boost::multiprecision::cpp_int>("cpp_int", 256);
    test<boost::multiprecision::cpp_int>("cpp_int", 512);
    test<boost::multiprecision::cpp_int>("cpp_int", 1024);
+   test_large_multiply<boost::multiprecision::cpp_int>("cpp_int");
+   test_large_divide<boost::multiprecision::cpp_int>("cpp_int");
+   test_large_gcd<boost::multiprecision::cpp_int>("cpp_int");
+   test_large_bitwise<boost::multiprecision::cpp_int>("cpp_int");
+   test_large_str<boost::multiprecision::cpp_int>("cpp_int");
+   test_modular_context<boost::multiprecision::cpp_int>("cpp_int");
+   test_inline_capacity<0>("cpp_int(inline default)");
+   test_inline_capacity<256>("cpp_int(inline 256)");
+   test_inline_capacity<512>("cpp_int(inline 512)");
+   test_inline_capacity<1024>("cpp_int(inline 1024)");
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+   test<boost::multiprecision::pooled_cpp_int>("cpp_int(pooled)", 128);
+   test<boost::multiprecision::pooled_cpp_int>("cpp_int(pooled)", 256);
+   test<boost::multiprecision::pooled_cpp_int>("cpp_int(pooled)", 512);
+   test<boost::multiprecision::pooled_cpp_int>("cpp_int(pooled)", 1024);
+#endif
 #endif
 #ifdef TEST_CPP_INT_RATIONAL
    test<boost::multiprecision::cpp_rational>("cpp_rational", 128);
@@ -0,0 +1,27 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+#include <boost/multiprecision/cpp_int/pooled_allocator.hpp>
+
+#include "test_arithmetic.hpp"
+
+template <unsigned MinBits, unsigned MaxBits, boost::multiprecision::cpp_integer_type SignType, class Allocator, boost::multiprecision::expression_template_option ExpressionTemplates>
+struct is_twos_complement_integer<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<MinBits, MaxBits, SignType, boost::multiprecision::checked, Allocator>, ExpressionTemplates> > : public boost::mpl::false_ {};
+
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+template <>
+struct related_type<boost::multiprecision::pooled_cpp_int>
+{
+   typedef boost::multiprecision::int256_t type;
+};
+#endif
+
+int main()
+{
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+   test<boost::multiprecision::pooled_cpp_int>();
+#endif
+   return boost::report_errors();
+}
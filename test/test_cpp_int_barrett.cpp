@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Reduction by barrett_reducer, checked against x % m for odd and even moduli, moduli which are
+// powers of the limb base, and values both within the range reduced without division and beyond it.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include "test.hpp"
+#include "test_cpp_int_random.hpp"
+
+using namespace boost::multiprecision;
+
+static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+
+template <class Number>
+void check(const barrett_reducer<Number>& r, const Number& x)
+{
+   Number expected = x % r.modulus();
+   BOOST_CHECK_EQUAL(r.reduce(x), expected);
+   Number a = x;
+   r.reduce(a, a);
+   BOOST_CHECK_EQUAL(a, expected);
+   a = 0;
+   backends::eval_modulus(a.backend(), x.backend(), r);
+   BOOST_CHECK_EQUAL(a, expected);
+}
+
+template <class Number>
+void test_modulus(const cpp_int& m)
+{
+   barrett_reducer<Number> r((Number(m)));
+   BOOST_CHECK_EQUAL(r.modulus(), Number(m));
+   unsigned bits = msb(m) + 1;
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      cpp_int x = generate_random(2 * bits);
+      switch(i)
+      {
+      case 1: x = m * m - 1; break;
+      case 2: x = m * (m - 1); break;
+      case 3: x = m - 1; break;
+      case 4: x = m; break;
+      case 5: x = generate_random(bits / 2 + 1); break;
+      case 6: x = generate_random(3 * bits + limb_bits); break;
+      case 7: x = (cpp_int(1) << (2 * bits + limb_bits - 1)) - 1; break;
+      }
+      if(std::numeric_limits<Number>::is_bounded && (x > static_cast<cpp_int>((std::numeric_limits<Number>::max)())))
+         x &= static_cast<cpp_int>((std::numeric_limits<Number>::max)());
+      check(r, Number(x));
+      if(std::numeric_limits<Number>::is_signed)
+         check(r, Number(-x));
+   }
+}
+
+template <class Number>
+struct modulus_case
+{
+   void operator()(unsigned bits, unsigned i)const
+   {
+      cpp_int m = generate_random(bits);
+      switch(i)
+      {
+      case 0: m |= 1; break;
+      case 1: m &= ~cpp_int(1); break;
+      case 2: m = cpp_int(1) << (bits / limb_bits * limb_bits); break;
+      case 3: m = (cpp_int(1) << bits) - 1; break;
+      case 4: m = (cpp_int(1) << (bits - 1)) + 2; break;
+      }
+      test_modulus<Number>(m);
+   }
+};
+
+template <class Number>
+void test_sizes(unsigned max_bits)
+{
+   test_bit_sizes(2, max_bits, 6, modulus_case<Number>());
+}
+
+int main()
+{
+   test_sizes<cpp_int>(4000);
+   test_sizes<number<cpp_int_backend<0, 4096, signed_magnitude, checked> > >(1300);
+   test_sizes<int1024_t>(500);
+   test_sizes<number<cpp_int_backend<512, 512, unsigned_magnitude, unchecked, void> > >(250);
+   test_sizes<number<cpp_int_backend<64, 64, unsigned_magnitude, unchecked, void> > >(32);
+   //
+   // Moduli on either side of the cutoff, above which reduction is by division:
+   //
+   test_modulus<cpp_int>(generate_random((backends::barrett_cutoff - 1) * limb_bits));
+   test_modulus<cpp_int>(generate_random(backends::barrett_cutoff * limb_bits + 1));
+   //
+   // And in a fixed precision type large enough to hold moduli beyond the cutoff, where only those
+   // below it are reduced in stack storage:
+   //
+   typedef number<cpp_int_backend<32768, 32768, signed_magnitude, unchecked, void> > int32768_t;
+   test_modulus<int32768_t>(generate_random((backends::barrett_cutoff - 1) * limb_bits));
+   test_modulus<int32768_t>(generate_random(backends::barrett_cutoff * limb_bits + 1));
+#ifndef BOOST_NO_EXCEPTIONS
+   BOOST_CHECK_THROW(barrett_reducer<cpp_int>(cpp_int(0)), std::domain_error);
+   BOOST_CHECK_THROW(barrett_reducer<cpp_int>(cpp_int(-7)), std::domain_error);
+#endif
+   return boost::report_errors();
+}
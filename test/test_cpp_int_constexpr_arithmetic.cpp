@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Arithmetic on fixed precision cpp_int's in constant expressions: tables of results computed
+// at compile time are compared against the same operations carried out at runtime.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include "test.hpp"
+
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+
+using namespace boost::multiprecision;
+using namespace boost::multiprecision::literals;
+
+enum operation
+{
+   op_add, op_subtract, op_multiply, op_divide, op_modulus,
+   op_and, op_or, op_xor, op_complement, op_left_shift, op_right_shift, op_compare
+};
+
+static const unsigned operand_count = 7;
+
+//
+// Operands of assorted lengths and signs, including the values either side of the wrap around:
+//
+template <class T>
+BOOST_CXX14_CONSTEXPR T make_operand(unsigned i)
+{
+   T one(limb_type(1));
+   switch(i)
+   {
+   case 0:
+      return T();
+   case 1:
+      return one;
+   case 2:
+      return ~T();
+   case 3:
+      return one << (std::numeric_limits<T>::digits - 1);
+   default:
+      break;
+   }
+   T x = T(limb_type(i));
+   for(unsigned j = 0; j < 3 * i; ++j)
+      x = x * T(limb_type(0x9E3779B9u)) + T(limb_type(j));
+   if(i & 1)
+      x = T() - x;
+   return x;
+}
+
+template <class T>
+BOOST_CXX14_CONSTEXPR T apply(operation op, const T& a, const T& b, unsigned shift)
+{
+   switch(op)
+   {
+   case op_add:
+      return a + b;
+   case op_subtract:
+      return a - b;
+   case op_multiply:
+      return a * b;
+   case op_divide:
+      return b == T() ? T() : a / b;
+   case op_modulus:
+      return b == T() ? T() : a % b;
+   case op_and:
+      return a & b;
+   case op_or:
+      return a | b;
+   case op_xor:
+      return a ^ b;
+   case op_complement:
+      return ~a;
+   case op_left_shift:
+      return a << shift;
+   case op_right_shift:
+      return a >> shift;
+   case op_compare:
+      return T(limb_type((a < b) + 2 * (a > b) + 4 * (a <= b) + 8 * (a >= b) + 16 * (a == b) + 32 * (a != b)));
+   }
+   return T();
+}
+
+template <class T>
+struct result_table
+{
+   T values[operand_count][operand_count];
+};
+
+template <class T>
+BOOST_CXX14_CONSTEXPR result_table<T> make_table(operation op)
+{
+   const unsigned shifts[operand_count] = { 0, 1, 31, 64, 65, 129, std::numeric_limits<T>::digits - 1 };
+   T operands[operand_count] = {};
+   for(unsigned i = 0; i < operand_count; ++i)
+      operands[i] = make_operand<T>(i);
+   result_table<T> result = {};
+   for(unsigned i = 0; i < operand_count; ++i)
+      for(unsigned j = 0; j < operand_count; ++j)
+         result.values[i][j] = apply(op, operands[i], operands[j], shifts[j]);
+   return result;
+}
+
+template <class T>
+void check_table(operation op, const result_table<T>& table)
+{
+   const unsigned shifts[operand_count] = { 0, 1, 31, 64, 65, 129, std::numeric_limits<T>::digits - 1 };
+   for(unsigned i = 0; i < operand_count; ++i)
+   {
+      for(unsigned j = 0; j < operand_count; ++j)
+      {
+         T a = make_operand<T>(i), b = make_operand<T>(j);
+         BOOST_CHECK_EQUAL(table.values[i][j], apply(op, a, b, shifts[j]));
+      }
+   }
+}
+
+template <class T>
+void test()
+{
+   constexpr result_table<T> add = make_table<T>(op_add);
+   constexpr result_table<T> subtract = make_table<T>(op_subtract);
+   constexpr result_table<T> multiply = make_table<T>(op_multiply);
+   constexpr result_table<T> divide = make_table<T>(op_divide);
+   constexpr result_table<T> modulus = make_table<T>(op_modulus);
+   constexpr result_table<T> bit_and = make_table<T>(op_and);
+   constexpr result_table<T> bit_or = make_table<T>(op_or);
+   constexpr result_table<T> bit_xor = make_table<T>(op_xor);
+   constexpr result_table<T> complement = make_table<T>(op_complement);
+   constexpr result_table<T> left_shift = make_table<T>(op_left_shift);
+   constexpr result_table<T> right_shift = make_table<T>(op_right_shift);
+   constexpr result_table<T> compare = make_table<T>(op_compare);
+
+   check_table(op_add, add);
+   check_table(op_subtract, subtract);
+   check_table(op_multiply, multiply);
+   check_table(op_divide, divide);
+   check_table(op_modulus, modulus);
+   check_table(op_and, bit_and);
+   check_table(op_or, bit_or);
+   check_table(op_xor, bit_xor);
+   check_table(op_complement, complement);
+   check_table(op_left_shift, left_shift);
+   check_table(op_right_shift, right_shift);
+   check_table(op_compare, compare);
+}
+
+typedef number<cpp_int_backend<300, 300, unsigned_magnitude, unchecked, void>, et_off> uint300_t;
+typedef number<cpp_int_backend<300, 300, signed_magnitude, unchecked, void>, et_off> int300_t;
+
+//
+// Some values we know the answer to:
+//
+static_assert(~uint256_t() + uint256_t(limb_type(1)) == uint256_t(), "wrap around");
+static_assert(uint256_t() - uint256_t(limb_type(1)) == ~uint256_t(), "wrap around");
+static_assert((uint256_t(limb_type(1)) << 255) >> 255 == uint256_t(limb_type(1)), "shifts");
+static_assert((uint256_t(limb_type(1)) << 256) == uint256_t(), "shifts");
+static_assert(int256_t(-7) / int256_t(limb_type(2)) == int256_t(-3), "truncating division");
+static_assert(int256_t(-7) % int256_t(limb_type(2)) == int256_t(-1), "remainder takes the sign of the dividend");
+static_assert((int256_t(-7) >> 1) == int256_t(-4), "arithmetic shift");
+static_assert((int256_t(-6) & int256_t(limb_type(0xff))) == int256_t(limb_type(0xfa)), "two's complement");
+static_assert(~int256_t(limb_type(5)) == int256_t(-6), "complement");
+static_assert(-int256_t(limb_type(5)) < int256_t(-4), "comparison");
+static_assert((~uint300_t() >> 299) == uint300_t(limb_type(1)), "odd precision");
+static_assert(0xffffffffffffffffffffffffffffffff_cppui256 * 0xffffffffffffffffffffffffffffffff_cppui256
+   == 0xfffffffffffffffffffffffffffffffe00000000000000000000000000000001_cppui256, "literals");
+static_assert((uint1024_t(limb_type(3)) << 1000) / (uint1024_t(limb_type(3)) << 500) == uint1024_t(limb_type(1)) << 500, "long division");
+
+#endif
+
+int main()
+{
+#ifdef BOOST_MP_CPP_INT_CONSTEXPR_ARITHMETIC
+   test<uint256_t>();
+   test<int256_t>();
+   test<uint512_t>();
+   test<int512_t>();
+   test<uint300_t>();
+   test<int300_t>();
+#endif
+   return boost::report_errors();
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Compare the results of dividing large values - large enough to go
+// through the Burnikel-Ziegler recursive division - against GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include "test.hpp"
+#include "test_cpp_int_random.hpp"
+
+using namespace boost::multiprecision;
+
+template <class Number>
+void test_divide(const std::string& sx, const std::string& sy, bool negate_x, bool negate_y)
+{
+   mpz_int mx(sx), my(sy);
+   Number x(sx), y(sy);
+   if(negate_x)
+   {
+      mx = -mx;
+      x = -x;
+   }
+   if(negate_y)
+   {
+      my = -my;
+      y = -y;
+   }
+   mpz_int mq = mx / my;
+   mpz_int mr = mx % my;
+   Number q = x / y;
+   Number r = x % y;
+   BOOST_CHECK_EQUAL(q.sign(), mq.sign());
+   BOOST_CHECK_EQUAL(r.sign(), mr.sign());
+   BOOST_CHECK_EQUAL(to_hex(Number(abs(q))), to_hex(mpz_int(abs(mq))));
+   BOOST_CHECK_EQUAL(to_hex(Number(abs(r))), to_hex(mpz_int(abs(mr))));
+   Number q2, r2;
+   divide_qr(x, y, q2, r2);
+   BOOST_CHECK_EQUAL(q2, q);
+   BOOST_CHECK_EQUAL(r2, r);
+   //
+   // Aliased arguments:
+   //
+   q2 = x;
+   q2 /= y;
+   BOOST_CHECK_EQUAL(q2, q);
+   r2 = x;
+   r2 %= y;
+   BOOST_CHECK_EQUAL(r2, r);
+   BOOST_CHECK_EQUAL(q * y + r, x);
+}
+
+template <class Number>
+void test_divide(unsigned xs, unsigned ys, bool negate_x, bool negate_y)
+{
+   test_divide<Number>(generate_random_hex(xs), generate_random_hex(ys), negate_x, negate_y);
+}
+
+int main()
+{
+   const unsigned cutoff = boost::multiprecision::backends::burnikel_ziegler_cutoff;
+   const unsigned sizes[] = { 2, 3, cutoff - 1, cutoff, cutoff + 1, 2 * cutoff - 1, 2 * cutoff, 2 * cutoff + 1, 4 * cutoff + 3, 97, 128, 255, 1025 };
+
+   for(unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+   {
+      for(unsigned j = 0; j < sizeof(sizes) / sizeof(sizes[0]); ++j)
+      {
+         // Dividends from the same size as the divisor up to twice it, and very unbalanced:
+         test_divide<cpp_int>(sizes[i] + sizes[j], sizes[j], false, false);
+         test_divide<cpp_int>(sizes[i] + sizes[j], sizes[j], (i + j) & 1, j & 1);
+         test_divide<cpp_int>(sizes[j] + 1, sizes[j], i & 1, false);
+      }
+   }
+   test_divide<cpp_int>(3001, 1500, false, false);
+   test_divide<cpp_int>(5003, 1017, true, false);
+   //
+   // Divisors whose top limbs are all ones or a single bit, and dividends close to a multiple
+   // of the divisor, which make the estimated quotient digits wrong and need the fix-up paths:
+   //
+   for(unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+   {
+      unsigned bits = sizes[i] * sizeof(limb_type) * CHAR_BIT;
+      cpp_int y = (cpp_int(1) << bits) - 1;
+      cpp_int x = y * y;
+      test_divide<cpp_int>(to_hex_string(x), to_hex_string(y), false, false);
+      test_divide<cpp_int>(to_hex_string(cpp_int(x - 1)), to_hex_string(y), false, true);
+      y = cpp_int(1) << (bits - 1);
+      x = y * (y - 1) + (y - 1);
+      test_divide<cpp_int>(to_hex_string(x), to_hex_string(y), true, false);
+      x = cpp_int(generate_random_hex(2 * sizes[i] + 3));
+      y = cpp_int(generate_random_hex(sizes[i]));
+      test_divide<cpp_int>(to_hex_string(cpp_int(x - x % y)), to_hex_string(y), false, false);
+      test_divide<cpp_int>(to_hex_string(cpp_int(x - x % y - 1)), to_hex_string(y), false, false);
+   }
+   //
+   // Checked types with an upper bound on the size:
+   //
+   typedef number<cpp_int_backend<0, 8192, signed_magnitude, checked> > checked_alloc_int8192_t;
+   const unsigned limbs = 8192 / (sizeof(limb_type) * CHAR_BIT);
+   test_divide<checked_alloc_int8192_t>(limbs, limbs / 2, false, true);
+   test_divide<checked_alloc_int8192_t>(limbs, cutoff + 3, true, false);
+   test_divide<checked_alloc_int8192_t>(limbs - 1, limbs / 3, false, false);
+
+   return boost::report_errors();
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Division by a single limb with a precomputed reciprocal: divisor, divide_qr, integer_modulus
+// and the operators which use them, checked against q * d + r == x and 0 <= |r| < d.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include "test.hpp"
+#include "test_cpp_int_random.hpp"
+
+using namespace boost::multiprecision;
+
+static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+
+typedef number<cpp_int_backend<64, 64, unsigned_magnitude, unchecked, void> > trivial_uint;
+
+template <class T>
+void check(const T& x, limb_type d)
+{
+   divisor div(d);
+   T q, r;
+   divide_qr(x, div, q, r);
+   BOOST_CHECK_EQUAL(q * d + r, x);
+   BOOST_CHECK(abs(r) < d);
+   BOOST_CHECK((r == 0) || ((r < 0) == (x < 0)));
+   BOOST_CHECK_EQUAL(integer_modulus(x, div), T(abs(r)).template convert_to<limb_type>());
+   BOOST_CHECK_EQUAL(integer_modulus(x, d), T(abs(r)).template convert_to<limb_type>());
+   BOOST_CHECK_EQUAL(T(x / d), q);
+   BOOST_CHECK_EQUAL(T(x % d), r);
+   //
+   // Results aliasing the argument, and each other:
+   //
+   T a = x;
+   divide_qr(a, div, a, r);
+   BOOST_CHECK_EQUAL(a, q);
+   a = x;
+   divide_qr(a, div, q, a);
+   BOOST_CHECK_EQUAL(a, r);
+   a = x;
+   a /= d;
+   BOOST_CHECK_EQUAL(a, q);
+   a = x;
+   a %= d;
+   BOOST_CHECK_EQUAL(a, r);
+}
+
+void test_divisor()
+{
+   divisor d(10);
+   BOOST_CHECK_EQUAL(d.value(), 10u);
+   BOOST_CHECK_EQUAL(d.shift(), limb_bits - 4);
+   BOOST_CHECK_EQUAL(d.normalised(), limb_type(10) << (limb_bits - 4));
+   d = divisor(~limb_type(0));
+   BOOST_CHECK_EQUAL(d.shift(), 0u);
+   BOOST_CHECK_EQUAL(d.reciprocal(), 1u);
+#ifndef BOOST_NO_EXCEPTIONS
+   BOOST_CHECK_THROW(divisor(0), std::overflow_error);
+   cpp_int x = cpp_int(1) << 200;
+   BOOST_CHECK_THROW(x /= limb_type(0), std::overflow_error);
+   BOOST_CHECK_THROW(x %= limb_type(0), std::overflow_error);
+   BOOST_CHECK_THROW(integer_modulus(x, limb_type(0)), std::overflow_error);
+   BOOST_CHECK_THROW(integer_modulus(cpp_int(5), limb_type(0)), std::overflow_error);
+#endif
+}
+
+void test_values()
+{
+   const limb_type top_bit = limb_type(1) << (limb_bits - 1);
+   const limb_type divisors[] = { 1, 2, 3, 7, 10, 1000000007u, top_bit - 1, top_bit, top_bit + 1, ~limb_type(0) - 1, ~limb_type(0) };
+   const unsigned sizes[] = { 1, 2, 3, 4, 7, 16, 33, 100 };
+   for(unsigned i = 0; i < sizeof(divisors) / sizeof(divisors[0]); ++i)
+   {
+      for(unsigned j = 0; j < sizeof(sizes) / sizeof(sizes[0]); ++j)
+      {
+         for(unsigned k = 0; k < 5; ++k)
+         {
+            cpp_int x(generate_random_hex(sizes[j]));
+            check(x, divisors[i]);
+            check(cpp_int(-x), divisors[i]);
+            check(cpp_int(x * divisors[i]), divisors[i]);
+            check(cpp_int(x * divisors[i] - 1), divisors[i]);
+            limb_type d = cpp_int(generate_random_hex(1)).convert_to<limb_type>() >> (k * limb_bits / 5);
+            if(d)
+               check(x, d);
+         }
+      }
+   }
+   //
+   // Fixed precision and trivial types:
+   //
+   int1024_t f = (int1024_t(1) << 1000) - 12345;
+   check(f, 1000000007u);
+   check(int1024_t(-f), ~limb_type(0));
+   check(int128_t(12345), 10u);
+   trivial_uint t = 123456789u;
+   check(t, 10u);
+   check(t, 7u);
+}
+
+int main()
+{
+   test_divisor();
+   test_values();
+   return boost::report_errors();
+}
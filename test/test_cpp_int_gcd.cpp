@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Compare the results of gcd and lcm for large values - large enough to go
+// through Lehmer's algorithm and the half-GCD - against GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include "test.hpp"
+#include "test_cpp_int_random.hpp"
+
+using namespace boost::multiprecision;
+
+template <class Number>
+void test_gcd(const std::string& sx, const std::string& sy, bool negate_x, bool negate_y)
+{
+   mpz_int mx(sx), my(sy);
+   Number x(sx), y(sy);
+   if(negate_x)
+   {
+      mx = -mx;
+      x = -x;
+   }
+   if(negate_y)
+   {
+      my = -my;
+      y = -y;
+   }
+   mpz_int mg = gcd(mx, my);
+   Number g = gcd(x, y);
+   BOOST_CHECK_EQUAL(to_hex(g), to_hex(mg));
+   BOOST_CHECK_EQUAL(gcd(y, x), g);
+   mpz_int ml = lcm(mx, my);
+   BOOST_CHECK_EQUAL(to_hex(Number(lcm(x, y))), to_hex(ml));
+}
+
+template <class Number>
+void test_gcd(unsigned xs, unsigned ys, unsigned gs, bool negate_x, bool negate_y)
+{
+   //
+   // Values with a common factor of gs limbs, so that there's something to find:
+   //
+   cpp_int g = gs ? cpp_int(generate_random_hex(gs)) : cpp_int(1);
+   cpp_int x = cpp_int(generate_random_hex(xs)) * g;
+   cpp_int y = cpp_int(generate_random_hex(ys)) * g;
+   test_gcd<Number>(to_hex_string(x), to_hex_string(y), negate_x, negate_y);
+}
+
+int main()
+{
+   const unsigned cutoff = boost::multiprecision::backends::hgcd_cutoff;
+   const unsigned sizes[] = { 1, 2, 3, 4, 7, 16, 33, 100, cutoff - 1, cutoff + 1, 2 * cutoff + 5, 5 * cutoff };
+
+   for(unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+   {
+      for(unsigned j = 0; j <= i; ++j)
+      {
+         test_gcd<cpp_int>(sizes[i], sizes[j], 0, false, false);
+         test_gcd<cpp_int>(sizes[i], sizes[j], sizes[j] / 3, i & 1, j & 1);
+      }
+      test_gcd<cpp_int>(sizes[i], sizes[i], 1, false, true);
+      test_gcd<cpp_int>(sizes[i], sizes[i], sizes[i] / 2 + 1, true, false);
+   }
+   //
+   // Values which are very close together, powers of two, and ones with common powers of 2:
+   //
+   for(unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+   {
+      unsigned bits = sizes[i] * sizeof(limb_type) * CHAR_BIT;
+      cpp_int x(generate_random_hex(sizes[i]));
+      cpp_int d(generate_random_hex(sizes[i] / 3 + 1));
+      test_gcd<cpp_int>(to_hex_string(x), to_hex_string(cpp_int(x + d)), false, false);
+      test_gcd<cpp_int>(to_hex_string(x), to_hex_string(cpp_int(x + 1)), false, false);
+      test_gcd<cpp_int>(to_hex_string(cpp_int(x << 70)), to_hex_string(cpp_int(d << 3)), false, false);
+      test_gcd<cpp_int>(to_hex_string(cpp_int(cpp_int(1) << bits)), to_hex_string(cpp_int(d << 50)), false, false);
+      // Consecutive Fibonacci numbers, which take the most steps:
+      cpp_int f0(0), f1(1);
+      while(msb(f1) < bits)
+      {
+         f0 += f1;
+         f0.swap(f1);
+      }
+      test_gcd<cpp_int>(to_hex_string(f1), to_hex_string(f0), false, false);
+      test_gcd<cpp_int>(to_hex_string(cpp_int(f1 * d)), to_hex_string(cpp_int(f0 * d)), false, false);
+   }
+   //
+   // Fixed precision and checked types:
+   //
+   const unsigned limbs = 1024 / (sizeof(limb_type) * CHAR_BIT);
+   test_gcd<int1024_t>(limbs / 4, limbs / 4, limbs / 8, false, true);
+   test_gcd<int1024_t>(limbs / 2 - 1, 3, 2, false, false);
+   test_gcd<checked_int1024_t>(limbs / 4, limbs / 4 - 1, limbs / 8, true, false);
+   typedef number<cpp_int_backend<0, 65536, signed_magnitude, checked> > checked_alloc_int65536_t;
+   test_gcd<checked_alloc_int65536_t>(cutoff, cutoff - 3, 17, false, false);
+
+   return boost::report_errors();
+}
@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Compare the results of gcdext and inverse_mod against GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/integer.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+#include "test_cpp_int_random.hpp"
+
+using namespace boost::multiprecision;
+
+template <class Number>
+void test_gcdext(const std::string& sx, const std::string& sy, bool negate_x, bool negate_y)
+{
+   mpz_int mx(sx), my(sy), ms, mt;
+   Number x(sx), y(sy), s, t;
+   if(negate_x)
+   {
+      mx = -mx;
+      x = -x;
+   }
+   if(negate_y)
+   {
+      my = -my;
+      y = -y;
+   }
+   mpz_int mg = gcdext(mx, my, ms, mt);
+   Number g = gcdext(x, y, s, t);
+   //
+   // The cofactors are the smallest possible, so they should be the same as GMP's,
+   // compare in decimal as negative values can't be printed in hex:
+   //
+   BOOST_CHECK_EQUAL(g.str(), mg.str());
+   BOOST_CHECK_EQUAL(s.str(), ms.str());
+   BOOST_CHECK_EQUAL(t.str(), mt.str());
+   BOOST_CHECK_EQUAL(cpp_int(x) * cpp_int(s) + cpp_int(y) * cpp_int(t), cpp_int(g));
+   BOOST_CHECK_EQUAL(g, gcd(x, y));
+}
+
+template <class Number>
+void test_inverse(const std::string& sx, const std::string& sm, bool negate_x)
+{
+   mpz_int mx(sx), mm(sm);
+   if(negate_x)
+      mx = -mx;
+   Number x(mx.str()), m(sm);
+   if(gcd(mx, mm) == 1)
+   {
+      Number inv = inverse_mod(x, m);
+      BOOST_CHECK_EQUAL(inv.str(), mpz_int(inverse_mod(mx, mm)).str());
+      BOOST_CHECK(inv >= 0);
+      BOOST_CHECK(inv < m);
+      if(mm != 1)
+         BOOST_CHECK_EQUAL(cpp_int(cpp_int(x) * cpp_int(inv) % cpp_int(m)) + (x < 0 ? cpp_int(m) : cpp_int(0)), cpp_int(1));
+   }
+   else
+   {
+      BOOST_CHECK_THROW(inverse_mod(x, m), std::domain_error);
+      BOOST_CHECK_THROW(inverse_mod(mx, mm), std::domain_error);
+   }
+}
+
+template <class Number>
+void test_gcdext(unsigned xs, unsigned ys, unsigned gs, bool negate_x, bool negate_y)
+{
+   //
+   // Values with a common factor of gs limbs, so that there's something to find:
+   //
+   cpp_int g = gs ? cpp_int(generate_random_hex(gs)) : cpp_int(1);
+   cpp_int x = cpp_int(generate_random_hex(xs)) * g;
+   cpp_int y = cpp_int(generate_random_hex(ys)) * g;
+   test_gcdext<Number>(to_hex_string(x), to_hex_string(y), negate_x, negate_y);
+   test_inverse<Number>(to_hex_string(x), to_hex_string(y), negate_x);
+   if(!gs)
+      test_inverse<Number>(to_hex_string(y), to_hex_string(x), negate_y);
+}
+
+//
+// The fixed width types which wrap a single built in integer use the generic algorithms, which must
+// not overflow however close the operands are to the width of the type:
+//
+template <class Number>
+void test_trivial_gcdext(const std::string& x, const std::string& y, unsigned i, const boost::mpl::true_&)
+{
+   test_gcdext<Number>(x, y, i & 1, i & 2);
+}
+template <class Number>
+void test_trivial_gcdext(const std::string&, const std::string&, unsigned, const boost::mpl::false_&)
+{
+   // gcdext needs signed cofactors.
+}
+
+template <class Number>
+void test_trivial()
+{
+   static const bool is_signed = std::numeric_limits<Number>::is_signed;
+   const unsigned max_bits = std::numeric_limits<Number>::digits;
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      unsigned bits = max_bits - i % 8;
+      std::string x = to_hex_string(generate_random(bits - i % 3 * 20));
+      std::string y = to_hex_string(generate_random(bits));
+      test_trivial_gcdext<Number>(x, y, i, boost::mpl::bool_<is_signed>());
+      test_inverse<Number>(x, y, is_signed && (i & 1));
+   }
+}
+
+template <class I>
+void test_builtin()
+{
+   boost::random::mt19937 gen;
+   boost::random::uniform_int_distribution<I> dist((std::numeric_limits<I>::min)() / 2, (std::numeric_limits<I>::max)() / 2);
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      I x = dist(gen), y = dist(gen), s, t;
+      if(i % 10 == 0)
+      {
+         x = static_cast<I>(x / 3);
+         y = static_cast<I>(x * 3);
+      }
+      cpp_int cs, ct;
+      cpp_int cg = gcdext(cpp_int(x), cpp_int(y), cs, ct);
+      I g = gcdext(x, y, s, t);
+      BOOST_CHECK_EQUAL(cpp_int(g), cg);
+      BOOST_CHECK_EQUAL(cpp_int(s), cs);
+      BOOST_CHECK_EQUAL(cpp_int(t), ct);
+      if(y > 0)
+      {
+         if(cg == 1)
+         {
+            BOOST_CHECK_EQUAL(cpp_int(inverse_mod(x, y)), inverse_mod(cpp_int(x), cpp_int(y)));
+         }
+         else
+         {
+            BOOST_CHECK_THROW(inverse_mod(x, y), std::domain_error);
+         }
+      }
+   }
+}
+
+int main()
+{
+   const unsigned sizes[] = { 1, 2, 3, 4, 7, 16, 33, 100, 300 };
+
+   for(unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+   {
+      for(unsigned j = 0; j <= i; ++j)
+      {
+         test_gcdext<cpp_int>(sizes[i], sizes[j], 0, false, false);
+         test_gcdext<cpp_int>(sizes[j], sizes[i], 0, i & 1, j & 1);
+         test_gcdext<cpp_int>(sizes[i], sizes[j], sizes[j] / 3, j & 1, i & 1);
+      }
+      test_gcdext<cpp_int>(sizes[i], sizes[i], 1, false, true);
+   }
+   //
+   // Values which are very close together or equal, zeros, ones, and consecutive Fibonacci numbers,
+   // which take the most steps and have the largest quotients last:
+   //
+   for(unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+   {
+      unsigned bits = sizes[i] * sizeof(limb_type) * CHAR_BIT;
+      cpp_int x(generate_random_hex(sizes[i]));
+      cpp_int d(generate_random_hex(sizes[i] / 3 + 1));
+      test_gcdext<cpp_int>(to_hex_string(x), to_hex_string(cpp_int(x + d)), false, true);
+      test_gcdext<cpp_int>(to_hex_string(x), to_hex_string(cpp_int(x + 1)), true, false);
+      test_gcdext<cpp_int>(to_hex_string(x), to_hex_string(x), false, true);
+      test_gcdext<cpp_int>(to_hex_string(x), "0", true, false);
+      test_gcdext<cpp_int>("0", to_hex_string(x), false, true);
+      test_gcdext<cpp_int>(to_hex_string(x), "1", false, false);
+      test_inverse<cpp_int>(to_hex_string(x), "1", false);
+      test_inverse<cpp_int>("0", to_hex_string(x), false);
+      cpp_int f0(0), f1(1);
+      while(msb(f1) < bits)
+      {
+         f0 += f1;
+         f0.swap(f1);
+      }
+      test_gcdext<cpp_int>(to_hex_string(f1), to_hex_string(f0), false, false);
+      test_gcdext<cpp_int>(to_hex_string(cpp_int(f1 * d)), to_hex_string(cpp_int(f0 * d)), true, true);
+      test_inverse<cpp_int>(to_hex_string(f0), to_hex_string(f1), true);
+   }
+   test_gcdext<cpp_int>("0", "0", false, false);
+   BOOST_CHECK_THROW(inverse_mod(cpp_int(3), cpp_int(0)), std::domain_error);
+   BOOST_CHECK_THROW(inverse_mod(cpp_int(3), cpp_int(-7)), std::domain_error);
+   //
+   // Fixed precision, checked and unsigned types:
+   //
+   const unsigned limbs = 1024 / (sizeof(limb_type) * CHAR_BIT);
+   test_gcdext<int1024_t>(limbs, limbs - 1, 0, false, true);
+   test_gcdext<int1024_t>(limbs / 2, 3, 2, true, false);
+   test_gcdext<checked_int1024_t>(limbs / 2, limbs / 2 - 1, limbs / 4, true, false);
+   test_gcdext<checked_int1024_t>(limbs - 1, limbs, 0, false, false);
+   test_inverse<uint1024_t>(generate_random_hex(limbs), generate_random_hex(limbs - 1), false);
+   test_inverse<checked_uint1024_t>(generate_random_hex(limbs / 2), generate_random_hex(limbs), false);
+   test_inverse<number<cpp_int_backend<200, 200, unsigned_magnitude, checked, void> > >("0x3", "0xfffffffffffffffffffffffffffffffffffffffffffffffff7", false);
+
+   test_trivial<int128_t>();
+   test_trivial<uint128_t>();
+   test_trivial<number<cpp_int_backend<64, 64, signed_magnitude, unchecked, void> > >();
+   test_trivial<number<cpp_int_backend<64, 64, unsigned_magnitude, unchecked, void> > >();
+   test_trivial<number<cpp_int_backend<100, 100, signed_magnitude, checked, void> > >();
+
+   test_builtin<boost::int64_t>();
+   test_builtin<int>();
+   test_builtin<short>();
+
+   return boost::report_errors();
+}
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Compare the results of multiplying large values - large enough to
+// go through the Karatsuba, Toom-Cook and number theoretic transform code - against GMP.
+// Squares are checked as well, since they have their own code path.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include "test.hpp"
+#include "test_cpp_int_random.hpp"
+
+using namespace boost::multiprecision;
+
+template <class Number>
+void test_multiply(unsigned as, unsigned bs, bool negate_a, bool negate_b)
+{
+   std::string sa = generate_random_hex(as);
+   std::string sb = generate_random_hex(bs);
+   mpz_int ma(sa), mb(sb);
+   Number a(sa), b(sb);
+   if(negate_a)
+   {
+      ma = -ma;
+      a = -a;
+   }
+   if(negate_b)
+   {
+      mb = -mb;
+      b = -b;
+   }
+   mpz_int mr = ma * mb;
+   Number r = a * b;
+   BOOST_CHECK_EQUAL(r.sign(), mr.sign());
+   BOOST_CHECK_EQUAL(to_hex(Number(abs(r))), to_hex(mpz_int(abs(mr))));
+   //
+   // Aliased arguments:
+   //
+   r = a;
+   r *= b;
+   BOOST_CHECK_EQUAL(to_hex(Number(abs(r))), to_hex(mpz_int(abs(mr))));
+   r = b;
+   r *= a;
+   BOOST_CHECK_EQUAL(to_hex(Number(abs(r))), to_hex(mpz_int(abs(mr))));
+   mr = ma * ma;
+   r = a * a;
+   BOOST_CHECK_EQUAL(to_hex(r), to_hex(mr));
+   r = a;
+   r *= r;
+   BOOST_CHECK_EQUAL(to_hex(r), to_hex(mr));
+}
+
+template <class Number>
+void test_fixed(unsigned as, unsigned bs)
+{
+   std::string sa = generate_random_hex(as);
+   std::string sb = generate_random_hex(bs);
+   mpz_int ma(sa), mb(sb);
+   Number a(sa), b(sb);
+   mpz_int mr = ma * mb;
+   Number r = a * b;
+   BOOST_CHECK_EQUAL(to_hex(r), to_hex(mr));
+   mr = ma * ma;
+   r = a * a;
+   BOOST_CHECK_EQUAL(to_hex(r), to_hex(mr));
+   r = a;
+   r *= r;
+   BOOST_CHECK_EQUAL(to_hex(r), to_hex(mr));
+}
+
+int main()
+{
+   const unsigned cutoff = boost::multiprecision::backends::karatsuba_cutoff;
+   const unsigned toom3 = boost::multiprecision::backends::toom3_cutoff;
+   const unsigned toom4 = boost::multiprecision::backends::toom4_cutoff;
+   const unsigned sizes[] = { 2, 3, 5, cutoff - 1, cutoff, cutoff + 1, 2 * cutoff - 1, 2 * cutoff, 2 * cutoff + 3, 97, toom3, toom3 + 1, toom3 + 2, 255, toom4, toom4 + 1, toom4 + 2, 1025, 3001 };
+
+   for(unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+   {
+      for(unsigned j = 0; j <= i; ++j)
+      {
+         test_multiply<cpp_int>(sizes[i], sizes[j], false, false);
+         test_multiply<cpp_int>(sizes[j], sizes[i], (i + j) & 1, j & 1);
+      }
+   }
+   //
+   // Number theoretic transform, including all-ones values which maximise the convolution
+   // coefficients, and so the range needed in the Chinese remainder reconstruction:
+   //
+   const unsigned ntt = boost::multiprecision::backends::ntt_cutoff;
+   test_multiply<cpp_int>(ntt, ntt, false, true);
+   test_multiply<cpp_int>(ntt + 1, ntt, true, false);
+   test_multiply<cpp_int>(3 * ntt + 7, ntt + 2, false, false);
+   {
+      cpp_int a = (cpp_int(1) << (ntt * 2 * sizeof(limb_type) * CHAR_BIT)) - 1;
+      mpz_int ma = (mpz_int(1) << (ntt * 2 * sizeof(limb_type) * CHAR_BIT)) - 1;
+      BOOST_CHECK_EQUAL(to_hex(cpp_int(a * a)), to_hex(mpz_int(ma * ma)));
+      BOOST_CHECK_EQUAL(to_hex(cpp_int(a * (a - 1))), to_hex(mpz_int(ma * (ma - 1))));
+   }
+   //
+   // Fixed precision types, with the product fitting, and not quite fitting (truncated) in the result:
+   //
+   typedef number<cpp_int_backend<8192, 8192, unsigned_magnitude, unchecked, void> > uint8192_t;
+   typedef number<cpp_int_backend<8192, 8192, signed_magnitude, checked, void> > checked_int8192_t;
+   typedef number<cpp_int_backend<0, 8192, signed_magnitude, checked> > checked_alloc_int8192_t;
+   test_fixed<uint8192_t>(64, 64);
+   test_fixed<uint8192_t>(41, 87);
+   test_fixed<checked_int8192_t>(64, 63);
+   test_fixed<checked_alloc_int8192_t>(50, 70);
+   //
+   // Types too large to put the temporaries on the stack use long multiplication instead:
+   //
+   typedef number<cpp_int_backend<16384, 16384, unsigned_magnitude, unchecked, void> > uint16384_t;
+   typedef number<cpp_int_backend<16384, 16384, signed_magnitude, checked, void> > checked_int16384_t;
+   test_fixed<uint16384_t>(128, 128);
+   test_fixed<uint16384_t>(100, 150);
+   test_fixed<checked_int16384_t>(127, 128);
+   {
+      const unsigned limbs = 4096 / (sizeof(limb_type) * CHAR_BIT);
+      std::string sa = generate_random_hex(limbs), sb = generate_random_hex(limbs + 1);
+      mpz_int mr = mpz_int(sa) * mpz_int(sb);
+      mr &= (mpz_int(1) << 8192) - 1;
+      BOOST_CHECK_EQUAL(to_hex(uint8192_t(sa) * uint8192_t(sb)), to_hex(mr));
+      mr = mpz_int(sb) * mpz_int(sb);
+      mr &= (mpz_int(1) << 8192) - 1;
+      uint8192_t r(sb);
+      r *= r;
+      BOOST_CHECK_EQUAL(to_hex(r), to_hex(mr));
+#ifndef BOOST_NO_EXCEPTIONS
+      BOOST_CHECK_THROW(checked_int8192_t(sa) * checked_int8192_t(sb), std::overflow_error);
+      checked_int8192_t cr(sb);
+      BOOST_CHECK_THROW(cr *= cr, std::overflow_error);
+#endif
+   }
+
+   return boost::report_errors();
+}
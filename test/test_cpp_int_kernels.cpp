@@ -0,0 +1,430 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Compare the limb kernels selected at runtime for this CPU against the generic versions,
+// over all the lengths around the unrolling and dispatch boundaries, both in place and not.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+#include <vector>
+
+using namespace boost::multiprecision;
+using namespace boost::multiprecision::backends::detail;
+
+boost::random::mt19937 gen;
+
+//
+// Random limbs, with runs of zeros and all ones so that carries propagate:
+//
+std::vector<limb_type> generate_random_limbs(unsigned n)
+{
+   boost::random::uniform_int_distribution<limb_type> limb;
+   boost::random::uniform_int_distribution<unsigned> mode(0, 3);
+   std::vector<limb_type> result(n + 1);
+   for(unsigned i = 0; i < n; ++i)
+   {
+      unsigned m = mode(gen);
+      result[i] = m == 0 ? 0 : m == 1 ? ~static_cast<limb_type>(0u) : limb(gen);
+   }
+   return result;
+}
+
+typedef limb_type (*shift_kernel)(limb_type*, const limb_type*, unsigned, unsigned);
+typedef void (*bitwise_kernel)(limb_type*, const limb_type*, const limb_type*, unsigned);
+typedef void (*unary_kernel)(limb_type*, const limb_type*, unsigned);
+typedef unsigned (*popcount_kernel)(const limb_type*, unsigned);
+
+void test_bitwise(bitwise_kernel k, bitwise_kernel generic, unsigned n)
+{
+   std::vector<limb_type> a = generate_random_limbs(n), b = generate_random_limbs(n), r1(n + 1), r2(n + 1);
+   k(&r1[0], &a[0], &b[0], n);
+   generic(&r2[0], &a[0], &b[0], n);
+   BOOST_CHECK(r1 == r2);
+   r1 = b;
+   r2 = b;
+   k(&r1[0], &a[0], &r1[0], n);
+   generic(&r2[0], &a[0], &r2[0], n);
+   BOOST_CHECK(r1 == r2);
+}
+
+void test_unary(unary_kernel k, unary_kernel generic, unsigned n)
+{
+   std::vector<limb_type> a = generate_random_limbs(n), r1(n + 1), r2(n + 1);
+   k(&r1[0], &a[0], n);
+   generic(&r2[0], &a[0], n);
+   BOOST_CHECK(r1 == r2);
+   r1 = a;
+   r2 = a;
+   k(&r1[0], &r1[0], n);
+   generic(&r2[0], &r2[0], n);
+   BOOST_CHECK(r1 == r2);
+}
+
+void test_popcount(popcount_kernel k, unsigned n)
+{
+   std::vector<limb_type> a = generate_random_limbs(n);
+   unsigned count = 0;
+   for(unsigned i = 0; i < n; ++i)
+      for(limb_type l = a[i]; l; l >>= 1)
+         count += l & 1u;
+   BOOST_CHECK_EQUAL(k(&a[0], n), count);
+   BOOST_CHECK_EQUAL(popcount_limbs_n_generic(&a[0], n), count);
+}
+
+//
+// The bitwise operators on negative values, against the two's complement of each argument modulo 2^bits:
+//
+template <class Op>
+void test_negative_bitwise(const cpp_int& a, const cpp_int& b, Op op, unsigned bits)
+{
+   cpp_int modulus = cpp_int(1) << bits;
+   cpp_int ta = a < 0 ? cpp_int(modulus + a) : a;
+   cpp_int tb = b < 0 ? cpp_int(modulus + b) : b;
+   cpp_int expected = op(ta, tb);
+   if(bit_test(expected, bits - 1))
+      expected -= modulus;
+   BOOST_CHECK_EQUAL(op(a, b), expected);
+   cpp_int r(a);
+   r = op(r, b);
+   BOOST_CHECK_EQUAL(r, expected);
+}
+
+struct and_op
+{
+   cpp_int operator()(const cpp_int& a, const cpp_int& b)const { return a & b; }
+};
+struct or_op
+{
+   cpp_int operator()(const cpp_int& a, const cpp_int& b)const { return a | b; }
+};
+struct xor_op
+{
+   cpp_int operator()(const cpp_int& a, const cpp_int& b)const { return a ^ b; }
+};
+
+//
+// The fixed precision types with unrolled arithmetic, against cpp_int reduced modulo 2^Bits,
+// for arguments of all lengths and both in place and not:
+//
+template <class Number>
+void test_unrolled()
+{
+   static const unsigned bits = std::numeric_limits<Number>::digits;
+   static const unsigned limb_count = bits / (sizeof(limb_type) * CHAR_BIT) + 1;
+   cpp_int modulus = cpp_int(1) << bits;
+   for(unsigned i = 0; i < 500; ++i)
+   {
+      std::vector<limb_type> la = generate_random_limbs(1 + i % limb_count), lb = generate_random_limbs(1 + (i / limb_count) % limb_count);
+      cpp_int a, b;
+      import_bits(a, la.rbegin(), la.rend());
+      import_bits(b, lb.rbegin(), lb.rend());
+      a %= modulus;
+      b %= modulus;
+      if(std::numeric_limits<Number>::is_signed)
+      {
+         if(i & 1)
+            a = -a;
+         if(i & 2)
+            b = -b;
+      }
+      Number na(a), nb(b);
+      cpp_int sum = a + b, difference = a - b, product = a * b;
+      if(std::numeric_limits<Number>::is_signed)
+      {
+         sum = abs(sum) % modulus * sign(sum);
+         difference = abs(difference) % modulus * sign(difference);
+         product = abs(product) % modulus * sign(product);
+      }
+      else
+      {
+         sum = (sum % modulus + modulus) % modulus;
+         difference = (difference % modulus + modulus) % modulus;
+         product = (product % modulus + modulus) % modulus;
+      }
+      BOOST_CHECK_EQUAL(cpp_int(Number(na + nb)), sum);
+      BOOST_CHECK_EQUAL(cpp_int(Number(na - nb)), difference);
+      BOOST_CHECK_EQUAL(cpp_int(Number(na * nb)), product);
+      Number r(na);
+      r += nb;
+      BOOST_CHECK_EQUAL(cpp_int(r), sum);
+      r = na;
+      r -= nb;
+      BOOST_CHECK_EQUAL(cpp_int(r), difference);
+      r = na;
+      r *= nb;
+      BOOST_CHECK_EQUAL(cpp_int(r), product);
+      r = nb;
+      r = na * r;
+      BOOST_CHECK_EQUAL(cpp_int(r), product);
+      r = na;
+      r *= r;
+      BOOST_CHECK_EQUAL(cpp_int(r), cpp_int(a * a % modulus));
+      r = na;
+      r -= r;
+      BOOST_CHECK_EQUAL(r, 0);
+      BOOST_CHECK_EQUAL(na < nb, a < b);
+      BOOST_CHECK_EQUAL(na == nb, a == b);
+   }
+}
+
+#ifdef BOOST_HAS_INT128
+//
+// The 128-bit types are trivial wrappers around unsigned __int128, check they really are, and
+// that they give the same results as the native type:
+//
+void test_native_int128()
+{
+   BOOST_STATIC_ASSERT(backends::is_trivial_cpp_int<uint128_t::backend_type>::value);
+   BOOST_STATIC_ASSERT(backends::is_trivial_cpp_int<int128_t::backend_type>::value);
+   BOOST_STATIC_ASSERT(backends::is_trivial_cpp_int<checked_uint128_t::backend_type>::value);
+   for(unsigned i = 0; i < 500; ++i)
+   {
+      std::vector<limb_type> la = generate_random_limbs(2), lb = generate_random_limbs(1 + i % 2);
+      double_limb_type a = la[0] | (static_cast<double_limb_type>(la[1]) << 64);
+      double_limb_type b = lb[0] | (static_cast<double_limb_type>(lb[1]) << 64);
+      uint128_t na(a), nb(b);
+      BOOST_CHECK(uint128_t(na + nb) == uint128_t(static_cast<double_limb_type>(a + b)));
+      BOOST_CHECK(uint128_t(na - nb) == uint128_t(static_cast<double_limb_type>(a - b)));
+      BOOST_CHECK(uint128_t(na * nb) == uint128_t(static_cast<double_limb_type>(a * b)));
+      BOOST_CHECK(uint128_t(na ^ nb) == uint128_t(static_cast<double_limb_type>(a ^ b)));
+      BOOST_CHECK(uint128_t(na << (i % 128)) == uint128_t(static_cast<double_limb_type>(a << (i % 128))));
+      BOOST_CHECK(uint128_t(na >> (i % 128)) == uint128_t(static_cast<double_limb_type>(a >> (i % 128))));
+      BOOST_CHECK_EQUAL(na < nb, a < b);
+      if(b)
+      {
+         BOOST_CHECK(uint128_t(na / nb) == uint128_t(static_cast<double_limb_type>(a / b)));
+         BOOST_CHECK(uint128_t(na % nb) == uint128_t(static_cast<double_limb_type>(a % b)));
+      }
+      //
+      // int128_t is sign-magnitude, so stick to values which don't overflow the native type:
+      //
+      signed_double_limb_type sa = static_cast<signed_double_limb_type>(a >> 65), sb = static_cast<signed_double_limb_type>(b >> 66);
+      if(i & 1)
+         sa = -sa;
+      if(i & 2)
+         sb = -sb;
+      int128_t nsa(sa), nsb(sb);
+      BOOST_CHECK(int128_t(nsa + nsb) == int128_t(static_cast<signed_double_limb_type>(sa + sb)));
+      BOOST_CHECK(int128_t(nsa - nsb) == int128_t(static_cast<signed_double_limb_type>(sa - sb)));
+      BOOST_CHECK(int128_t(nsa * (nsb >> 64)) == int128_t(static_cast<signed_double_limb_type>(sa * (sb >> 64))));
+      BOOST_CHECK_EQUAL(nsa < nsb, sa < sb);
+      if(sb)
+      {
+         BOOST_CHECK(int128_t(nsa / nsb) == int128_t(static_cast<signed_double_limb_type>(sa / sb)));
+         BOOST_CHECK(int128_t(nsa % nsb) == int128_t(static_cast<signed_double_limb_type>(sa % sb)));
+      }
+   }
+}
+#endif
+
+void test_shift(shift_kernel k, shift_kernel generic, unsigned n, bool left)
+{
+   for(unsigned shift = 1; shift < sizeof(limb_type) * CHAR_BIT; shift += 7)
+   {
+      std::vector<limb_type> x = generate_random_limbs(n + 1), r1(n + 2), r2(n + 2);
+      BOOST_CHECK_EQUAL(k(&r1[0], &x[0], n, shift), generic(&r2[0], &x[0], n, shift));
+      BOOST_CHECK(r1 == r2);
+      // Overlapping by one limb, in the direction the kernel allows:
+      r1 = x;
+      r2 = x;
+      if(left)
+      {
+         BOOST_CHECK_EQUAL(k(&r1[1], &r1[0], n, shift), generic(&r2[1], &r2[0], n, shift));
+      }
+      else
+      {
+         BOOST_CHECK_EQUAL(k(&r1[0], &r1[1], n, shift), generic(&r2[0], &r2[1], n, shift));
+      }
+      BOOST_CHECK(r1 == r2);
+   }
+}
+
+#ifdef BOOST_MP_HAS_CPU_DISPATCH
+//
+// The kernels chosen are those for the latest instruction set the CPU supports:
+//
+void test_selection(const limb_kernels& kernels)
+{
+   boost::multiprecision::detail::cpu_features features = boost::multiprecision::detail::detect_cpu_features();
+   if(features.avx512f)
+   {
+      BOOST_CHECK(kernels.left_shift_n == left_shift_limbs_n_avx512);
+      BOOST_CHECK(kernels.right_shift_n == right_shift_limbs_n_avx512);
+      BOOST_CHECK(kernels.and_n == bitwise_limbs_n_avx512<and_limbs_op>);
+      BOOST_CHECK(kernels.or_n == bitwise_limbs_n_avx512<or_limbs_op>);
+      BOOST_CHECK(kernels.xor_n == bitwise_limbs_n_avx512<xor_limbs_op>);
+      BOOST_CHECK(kernels.complement_n == complement_limbs_n_avx512);
+   }
+   else if(features.avx2)
+   {
+      BOOST_CHECK(kernels.left_shift_n == left_shift_limbs_n_avx2);
+      BOOST_CHECK(kernels.right_shift_n == right_shift_limbs_n_avx2);
+      BOOST_CHECK(kernels.and_n == bitwise_limbs_n_avx2<and_limbs_op>);
+      BOOST_CHECK(kernels.or_n == bitwise_limbs_n_avx2<or_limbs_op>);
+      BOOST_CHECK(kernels.xor_n == bitwise_limbs_n_avx2<xor_limbs_op>);
+      BOOST_CHECK(kernels.complement_n == complement_limbs_n_avx2);
+   }
+   else if(features.sse2)
+   {
+      BOOST_CHECK(kernels.left_shift_n == left_shift_limbs_n_sse2);
+      BOOST_CHECK(kernels.right_shift_n == right_shift_limbs_n_sse2);
+      BOOST_CHECK(kernels.and_n == bitwise_limbs_n_sse2<and_limbs_op>);
+      BOOST_CHECK(kernels.or_n == bitwise_limbs_n_sse2<or_limbs_op>);
+      BOOST_CHECK(kernels.xor_n == bitwise_limbs_n_sse2<xor_limbs_op>);
+      BOOST_CHECK(kernels.complement_n == complement_limbs_n_sse2);
+   }
+   else
+   {
+      BOOST_CHECK(kernels.left_shift_n == left_shift_limbs_n_generic);
+      BOOST_CHECK(kernels.right_shift_n == right_shift_limbs_n_generic);
+      BOOST_CHECK(kernels.and_n == and_limbs_n_generic);
+      BOOST_CHECK(kernels.complement_n == complement_limbs_n_generic);
+   }
+#ifdef BOOST_MP_HAS_AVX512_POPCNT
+   if(features.avx512vpopcntdq && features.popcnt)
+   {
+      BOOST_CHECK(kernels.popcount_n == popcount_limbs_n_avx512);
+   }
+   else
+#endif
+   if(features.avx2 && features.popcnt)
+   {
+      BOOST_CHECK(kernels.popcount_n == popcount_limbs_n_avx2);
+   }
+   else if(features.popcnt)
+   {
+      BOOST_CHECK(kernels.popcount_n == popcount_limbs_n_popcnt);
+   }
+   else
+   {
+      BOOST_CHECK(kernels.popcount_n == popcount_limbs_n_generic);
+   }
+}
+#endif
+
+int main()
+{
+#ifdef BOOST_MP_HAS_CPU_DISPATCH
+   const limb_kernels& kernels = get_limb_kernels();
+   test_selection(kernels);
+   for(unsigned n = 0; n < 70; ++n)
+   {
+      test_shift(kernels.left_shift_n, left_shift_limbs_n_generic, n, true);
+      test_shift(kernels.right_shift_n, right_shift_limbs_n_generic, n, false);
+      test_bitwise(kernels.and_n, and_limbs_n_generic, n);
+      test_bitwise(kernels.or_n, or_limbs_n_generic, n);
+      test_bitwise(kernels.xor_n, xor_limbs_n_generic, n);
+      test_unary(kernels.complement_n, complement_limbs_n_generic, n);
+      test_popcount(kernels.popcount_n, n);
+   }
+#endif
+   //
+   // And through the front end, shifts by amounts which aren't whole bytes go through the kernels:
+   //
+   cpp_int x = (cpp_int(1) << 1000) - 1;
+   for(unsigned s = 1; s < 300; s += 3)
+   {
+      cpp_int y = x << s;
+      BOOST_CHECK_EQUAL(y >> s, x);
+      BOOST_CHECK_EQUAL(msb(y), 999 + s);
+      BOOST_CHECK_EQUAL(lsb(y), s);
+      uint1024_t z = uint1024_t(x) << s;
+      BOOST_CHECK_EQUAL(z, uint1024_t(y));
+      BOOST_CHECK_EQUAL(cpp_int(z >> s), cpp_int(y & ((cpp_int(1) << 1024) - 1)) >> s);
+      BOOST_CHECK_EQUAL(cpp_int(y | x), y + (cpp_int(1) << s) - 1);
+      BOOST_CHECK_EQUAL(cpp_int(y & x), x - ((cpp_int(1) << s) - 1));
+      BOOST_CHECK_EQUAL(cpp_int(y ^ x), cpp_int(y | x) - cpp_int(y & x));
+   }
+   //
+   // Negative values go through the two's complement conversions, including the case where
+   // the result is a power of two which needs an extra limb, and aliased arguments:
+   //
+   for(unsigned i = 0; i < 200; ++i)
+   {
+      std::vector<limb_type> la = generate_random_limbs(1 + i % 40), lb = generate_random_limbs(1 + (i * 7) % 40);
+      cpp_int a, b;
+      import_bits(a, la.rbegin(), la.rend());
+      import_bits(b, lb.rbegin(), lb.rend());
+      if(i & 1)
+         a = -a;
+      if(i & 2)
+         b = -b;
+      unsigned bits = (std::max)(la.size(), lb.size()) * sizeof(limb_type) * CHAR_BIT + 2;
+      test_negative_bitwise(a, b, and_op(), bits);
+      test_negative_bitwise(a, b, or_op(), bits);
+      test_negative_bitwise(a, b, xor_op(), bits);
+   }
+   cpp_int p = -(cpp_int(1) << 640);
+   BOOST_CHECK_EQUAL(cpp_int(p & p), p);
+   BOOST_CHECK_EQUAL(cpp_int(p | p), p);
+   BOOST_CHECK_EQUAL(cpp_int(p ^ p), 0);
+   BOOST_CHECK_EQUAL(cpp_int(p | (p + 1)), p + 1);
+   BOOST_CHECK_EQUAL(cpp_int(p & (p - 1)), -(cpp_int(1) << 641));
+   cpp_int q = p + 12345;
+   q &= q;
+   BOOST_CHECK_EQUAL(q, p + 12345);
+   q |= q;
+   BOOST_CHECK_EQUAL(q, p + 12345);
+   q ^= q;
+   BOOST_CHECK_EQUAL(q, 0);
+   uint1024_t u = 0;
+   BOOST_CHECK_EQUAL(uint1024_t(~u), (std::numeric_limits<uint1024_t>::max)());
+   BOOST_CHECK_EQUAL(uint1024_t(~uint1024_t(x)), (std::numeric_limits<uint1024_t>::max)() - uint1024_t(x));
+   //
+   // The fixed precision types with unrolled arithmetic, including ones which don't fill their top limb:
+   //
+   test_unrolled<uint256_t>();
+   test_unrolled<uint512_t>();
+   test_unrolled<uint1024_t>();
+   test_unrolled<int256_t>();
+   test_unrolled<int1024_t>();
+   test_unrolled<number<cpp_int_backend<300, 300, unsigned_magnitude, unchecked, void> > >();
+   test_unrolled<number<cpp_int_backend<300, 300, signed_magnitude, unchecked, void> > >();
+   //
+   // The 256-bit product is done in 128-bit halves, check the carries between them:
+   //
+   uint256_t m = (std::numeric_limits<uint256_t>::max)();
+   BOOST_CHECK_EQUAL(uint256_t(m * m), 1);
+   for(unsigned s = 0; s < 256; s += 32)
+   {
+      BOOST_CHECK_EQUAL(cpp_int(uint256_t((m >> s) * (m >> (s / 2)))), cpp_int(m >> s) * cpp_int(m >> (s / 2)) & cpp_int(m));
+      BOOST_CHECK_EQUAL(cpp_int(uint256_t((m >> s) * (m << s))), cpp_int(m >> s) * cpp_int(m << s) & cpp_int(m));
+   }
+#ifdef BOOST_HAS_INT128
+   test_native_int128();
+#endif
+   //
+   // And population counts:
+   //
+   BOOST_CHECK_EQUAL(popcount(cpp_int(0)), 0);
+   BOOST_CHECK_EQUAL(popcount(x), 1000);
+   BOOST_CHECK_EQUAL(popcount(cpp_int(x << 77)), 1000);
+   BOOST_CHECK_EQUAL(popcount(x & (x << 500)), 500);
+   BOOST_CHECK_EQUAL(popcount(uint1024_t(x)), 1000);
+   BOOST_CHECK_EQUAL(popcount(int128_t(-1) & int128_t(0xF0F0)), 8);
+   BOOST_CHECK_EQUAL(popcount(uint128_t(x)), 128);
+   for(unsigned i = 0; i < 50; ++i)
+   {
+      std::vector<limb_type> la = generate_random_limbs(1 + i);
+      cpp_int a;
+      import_bits(a, la.rbegin(), la.rend());
+      unsigned count = 0;
+      for(unsigned j = 0; j < la.size() * sizeof(limb_type) * CHAR_BIT; ++j)
+         count += bit_test(a, j);
+      BOOST_CHECK_EQUAL(popcount(a), count);
+   }
+#ifndef BOOST_NO_EXCEPTIONS
+   BOOST_CHECK_THROW(popcount(cpp_int(-1)), std::range_error);
+#endif
+   return boost::report_errors();
+}
@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Multiplication by a limb in a fixed precision type which doesn't fill its top limb, with a
+// value which grows from a single limb so that the top limb stays unused for most of the loop.
+// normalize() must not read that limb until it has been written, this is built with
+// -Werror=maybe-uninitialized to check gcc agrees:
+//
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+typedef number<cpp_int_backend<300, 300, signed_magnitude, unchecked, void>, et_off> int300_t;
+
+int300_t hash(unsigned start, unsigned count)
+{
+   int300_t x = start;
+   for(unsigned j = 0; j < count; ++j)
+      x = x * int300_t(limb_type(0x9E3779B9u)) + int300_t(limb_type(j));
+   return x;
+}
+
+int main(int argc, char*[])
+{
+   cpp_int expected = argc;
+   for(unsigned j = 0; j < 20; ++j)
+   {
+      expected *= 0x9E3779B9u;
+      expected += j;
+   }
+   expected %= cpp_int(1) << 300;
+   BOOST_CHECK_EQUAL(cpp_int(hash(argc, 20)), expected);
+   return boost::report_errors();
+}
@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Tests for the per-thread pool behind pooled_allocator, and pooled_cpp_int.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_int/pooled_allocator.hpp>
+#include "test.hpp"
+
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+#include <thread>
+#endif
+#include <vector>
+
+using namespace boost::multiprecision;
+
+typedef boost::multiprecision::detail::block_pool pool_type;
+
+void test_size_classes()
+{
+   BOOST_CHECK_EQUAL(pool_type::size_class(1), 0u);
+   BOOST_CHECK_EQUAL(pool_type::size_class(32), 0u);
+   BOOST_CHECK_EQUAL(pool_type::size_class(33), 1u);
+   BOOST_CHECK_EQUAL(pool_type::size_class(64), 1u);
+   BOOST_CHECK_EQUAL(pool_type::size_class(65), 2u);
+   BOOST_CHECK_EQUAL(pool_type::size_class(pool_type::max_block_size), pool_type::size_classes - 1);
+   for(std::size_t bytes = 1; bytes <= pool_type::max_block_size; bytes += 7)
+   {
+      unsigned c = pool_type::size_class(bytes);
+      BOOST_CHECK(pool_type::block_size(c) >= bytes);
+      if(c)
+         BOOST_CHECK(pool_type::block_size(c - 1) < bytes);
+   }
+}
+
+void test_reuse()
+{
+   pooled_allocator<limb_type> alloc;
+   pool_type* pool = boost::multiprecision::detail::thread_block_pool();
+   BOOST_CHECK(pool != 0);
+   //
+   // A freed block is handed straight back out again for any request in the same size class:
+   //
+   limb_type* p = alloc.allocate(5);
+   unsigned c = pool_type::size_class(5 * sizeof(limb_type));
+   unsigned free_blocks = pool->free_blocks(c);
+   alloc.deallocate(p, 5);
+   BOOST_CHECK_EQUAL(pool->free_blocks(c), free_blocks + 1);
+   limb_type* q = alloc.allocate(pool_type::block_size(c) / sizeof(limb_type));
+   BOOST_CHECK(p == q);
+   BOOST_CHECK_EQUAL(pool->free_blocks(c), free_blocks);
+   alloc.deallocate(q, pool_type::block_size(c) / sizeof(limb_type));
+   //
+   // The number of blocks held on to is bounded:
+   //
+   std::vector<limb_type*> blocks;
+   for(unsigned i = 0; i < 2 * pool_type::max_free_blocks; ++i)
+      blocks.push_back(alloc.allocate(5));
+   for(unsigned i = 0; i < blocks.size(); ++i)
+      alloc.deallocate(blocks[i], 5);
+   BOOST_CHECK_EQUAL(pool->free_blocks(c), pool_type::max_free_blocks);
+   //
+   // Large blocks bypass the pool:
+   //
+   std::size_t n = 2 * pool_type::max_block_size / sizeof(limb_type);
+   p = alloc.allocate(n);
+   p[n - 1] = 0;
+   alloc.deallocate(p, n);
+   //
+   // And all instances are interchangeable:
+   //
+   pooled_allocator<char> other(alloc);
+   BOOST_CHECK(other == alloc);
+   BOOST_CHECK(!(other != alloc));
+}
+
+template <class T>
+T factorial(unsigned n)
+{
+   T result = 1;
+   for(unsigned i = 2; i <= n; ++i)
+      result *= i;
+   return result;
+}
+
+void test_arithmetic()
+{
+   pooled_cpp_int a = factorial<pooled_cpp_int>(500);
+   cpp_int b = factorial<cpp_int>(500);
+   BOOST_CHECK_EQUAL(a.str(), b.str());
+   pooled_cpp_int q = a / factorial<pooled_cpp_int>(490);
+   cpp_int r = b / factorial<cpp_int>(490);
+   BOOST_CHECK_EQUAL(q.str(), r.str());
+   BOOST_CHECK_EQUAL(static_cast<unsigned>(a % 1000000007u), static_cast<unsigned>(b % 1000000007u));
+   pooled_cpp_rational ratio(a, factorial<pooled_cpp_int>(501));
+   BOOST_CHECK_EQUAL(denominator(ratio), 501);
+}
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+
+void thread_proc(std::vector<pooled_cpp_int>* results, unsigned n)
+{
+   for(unsigned i = 0; i < results->size(); ++i)
+      (*results)[i] = factorial<pooled_cpp_int>(n + i);
+}
+
+void test_threads()
+{
+   //
+   // Values are created on one thread and destroyed on another, so blocks migrate between pools,
+   // and pools are destroyed while values allocated from them are still alive:
+   //
+   const unsigned thread_count = 4;
+   std::vector<std::vector<pooled_cpp_int> > results(thread_count, std::vector<pooled_cpp_int>(50));
+   std::vector<std::thread> threads;
+   for(unsigned i = 0; i < thread_count; ++i)
+      threads.push_back(std::thread(thread_proc, &results[i], 100 + 20 * i));
+   for(unsigned i = 0; i < thread_count; ++i)
+      threads[i].join();
+   for(unsigned i = 0; i < thread_count; ++i)
+   {
+      for(unsigned j = 0; j < results[i].size(); ++j)
+         BOOST_CHECK_EQUAL(results[i][j].str(), factorial<cpp_int>(100 + 20 * i + j).str());
+   }
+   results.clear();
+}
+
+#endif
+
+#endif
+
+int main()
+{
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+   test_size_classes();
+   test_reuse();
+   test_arithmetic();
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+   test_threads();
+#endif
+#endif
+   return boost::report_errors();
+}
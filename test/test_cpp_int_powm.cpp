@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Compare the results of modular exponentiation with odd moduli - which goes
+// through the Montgomery multiplication code - against GMP.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/miller_rabin.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include "test.hpp"
+#include "test_cpp_int_random.hpp"
+
+using namespace boost::multiprecision;
+
+//
+// The expected result, the sign follows that of a^p as for the % operator:
+//
+mpz_int reference_powm(const mpz_int& a, const mpz_int& p, const mpz_int& c)
+{
+   mpz_int result = powm(mpz_int(abs(a)), p, mpz_int(abs(c)));
+   if((a < 0) && bit_test(p, 0))
+      result = -result;
+   return result;
+}
+
+template <class Number>
+void test_powm(const cpp_int& a, const cpp_int& p, const cpp_int& c)
+{
+   Number na(a), np(p), nc(c);
+   mpz_int expected = reference_powm(mpz_int(a.str()), mpz_int(p.str()), mpz_int(c.str()));
+   Number r = powm(na, np, nc);
+   BOOST_CHECK_EQUAL(r.str(), expected.str());
+   // Aliased arguments:
+   r = na;
+   r = powm(r, np, nc);
+   BOOST_CHECK_EQUAL(r.str(), expected.str());
+   r = nc;
+   r = powm(na, np, r);
+   BOOST_CHECK_EQUAL(r.str(), expected.str());
+   // Built in exponent:
+   unsigned long long e = static_cast<unsigned long long>(p & 0xFFFFFFFFFFFFull);
+   expected = reference_powm(mpz_int(a.str()), mpz_int(e), mpz_int(c.str()));
+   BOOST_CHECK_EQUAL(Number(powm(na, e, nc)).str(), expected.str());
+}
+
+template <class Number>
+struct powm_case
+{
+   void operator()(unsigned bits, unsigned i)const
+   {
+      cpp_int c = generate_random(bits) | 1;
+      cpp_int a = generate_random(i & 1 ? bits : bits / 2 + 1);
+      cpp_int p = generate_random(i & 2 ? bits : 70);
+      switch(i)
+      {
+      case 4: p = 1; break;
+      case 5: p = 0; break;
+      case 6: a = 0; break;
+      case 7: a = c - 1; break;
+      case 8: a = c; break;
+      case 9: c = 1; break;
+      case 10: c = (cpp_int(1) << (bits - 1)) + 1; break;
+      case 11: c = (cpp_int(1) << bits) - 1; break;
+      }
+      if(std::numeric_limits<Number>::is_signed && (i % 3 == 0))
+         a = -a;
+      if(std::numeric_limits<Number>::is_signed && (i % 4 == 1))
+         c = -c;
+      test_powm<Number>(a, p, c);
+   }
+};
+
+template <class Number>
+void test_sizes(unsigned max_bits)
+{
+   test_bit_sizes(5, max_bits, 12, powm_case<Number>());
+}
+
+int main()
+{
+   test_sizes<cpp_int>(5000);
+   {
+      // Moduli large enough to use the generic code again:
+      unsigned bits = backends::montgomery_cutoff * sizeof(limb_type) * CHAR_BIT;
+      test_powm<cpp_int>(generate_random(bits), generate_random(10), generate_random(bits) | 1);
+   }
+   test_sizes<number<cpp_int_backend<256, 256, unsigned_magnitude, unchecked, void> > >(256);
+   test_sizes<number<cpp_int_backend<1024, 1024, signed_magnitude, unchecked, void> > >(1024);
+   test_sizes<number<cpp_int_backend<4096, 4096, signed_magnitude, checked, void> > >(4096);
+   test_sizes<number<cpp_int_backend<0, 2048, signed_magnitude, checked> > >(2048);
+   test_sizes<number<cpp_int_backend<200, 200, unsigned_magnitude, unchecked, void> > >(200);
+   //
+   // Miller Rabin goes through the same code, check it against known primes and composites:
+   //
+   boost::random::mt19937 gen;
+   cpp_int p = (cpp_int(1) << 521) - 1;
+   BOOST_CHECK(miller_rabin_test(p, 25, gen));
+   BOOST_CHECK(!miller_rabin_test(cpp_int(p * ((cpp_int(1) << 127) - 1)), 25, gen));
+   BOOST_CHECK(!miller_rabin_test(cpp_int("2152302898747"), 25, gen)); // Carmichael number
+   typedef number<cpp_int_backend<1024, 1024, unsigned_magnitude, unchecked, void> > uint1024_t;
+   BOOST_CHECK(miller_rabin_test(uint1024_t((uint1024_t(1) << 607) - 1), 25, gen));
+   BOOST_CHECK(!miller_rabin_test(uint1024_t((uint1024_t(1) << 607) + 1), 25, gen));
+
+   return boost::report_errors();
+}
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Random operands for the tests of the large cpp_int algorithms, and the conversions used to
+// compare their results with GMP's.
+//
+
+#ifndef BOOST_MP_TEST_CPP_INT_RANDOM_HPP
+#define BOOST_MP_TEST_CPP_INT_RANDOM_HPP
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/independent_bits.hpp>
+#include <cctype>
+#include <string>
+
+//
+// Random hex digits for a value of the given number of limbs, with long runs of zeros and F's
+// to exercise carry propagation and the corner cases of quotient estimation:
+//
+inline std::string generate_random_hex(unsigned limbs)
+{
+   static boost::random::mt19937 gen;
+   boost::random::uniform_int_distribution<unsigned> digit(0, 15), mode(0, 7);
+   unsigned digits = limbs * sizeof(boost::multiprecision::limb_type) * 2;
+   std::string result = "0x";
+   while(result.size() < digits + 2)
+   {
+      unsigned m = mode(gen);
+      unsigned run = sizeof(boost::multiprecision::limb_type) * 2 * (1 + digit(gen) % 3);
+      for(unsigned i = 0; (i < run) && (result.size() < digits + 2); ++i)
+         result += "0123456789ABCDEF"[m == 0 ? 0 : m == 1 ? 15 : digit(gen)];
+   }
+   // Make sure the top limb is non-zero:
+   if(result[2] == '0')
+      result[2] = '1';
+   return result;
+}
+
+template <class T>
+std::string to_hex(const T& val)
+{
+   // Normalise the case, since cpp_int and GMP don't agree on that:
+   std::string result = val.str(0, std::ios_base::hex);
+   for(std::string::iterator i = result.begin(); i != result.end(); ++i)
+      *i = static_cast<char>(std::tolower(*i));
+   return result;
+}
+
+inline std::string to_hex_string(const boost::multiprecision::cpp_int& val)
+{
+   return "0x" + to_hex(val);
+}
+
+//
+// A random value of exactly the given number of bits:
+//
+inline boost::multiprecision::cpp_int generate_random(unsigned bits)
+{
+   static boost::random::independent_bits_engine<boost::random::mt19937, 32, unsigned> gen;
+   boost::multiprecision::cpp_int result;
+   unsigned i = 0;
+   for(; i < bits; i += 32)
+      result = (result << 32) | gen();
+   result >>= i - bits;
+   bit_set(result, bits - 1);
+   return result;
+}
+
+//
+// Calls test(bits, i) for each case i < cases, at sizes from min_bits up to max_bits which grow by
+// about half each time:
+//
+template <class Test>
+void test_bit_sizes(unsigned min_bits, unsigned max_bits, unsigned cases, Test test)
+{
+   for(unsigned bits = min_bits; bits <= max_bits; bits = bits * 3 / 2 + 5)
+   {
+      for(unsigned i = 0; i < cases; ++i)
+         test(bits, i);
+   }
+}
+
+#endif
@@ -0,0 +1,262 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Storage management of arbitrary precision cpp_int's: reserve, shrink_to_fit, the growth policy
+// and in place arithmetic, checked with counting_allocator.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/cpp_int/counting_allocator.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+typedef number<cpp_int_backend<0, 0, signed_magnitude, unchecked, counting_allocator<limb_type> > > counted_int;
+typedef number<cpp_int_backend<0, 0, signed_magnitude, unchecked, counting_allocator<limb_type> >, et_off> counted_int_no_et;
+
+static const unsigned limb_bits = sizeof(limb_type) * CHAR_BIT;
+
+unsigned long long allocations()
+{
+   return thread_allocation_statistics().allocations;
+}
+
+template <class T>
+void test_reserve()
+{
+   T a(1);
+   unsigned initial_capacity = a.backend().capacity();
+   //
+   // Reserving no more than we have is a no-op:
+   //
+   reset_thread_allocation_statistics();
+   reserve(a, initial_capacity * limb_bits);
+   BOOST_CHECK_EQUAL(allocations(), 0u);
+   BOOST_CHECK_EQUAL(a.backend().capacity(), initial_capacity);
+   //
+   // Otherwise we get exactly what we asked for, and the value is preserved:
+   //
+   a = T(1) << 100;
+   reserve(a, 1000);
+   BOOST_CHECK_EQUAL(a.backend().capacity(), 1000 / limb_bits + (1000 % limb_bits ? 1 : 0));
+   BOOST_CHECK_EQUAL(a, T(1) << 100);
+   //
+   // And values up to that size need no more memory:
+   //
+   reset_thread_allocation_statistics();
+   for(unsigned i = 0; i < 899; ++i)
+      a <<= 1;
+   BOOST_CHECK_EQUAL(allocations(), 0u);
+   //
+   // shrink_to_fit goes back to the internal buffer when the value fits:
+   //
+   a = 2;
+   shrink_to_fit(a);
+   BOOST_CHECK_EQUAL(a.backend().capacity(), initial_capacity);
+   BOOST_CHECK_EQUAL(a, 2);
+   BOOST_CHECK_EQUAL(thread_allocation_statistics().deallocations, 1u);
+   //
+   // Or else to a buffer of exactly the right size:
+   //
+   a = T(1) << 500;
+   reserve(a, 5000);
+   shrink_to_fit(a);
+   BOOST_CHECK_EQUAL(a.backend().capacity(), a.backend().size());
+   BOOST_CHECK_EQUAL(a, T(1) << 500);
+   shrink_to_fit(a);
+   BOOST_CHECK_EQUAL(a.backend().capacity(), a.backend().size());
+   //
+   // Negative values keep their sign:
+   //
+   a = -(T(1) << 300);
+   reserve(a, 4000);
+   BOOST_CHECK_EQUAL(a, -(T(1) << 300));
+   shrink_to_fit(a);
+   BOOST_CHECK_EQUAL(a, -(T(1) << 300));
+}
+
+template <class T>
+void test_growth()
+{
+   //
+   // Growing a value a limb at a time reallocates only a logarithmic number of times:
+   //
+   T a(1);
+   reset_thread_allocation_statistics();
+   unsigned limbs = 1000;
+   for(unsigned i = 0; i < limbs * limb_bits; ++i)
+      a <<= 1;
+   unsigned long long expected = 0;
+   for(unsigned cap = a.backend().internal_limb_count; cap <= limbs; cap *= boost::multiprecision::backends::cpp_int_growth_factor)
+      ++expected;
+   BOOST_CHECK_EQUAL(allocations(), expected);
+}
+
+template <class T>
+void test_steady_state()
+{
+   //
+   // Once there is enough room, sums of products and similar loops do not allocate at all.  Note that
+   // without expression templates t = x * y creates a temporary which is then moved into t, use
+   // multiply(t, x, y) to evaluate straight into the storage of t instead:
+   //
+   T acc(0), t, x(1), y(3);
+   x <<= 400;
+   y <<= 300;
+   reserve(acc, 2048);
+   reserve(t, 1024);
+   reset_thread_allocation_statistics();
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      multiply(t, x, y);
+      acc += t;
+      t = x;
+      t += i;
+      acc -= t;
+      t = x;
+      t *= 3;
+      acc += t;
+   }
+   BOOST_CHECK_EQUAL(allocations(), 0u);
+   BOOST_CHECK_EQUAL(acc, 1000 * ((x * y) + 2 * x) - 999 * 500);
+   //
+   // Fixed precision types simply ignore these requests:
+   //
+   int256_t f(5);
+   reserve(f, 2048);
+   shrink_to_fit(f);
+   BOOST_CHECK_EQUAL(f, 5);
+}
+
+template <class T>
+void test_in_place()
+{
+   //
+   // In place multiplication and division work in the storage of the result, so once
+   // there's room for the intermediate values they don't allocate either:
+   //
+   T a, b(1), m(1);
+   b = (b << 300) - 1;
+   m <<= 200;
+   m += 12345;
+   reserve(a, 2048);
+   reset_thread_allocation_statistics();
+   for(unsigned i = 0; i < 100; ++i)
+   {
+      a = b;
+      a *= b;
+      a *= i + 2;
+      a %= m;
+      a /= 10;
+      a %= 1000000007uL;
+   }
+   BOOST_CHECK_EQUAL(allocations(), 0u);
+   BOOST_CHECK_EQUAL(a, ((b * b * 101) % m / 10) % 1000000007uL);
+   //
+   // And give the same results as when nothing is aliased, whichever argument is the result,
+   // including values large enough for the recursive algorithms:
+   //
+   T x(-1), y(3);
+   x <<= 5000;
+   x -= 7;
+   y <<= 3000;
+   y += 5;
+   for(unsigned bits = 100; bits < 5000; bits *= 3)
+   {
+      T u = x >> (5000 - bits);
+      T v = y >> (3000 - bits / 2);
+      T product = u * v, quotient = u / v, remainder = u % v;
+      a = u;
+      a *= v;
+      BOOST_CHECK_EQUAL(a, product);
+      a = v;
+      multiply(a, u, a);
+      BOOST_CHECK_EQUAL(a, product);
+      a = u;
+      a /= v;
+      BOOST_CHECK_EQUAL(a, quotient);
+      a = u;
+      a %= v;
+      BOOST_CHECK_EQUAL(a, remainder);
+      a = v;
+      a = u % a;
+      BOOST_CHECK_EQUAL(a, remainder);
+      a = u;
+      a /= 1000000007uL;
+      BOOST_CHECK_EQUAL(a, u / 1000000007uL);
+      a = u;
+      a %= 1000000007uL;
+      BOOST_CHECK_EQUAL(a, u % 1000000007uL);
+      BOOST_CHECK_EQUAL(quotient * v + remainder, u);
+   }
+}
+
+template <class T>
+void test_in_place_division(unsigned x_bits, unsigned y_bits)
+{
+   //
+   // Division by a multi-limb value, both by long division and by the recursive algorithm, uses
+   // the spare storage of the result for its temporaries, so after the first few iterations
+   // neither a /= y nor a %= y allocates:
+   //
+   T x(1), y(3), a;
+   x = (x << x_bits) - 12345;
+   y = (y << (y_bits - 2)) + 777;
+   reserve(a, x_bits);
+   T quotient = x / y, remainder = x % y;
+   for(unsigned i = 0; i < 3; ++i)
+   {
+      a = x;
+      a /= y;
+      a = x;
+      a %= y;
+   }
+   reset_thread_allocation_statistics();
+   for(unsigned i = 0; i < 10; ++i)
+   {
+      a = x;
+      a /= y;
+      BOOST_CHECK_EQUAL(a, quotient);
+      a = x;
+      a %= y;
+      BOOST_CHECK_EQUAL(a, remainder);
+   }
+   BOOST_CHECK_EQUAL(allocations(), 0u);
+   BOOST_CHECK_EQUAL(quotient * y + remainder, x);
+   a = -x;
+   a /= y;
+   BOOST_CHECK_EQUAL(a, -quotient);
+   a = -x;
+   a %= y;
+   BOOST_CHECK_EQUAL(a, -remainder);
+}
+
+template <class T>
+void test()
+{
+   test_reserve<T>();
+   test_growth<T>();
+   test_steady_state<T>();
+   test_in_place<T>();
+   //
+   // Sizes for long division, and for the recursive algorithm with a quotient longer than the
+   // divisor and one the same length as it:
+   //
+   test_in_place_division<T>(300, 150);
+   test_in_place_division<T>(4000, 1500);
+   test_in_place_division<T>(4000, 2000);
+}
+
+int main()
+{
+   test<counted_int>();
+   test<counted_int_no_et>();
+   return boost::report_errors();
+}
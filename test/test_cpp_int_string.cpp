@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Compare string conversions of large values against GMP, these are long enough
+// to go through the divide and conquer conversion routines.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include "test.hpp"
+#include <cctype>
+
+using namespace boost::multiprecision;
+
+boost::random::mt19937 gen;
+
+//
+// Random digits in the given radix, with long runs of zeros and of the largest digit:
+//
+std::string generate_random_digits(unsigned count, unsigned radix)
+{
+   boost::random::uniform_int_distribution<unsigned> digit(0, radix - 1), mode(0, 7);
+   std::string result;
+   while(result.size() < count)
+   {
+      unsigned m = mode(gen);
+      unsigned run = 1 + digit(gen) * 5;
+      for(unsigned i = 0; (i < run) && (result.size() < count); ++i)
+         result += "0123456789abcdef"[m == 0 ? 0 : m == 1 ? radix - 1 : digit(gen)];
+   }
+   // Make sure the leading digit is non-zero, so that decimal strings aren't read as octal:
+   if(result[0] == '0')
+      result[0] = '1';
+   return result;
+}
+
+template <class Number>
+void test_parse(const std::string& digits, const char* prefix, bool negate)
+{
+   // GMP doesn't accept a sign in front of a radix prefix, so negate separately:
+   mpz_int m(prefix + digits);
+   if(negate)
+      m = -m;
+   Number x((negate ? "-" : "") + (prefix + digits));
+   BOOST_CHECK_EQUAL(x.str(), m.str());
+}
+
+template <class Number>
+void test_str(const Number& x)
+{
+   mpz_int m(x.str());
+   BOOST_CHECK_EQUAL(Number(m.str()), x);
+   BOOST_CHECK_EQUAL(x.str(), m.str());
+}
+
+template <class Number>
+void test_radix_str(const Number& x)
+{
+   mpz_int m(x.str());
+   std::string h = m.str(0, std::ios_base::hex);
+   for(std::string::iterator i = h.begin(); i != h.end(); ++i)
+      *i = static_cast<char>(std::toupper(*i));
+   BOOST_CHECK_EQUAL(x.str(0, std::ios_base::hex), h);
+   BOOST_CHECK_EQUAL(x.str(0, std::ios_base::oct), m.str(0, std::ios_base::oct));
+   BOOST_CHECK_EQUAL(x.str(0, std::ios_base::hex | std::ios_base::showbase), "0x" + h);
+   BOOST_CHECK_EQUAL(Number(x.str(0, std::ios_base::oct | std::ios_base::showbase)), x);
+}
+//
+// Negative values of unchecked fixed precision types are printed in two's complement,
+// which is the same as the value converted to an unsigned type of the same width:
+//
+template <class Number, class Unsigned>
+void test_twos_complement(const Number& x)
+{
+   BOOST_CHECK_EQUAL(x.str(0, std::ios_base::hex), Unsigned(x).str(0, std::ios_base::hex));
+   BOOST_CHECK_EQUAL(x.str(0, std::ios_base::oct), Unsigned(x).str(0, std::ios_base::oct));
+   BOOST_CHECK_EQUAL(Unsigned(x.str(0, std::ios_base::hex | std::ios_base::showbase)), Unsigned(x));
+}
+
+template <class Number>
+void test(unsigned digits)
+{
+   bool is_signed = std::numeric_limits<Number>::is_signed;
+   std::string d = generate_random_digits(digits, 10);
+   std::string h = generate_random_digits(digits, 16);
+   std::string o = generate_random_digits(digits, 8);
+   test_parse<Number>(d, "", false);
+   test_parse<Number>(d, "", is_signed);
+   test_parse<Number>(h, "0x", false);
+   test_parse<Number>(h, "0x", is_signed);
+   test_parse<Number>("000" + h, "0x", false);
+   test_parse<Number>(o, "0", false);
+   test_parse<Number>(o, "0", is_signed);
+   test_parse<Number>("000" + o, "0", is_signed);
+   // Powers of ten and one less, which have long runs of zeros and nines in the middle of the string:
+   test_parse<Number>("1" + std::string(digits, '0'), "", false);
+   test_parse<Number>(std::string(digits, '9'), "", is_signed);
+   test_str(Number("1" + std::string(digits, '0')));
+   test_str(Number(std::string(digits, '9')));
+   test_str(Number((is_signed ? "-0x" : "0x") + h));
+   test_radix_str(Number(d));
+   test_radix_str(Number("0x" + h));
+   test_radix_str(Number("0" + o));
+}
+
+int main()
+{
+   const unsigned sizes[] = { 1, 2, 9, 18, 19, 37, 100, 500, 760, 761, 1000, 2000, 5000, 20000, 100000 };
+   for(unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+      test<cpp_int>(sizes[i]);
+   //
+   // Fixed precision types, which are converted via an arbitrary precision temporary:
+   //
+   for(unsigned i = 1; i < 250; i += 7)
+   {
+      test<int1024_t>(i);
+      test<checked_uint1024_t>(i * 3 / 4);
+   }
+   typedef number<cpp_int_backend<8192, 8192, signed_magnitude, checked, void> > checked_int8192_t;
+   for(unsigned i = 600; i < 2000; i += 211)
+      test<checked_int8192_t>(i);
+   BOOST_CHECK_THROW(checked_uint1024_t(std::string(400, '9')), std::overflow_error);
+   BOOST_CHECK_THROW(checked_int8192_t(std::string(3000, '9')), std::overflow_error);
+   BOOST_CHECK_THROW(checked_uint1024_t("0x1" + std::string(256, '0')), std::overflow_error);
+   BOOST_CHECK_THROW(checked_uint1024_t("02" + std::string(341, '0')), std::overflow_error);
+   checked_uint1024_t max_value("01" + std::string(341, '7'));
+   BOOST_CHECK_EQUAL(max_value, (std::numeric_limits<checked_uint1024_t>::max)());
+   //
+   // Out of range values wrap for unchecked types:
+   //
+   BOOST_CHECK_EQUAL(uint1024_t("0x1" + std::string(256, '0') + "5"), 5);
+   BOOST_CHECK_EQUAL(uint1024_t("1" + std::string(2000, '0')), uint1024_t(cpp_int("1" + std::string(2000, '0'))));
+   //
+   // Two's complement output of negative values:
+   //
+   typedef number<cpp_int_backend<64, 64, signed_magnitude, unchecked, void> > int64_type;
+   typedef number<cpp_int_backend<200, 200, signed_magnitude, unchecked, void> > int200_t;
+   typedef number<cpp_int_backend<200, 200, unsigned_magnitude, unchecked, void> > uint200_t;
+   for(unsigned i = 1; i < 1000; i += 13)
+   {
+      test_twos_complement<int1024_t, uint1024_t>(-int1024_t(generate_random_digits(i / 4 + 1, 10)) << (i % 3));
+      test_twos_complement<int200_t, uint200_t>(-int200_t("0x" + generate_random_digits(i % 50 + 1, 16)));
+   }
+   BOOST_CHECK_EQUAL(int1024_t(-1).str(0, std::ios_base::hex), std::string(256, 'F'));
+   BOOST_CHECK_EQUAL(int1024_t(-1).str(0, std::ios_base::oct), "1" + std::string(341, '7'));
+   BOOST_CHECK_EQUAL(int200_t(-2).str(0, std::ios_base::hex | std::ios_base::showbase), "0xFF" + std::string(47, 'F') + "E");
+   BOOST_CHECK_EQUAL(int128_t(-2).str(0, std::ios_base::hex), std::string(31, 'F') + "E");
+   BOOST_CHECK_EQUAL(int64_type(-2).str(0, std::ios_base::hex), "fffffffffffffffe");
+   BOOST_CHECK_EQUAL(int64_type(-8).str(0, std::ios_base::oct), "1777777777777777777770");
+   BOOST_CHECK_THROW(cpp_int(-2).str(0, std::ios_base::hex), std::runtime_error);
+   BOOST_CHECK_THROW(checked_int1024_t(-2).str(0, std::ios_base::hex), std::runtime_error);
+   BOOST_CHECK_THROW(checked_int128_t(-2).str(0, std::ios_base::oct), std::runtime_error);
+   //
+   // Invalid characters anywhere in the string, including beyond the end of a fixed precision type:
+   //
+   const char* bad[] = { "12a", "0x12g", "0128", "1 2", "0x-1" };
+   for(unsigned i = 0; i < sizeof(bad) / sizeof(bad[0]); ++i)
+   {
+      BOOST_CHECK_THROW(cpp_int x(bad[i]), std::runtime_error);
+   }
+   BOOST_CHECK_THROW(cpp_int(std::string(5000, '1') + "a"), std::runtime_error);
+   BOOST_CHECK_THROW(cpp_int("a" + std::string(5000, '1')), std::runtime_error);
+   BOOST_CHECK_THROW(uint1024_t("0x" + std::string(300, 'f') + "g"), std::runtime_error);
+   BOOST_CHECK_THROW(uint1024_t("0g" + std::string(300, '7')), std::runtime_error);
+
+   return boost::report_errors();
+}
@@ -0,0 +1,197 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Tests for workspace: the stack discipline of the block, and that with a workspace bound the heavy
+// operations give the same results and, once warmed up, make no heap allocations at all.  Values
+// allocate through counting_allocator, and temporaries which don't fit in the workspace show up
+// as the workspace growing.  Without a workspace the temporaries go through counting_allocator too:
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/cpp_int/counting_allocator.hpp>
+#include "test.hpp"
+
+using namespace boost::multiprecision;
+
+typedef number<cpp_int_backend<0, 0, signed_magnitude, unchecked, counting_allocator<limb_type> > > counted_int;
+typedef number<cpp_int_backend<0, 0, signed_magnitude, unchecked, counting_allocator<limb_type> >, et_off> counted_int_no_et;
+
+void test_stack()
+{
+   workspace w(1000);
+   BOOST_CHECK(w.capacity() >= 1000);
+   BOOST_CHECK_EQUAL(w.used(), 0u);
+   void* a = w.allocate(10);
+   void* b = w.allocate(100);
+   void* c = w.allocate(1);
+   BOOST_CHECK(a && b && c);
+   BOOST_CHECK(w.owns(a) && w.owns(b) && w.owns(c));
+   BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(b) % workspace::alignment, 0u);
+   std::size_t used = w.used();
+   //
+   // Freeing out of order keeps the memory in use until everything above it has gone too:
+   //
+   w.deallocate(b, 100);
+   BOOST_CHECK_EQUAL(w.used(), used);
+   w.deallocate(c, 1);
+   BOOST_CHECK(w.used() < used);
+   void* d = w.allocate(50);
+   BOOST_CHECK(d == b);
+   w.deallocate(d, 50);
+   w.deallocate(a, 10);
+   BOOST_CHECK_EQUAL(w.used(), 0u);
+   //
+   // A request which doesn't fit fails while the stack is in use, but the block grows to fit it
+   // the next time the stack is empty:
+   //
+   std::size_t capacity = w.capacity();
+   a = w.allocate(10);
+   BOOST_CHECK(w.allocate(capacity) == 0);
+   BOOST_CHECK_EQUAL(w.capacity(), capacity);
+   w.deallocate(a, 10);
+   a = w.allocate(10);
+   BOOST_CHECK(w.capacity() > capacity);
+   b = w.allocate(capacity);
+   BOOST_CHECK(b != 0);
+   w.deallocate(b, capacity);
+   w.deallocate(a, 10);
+   BOOST_CHECK_EQUAL(w.used(), 0u);
+   BOOST_CHECK(!w.owns(&capacity));
+}
+
+void test_binding()
+{
+   workspace w1, w2;
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+   BOOST_CHECK(current_workspace() == 0);
+   {
+      workspace_binding b1(w1);
+      BOOST_CHECK(current_workspace() == &w1);
+      {
+         workspace_binding b2(w2);
+         BOOST_CHECK(current_workspace() == &w2);
+      }
+      BOOST_CHECK(current_workspace() == &w1);
+   }
+   BOOST_CHECK(current_workspace() == 0);
+#else
+   workspace_binding b1(w1);
+   BOOST_CHECK(current_workspace() == 0);
+#endif
+}
+
+template <class T>
+void run(const T& a, const T& b, const T& e, const T& m, const std::string& s, T* r)
+{
+   multiply(r[0], a, b);
+   divide_qr(r[0], b, r[1], r[2]);
+   r[3] = gcd(a, b);
+   r[4] = powm(a, e, m);
+   r[5].assign(s);
+}
+
+template <class T>
+void test_operations(bool count_allocations)
+{
+   //
+   // Large enough for the recursive multiplication and division, the half gcd and the divide and
+   // conquer string conversions:
+   //
+   T a(1), b(3), e(5), m(1);
+   a = (a << 20000) - 12345;
+   b = (b << 15000) + 54321;
+   e = (e << 200) + 1;
+   m = (m << 1000) + 1;
+   std::string s = a.str();
+   T expected[6], r[6];
+   run(a, b, e, m, s, expected);
+   BOOST_CHECK_EQUAL(expected[0] / b, a);
+   BOOST_CHECK_EQUAL(expected[5], a);
+   for(unsigned i = 0; i < 6; ++i)
+      reserve(r[i], 40000);
+   workspace w;
+   workspace_binding binding(w);
+   for(unsigned i = 0; i < 5; ++i)
+      run(a, b, e, m, s, r);
+   std::size_t capacity = w.capacity();
+   reset_thread_allocation_statistics();
+   for(unsigned i = 0; i < 10; ++i)
+      run(a, b, e, m, s, r);
+#ifdef BOOST_MP_USING_THREAD_LOCAL
+   if(count_allocations)
+   {
+      BOOST_CHECK_EQUAL(thread_allocation_statistics().allocations, 0u);
+   }
+#endif
+   //
+   // A temporary which didn't fit would have gone to the heap, and left the workspace due to grow
+   // the next time its stack is empty:
+   //
+   w.reserve(0);
+   BOOST_CHECK_EQUAL(w.capacity(), capacity);
+   BOOST_CHECK_EQUAL(w.used(), 0u);
+   for(unsigned i = 0; i < 6; ++i)
+      BOOST_CHECK_EQUAL(r[i], expected[i]);
+   BOOST_CHECK_EQUAL(a.str(), s);
+   //
+   // Fixed precision types are unaffected:
+   //
+   int1024_t x = (int1024_t(1) << 1000) - 3, y = int1024_t(7) << 900;
+   BOOST_CHECK_EQUAL(gcd(x * 5, y * 5), 5);
+   BOOST_CHECK_EQUAL(int1024_t(x.str()), x);
+   BOOST_CHECK_EQUAL(w.used(), 0u);
+}
+
+template <class T>
+void test_fallback()
+{
+   //
+   // Without a workspace, the working values of gcd and the decimal conversions are allocated by
+   // the allocator of the values they work on, and all given back to it:
+   //
+   BOOST_CHECK(current_workspace() == 0);
+   T a(1), b(3), r;
+   a = (a << 20000) - 12345;
+   b = (b << 15000) + 54321;
+   std::string s = a.str();
+   T expected = gcd(a, b);
+   reserve(r, 40000);
+   const allocation_statistics& stats = thread_allocation_statistics();
+
+   reset_thread_allocation_statistics();
+   r = gcd(a, b);
+   BOOST_CHECK(stats.allocations > 0);
+   BOOST_CHECK_EQUAL(stats.allocations, stats.deallocations);
+   BOOST_CHECK_EQUAL(r, expected);
+
+   reset_thread_allocation_statistics();
+   BOOST_CHECK_EQUAL(a.str(), s);
+   BOOST_CHECK(stats.allocations > 0);
+   BOOST_CHECK_EQUAL(stats.allocations, stats.deallocations);
+
+   reset_thread_allocation_statistics();
+   r.assign(s);
+   BOOST_CHECK(stats.allocations > 0);
+   BOOST_CHECK_EQUAL(stats.allocations, stats.deallocations);
+   BOOST_CHECK_EQUAL(r, a);
+}
+
+int main()
+{
+   test_stack();
+   test_binding();
+   test_operations<counted_int>(true);
+   //
+   // Without expression templates the result of powm is a temporary, which is then moved into place:
+   //
+   test_operations<counted_int_no_et>(false);
+   test_fallback<counted_int>();
+   return boost::report_errors();
+}
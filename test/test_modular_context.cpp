@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////
+//  Copyright 2012 John Maddock. Distributed under the Boost
+//  Software License, Version 1.0. (See accompanying file
+//  LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt
+
+//
+// Compare the results of modular_context operations against GMP, for odd
+// moduli (Montgomery form), even moduli, the generic version, and the built in
+// types with moduli up to their maximum.  Also check, with counting_allocator,
+// that the cpp_int version allocates nothing per call.
+//
+
+#ifdef _MSC_VER
+#  define _SCL_SECURE_NO_WARNINGS
+#endif
+
+#include <boost/multiprecision/gmp.hpp>
+#include <boost/multiprecision/modular_context.hpp>
+#include <boost/multiprecision/cpp_int/counting_allocator.hpp>
+#include "test.hpp"
+#include "test_cpp_int_random.hpp"
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <vector>
+
+using namespace boost::multiprecision;
+
+mpz_int reduce(mpz_int x, const mpz_int& m)
+{
+   x %= m;
+   if(x < 0)
+      x += m;
+   return x;
+}
+
+template <class Number>
+void test_context(const cpp_int& a, const cpp_int& b, const cpp_int& m)
+{
+   modular_context<Number> ctx((Number(m)));
+   BOOST_CHECK_EQUAL(ctx.modulus(), Number(m));
+   mpz_int ma(a.str()), mb(b.str()), mm(m.str());
+   Number na(a), nb(b);
+   BOOST_CHECK_EQUAL(ctx.mulmod(na, nb).str(), reduce(ma * mb, mm).str());
+   BOOST_CHECK_EQUAL(ctx.sqrmod(na).str(), reduce(ma * ma, mm).str());
+   BOOST_CHECK_EQUAL(ctx.powm(na, nb).str(), mpz_int(powm(reduce(ma, mm), mb, mm)).str());
+   BOOST_CHECK_EQUAL(ctx.powm(na, Number(0)).str(), reduce(mpz_int(1), mm).str());
+   // Aliased arguments:
+   Number r(na);
+   ctx.mulmod(r, r, r);
+   BOOST_CHECK_EQUAL(r.str(), reduce(ma * ma, mm).str());
+   r = na;
+   ctx.powm(r, r, nb);
+   BOOST_CHECK_EQUAL(r.str(), mpz_int(powm(reduce(ma, mm), mb, mm)).str());
+   if(gcd(reduce(ma, mm), mm) == 1)
+   {
+      Number inv = ctx.inverse(na);
+      BOOST_CHECK_EQUAL(reduce(mpz_int(inv.str()) * ma, mm), reduce(mpz_int(1), mm));
+   }
+#ifndef BOOST_NO_EXCEPTIONS
+   else
+      BOOST_CHECK_THROW(ctx.inverse(na), std::domain_error);
+   if(std::numeric_limits<Number>::is_signed)
+      BOOST_CHECK_THROW(ctx.powm(na, Number(-1)), std::runtime_error);
+#endif
+}
+
+template <class Number>
+struct context_case
+{
+   void operator()(unsigned bits, unsigned i)const
+   {
+      cpp_int m = generate_random(bits);
+      cpp_int a = generate_random(bits);
+      cpp_int b = generate_random(i & 4 ? bits : bits / 2 + 1);
+      if(i & 1)
+         m |= 1;
+      else
+         m &= ~cpp_int(1);
+      switch(i)
+      {
+      case 2: a += m * 5; break;
+      case 3: a = 0; break;
+      case 5: m = 1; break;
+      case 6: a = m - 1; break;
+      case 7: m = cpp_int(1) << (bits / (sizeof(limb_type) * CHAR_BIT) * sizeof(limb_type) * CHAR_BIT); break;
+      }
+      if(std::numeric_limits<Number>::is_signed && (i % 3 == 1))
+         a = -a;
+      test_context<Number>(a, b, m);
+   }
+};
+
+template <class Number>
+void test_sizes(unsigned max_bits)
+{
+   test_bit_sizes(3, max_bits, 10, context_case<Number>());
+}
+
+//
+// The products of built in values are formed in a type twice as wide, so that nothing overflows:
+//
+template <class I>
+void test_builtin()
+{
+   boost::random::mt19937 gen;
+   boost::random::uniform_int_distribution<I> dist((std::numeric_limits<I>::min)(), (std::numeric_limits<I>::max)());
+   for(unsigned i = 0; i < 1000; ++i)
+   {
+      I m = dist(gen), a = dist(gen), b = dist(gen);
+      if(i % 4 == 0)
+         m = static_cast<I>((std::numeric_limits<I>::max)() - i);
+      else if(m <= 0)
+         m = static_cast<I>(-(m + 1));
+      if(m == 0)
+         m = 1;
+      modular_context<I> ctx(m);
+      mpz_int ma(a), mb(b), mm(m);
+      BOOST_CHECK_EQUAL(mpz_int(ctx.mulmod(a, b)), reduce(ma * mb, mm));
+      BOOST_CHECK_EQUAL(mpz_int(ctx.sqrmod(a)), reduce(ma * ma, mm));
+      if(b >= 0)
+      {
+         BOOST_CHECK_EQUAL(mpz_int(ctx.powm(a, b)), mpz_int(powm(reduce(ma, mm), mb, mm)));
+      }
+      if(gcd(reduce(ma, mm), mm) == 1)
+      {
+         BOOST_CHECK_EQUAL(reduce(mpz_int(ctx.inverse(a)) * ma, mm), reduce(mpz_int(1), mm));
+      }
+#ifndef BOOST_NO_EXCEPTIONS
+      else
+         BOOST_CHECK_THROW(ctx.inverse(a), std::domain_error);
+#endif
+   }
+}
+
+typedef number<cpp_int_backend<0, 0, signed_magnitude, unchecked, counting_allocator<limb_type> > > counted_int;
+
+void test_allocations(unsigned bits)
+{
+   counted_int m(generate_random(bits));
+   for(unsigned odd = 0; odd < 2; ++odd)
+   {
+      if(odd)
+         m |= 1;
+      else
+         m &= ~counted_int(1);
+      modular_context<counted_int> ctx(m);
+      //
+      // Values with an inverse, so that every call takes the full path, and results with room
+      // for anything less than the modulus:
+      //
+      std::vector<counted_int> a, r(4);
+      while(a.size() < 5)
+      {
+         counted_int x(generate_random(bits));
+         x %= m;
+         if(gcd(x, m) == 1)
+            a.push_back(x);
+      }
+      for(unsigned i = 0; i < r.size(); ++i)
+         reserve(r[i], bits);
+      reset_thread_allocation_statistics();
+      for(unsigned i = 0; i < a.size(); ++i)
+      {
+         ctx.mulmod(r[0], a[i], a[0]);
+         ctx.sqrmod(r[1], r[0]);
+         ctx.powm(r[2], r[1], a[i]);
+         ctx.inverse(r[3], a[i]);
+      }
+      BOOST_CHECK_EQUAL(thread_allocation_statistics().allocations, 0u);
+      BOOST_CHECK_EQUAL(r[3] * a.back() % m, 1);
+   }
+}
+
+int main()
+{
+   test_sizes<cpp_int>(5000);
+   test_sizes<mpz_int>(1000);
+   test_sizes<int128_t>(126);
+   test_sizes<number<cpp_int_backend<512, 512, signed_magnitude, unchecked, void> > >(500);
+   test_sizes<number<cpp_int_backend<1024, 1024, unsigned_magnitude, checked, void> > >(1000);
+   test_sizes<number<cpp_int_backend<0, 2048, signed_magnitude, checked> > >(2000);
+   test_builtin<int>();
+   test_builtin<unsigned>();
+   test_builtin<long long>();
+   test_builtin<unsigned long long>();
+   BOOST_CHECK_EQUAL(modular_context<int>(2000000011).mulmod(1999999999, 1999999998), 156);
+   test_allocations(30);
+   test_allocations(100);
+   test_allocations(3000);
+#ifndef BOOST_NO_EXCEPTIONS
+   BOOST_CHECK_THROW(modular_context<cpp_int>(cpp_int(0)), std::domain_error);
+   BOOST_CHECK_THROW(modular_context<cpp_int>(cpp_int(-7)), std::domain_error);
+#endif
+
+   return boost::report_errors();
+}